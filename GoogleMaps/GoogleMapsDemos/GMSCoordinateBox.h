@@ -0,0 +1,107 @@
+/*
+ * Copyright 2026 Google LLC. All rights reserved.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#import <CoreLocation/CoreLocation.h>
+
+@class GMSCoordinateBounds;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A latitude/longitude box that may cross the antimeridian.
+ *
+ * The box covers latitudes from |south| to |north| and longitudes going east from |west| to
+ * |east|, so |west| is greater than |east| when the box crosses the 180th meridian. Longitudes are
+ * kept in [-180, 180), except that a box covering every longitude has |west| -180 and |east| 180.
+ * A box whose |south| is greater than its |north| is empty.
+ */
+typedef struct {
+  CLLocationDegrees south;
+  CLLocationDegrees west;
+  CLLocationDegrees north;
+  CLLocationDegrees east;
+} GMSCoordinateBox;
+
+/** The empty box, the identity for |GMSCoordinateBoxUnion|. */
+FOUNDATION_EXTERN const GMSCoordinateBox kGMSCoordinateBoxEmpty;
+
+/**
+ * Returns the box with the given corners. As with GMSCoordinateBounds, a |northEast| longitude
+ * less than the |southWest| one means the box crosses the antimeridian.
+ */
+FOUNDATION_EXTERN GMSCoordinateBox GMSCoordinateBoxMake(CLLocationCoordinate2D southWest,
+                                                        CLLocationCoordinate2D northEast);
+
+/** Returns the box covering the same area as |bounds|, or the empty box if it is invalid. */
+FOUNDATION_EXTERN GMSCoordinateBox GMSCoordinateBoxFromBounds(GMSCoordinateBounds *bounds);
+
+FOUNDATION_EXTERN BOOL GMSCoordinateBoxIsEmpty(GMSCoordinateBox box);
+
+/** Returns the number of degrees of longitude the box covers, in [0, 360]. */
+FOUNDATION_EXTERN CLLocationDegrees GMSCoordinateBoxLongitudeSpan(GMSCoordinateBox box);
+
+FOUNDATION_EXTERN BOOL GMSCoordinateBoxContainsCoordinate(GMSCoordinateBox box,
+                                                          CLLocationCoordinate2D coordinate);
+
+/** Returns whether every point of |inner| is inside |outer|. The empty box is inside any box. */
+FOUNDATION_EXTERN BOOL GMSCoordinateBoxContainsBox(GMSCoordinateBox outer, GMSCoordinateBox inner);
+
+FOUNDATION_EXTERN BOOL GMSCoordinateBoxIntersectsBox(GMSCoordinateBox a, GMSCoordinateBox b);
+
+/**
+ * Returns the smallest box containing both |a| and |b|. Of the two ways around the globe that
+ * join their longitude ranges, the narrower one is used.
+ */
+FOUNDATION_EXTERN GMSCoordinateBox GMSCoordinateBoxUnion(GMSCoordinateBox a, GMSCoordinateBox b);
+
+/**
+ * Writes the intersection of |a| and |b| to |pieces|, which must have room for two boxes, and
+ * returns the number of boxes written. Two boxes which both cross the antimeridian can overlap at
+ * both ends, so the intersection may take two boxes.
+ */
+FOUNDATION_EXTERN NSUInteger GMSCoordinateBoxIntersection(GMSCoordinateBox a, GMSCoordinateBox b,
+                                                          GMSCoordinateBox *pieces);
+
+/**
+ * Returns a box containing every point within |distance| meters of |box|. Boxes that reach a pole
+ * cover every longitude.
+ */
+FOUNDATION_EXTERN GMSCoordinateBox GMSCoordinateBoxExpandedByDistance(GMSCoordinateBox box,
+                                                                      CLLocationDistance distance);
+
+/**
+ * Maps |count| pairs of values in [0, 1) to points spread uniformly by area over |box|, writing
+ * them to |latitudes| and |longitudes|. Pass values from a uniform random source to sample the
+ * box at random. |box| must not be empty.
+ */
+FOUNDATION_EXTERN void GMSCoordinateBoxSample(GMSCoordinateBox box, const double *latitudeValues,
+                                              const double *longitudeValues, NSUInteger count,
+                                              double *latitudes, double *longitudes);
+
+/**
+ * Tests |count| boxes against one coordinate, writing whether |boxes[i]| contains it to
+ * |contains[i]|. Four boxes are tested per iteration using SIMD vectors.
+ */
+FOUNDATION_EXTERN void GMSCoordinateBoxesContainCoordinate(const GMSCoordinateBox *boxes,
+                                                           NSUInteger count,
+                                                           CLLocationCoordinate2D coordinate,
+                                                           BOOL *contains);
+
+/** Like |GMSCoordinateBoxesContainCoordinate|, but tests whether each box intersects |box|. */
+FOUNDATION_EXTERN void GMSCoordinateBoxesIntersectBox(const GMSCoordinateBox *boxes,
+                                                      NSUInteger count, GMSCoordinateBox box,
+                                                      BOOL *intersects);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2026 Google LLC. All rights reserved.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#import <CoreGraphics/CoreGraphics.h>
+#import <Foundation/Foundation.h>
+
+@class GMSPath;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Adds vertices to a path so that, drawn as straight lines on the map, it follows the great
+ * circles between the original vertices to within |tolerance| screen points at |zoom|.
+ *
+ * Each segment is bisected along its great circle only while the great circle midpoint lies more
+ * than the tolerance from the chord, so nearly straight segments gain few or no vertices. A short
+ * arc strays furthest from its chord near the middle, so the midpoint stands in for the whole
+ * arc. Beyond the latitudes Web Mercator can draw the deviation is not bounded. Every original
+ * vertex is kept. Up to |capacity| coordinates are written to |densifiedLatitudes| and
+ * |densifiedLongitudes|; pass a capacity of 0 to size the buffers first.
+ *
+ * @return The number of coordinates in the densified path.
+ */
+FOUNDATION_EXTERN NSUInteger GMSGeodesicDensify(const double *latitudes, const double *longitudes,
+                                                NSUInteger count, float zoom, CGFloat tolerance,
+                                                double *_Nullable densifiedLatitudes,
+                                                double *_Nullable densifiedLongitudes,
+                                                NSUInteger capacity);
+
+/**
+ * Many paths densified into one pair of contiguous latitude and longitude buffers, so they can be
+ * drawn with |geodesic| off. Path |i| occupies |coordinateRangeAtIndex:i| within both buffers.
+ */
+@interface GMSDensifiedPaths : NSObject
+
+/** Number of paths densified. */
+@property(nonatomic, readonly) NSUInteger count;
+
+/** Total number of coordinates across all paths. */
+@property(nonatomic, readonly) NSUInteger coordinateCount;
+
+/** Latitudes of every coordinate, in degrees. */
+@property(nonatomic, readonly) const double *latitudes NS_RETURNS_INNER_POINTER;
+
+/** Longitudes of every coordinate, in degrees. */
+@property(nonatomic, readonly) const double *longitudes NS_RETURNS_INNER_POINTER;
+
+/**
+ * Densifies all of |paths| in two passes: the first sizes the buffers, the second fills them.
+ *
+ * @param zoom The highest zoom level the paths will be viewed at. Errors halve with every level
+ *     below it.
+ * @param tolerance The largest allowed distance from the great circle, in screen points.
+ */
++ (instancetype)pathsByDensifyingPaths:(NSArray<GMSPath *> *)paths
+                                  zoom:(float)zoom
+                             tolerance:(CGFloat)tolerance;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/** Returns the range of path |index| within |latitudes| and |longitudes|. */
+- (NSRange)coordinateRangeAtIndex:(NSUInteger)index;
+
+/** Returns densified path |index| as a path that can be handed to a GMSPolyline. */
+- (GMSPath *)pathAtIndex:(NSUInteger)index;
+
+@end
+
+NS_ASSUME_NONNULL_END
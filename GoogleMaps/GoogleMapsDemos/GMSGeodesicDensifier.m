@@ -0,0 +1,226 @@
+/*
+ * Copyright 2026 Google LLC. All rights reserved.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#import "GoogleMapsDemos/GMSGeodesicDensifier.h"
+
+#include <math.h>
+
+#import "GoogleMapsDemos/GMSGreatCircle.h"
+#import <GoogleMaps/GoogleMaps.h>
+
+// Width of the whole world, in points, at zoom level 0.
+static const double kWorldSize = 256;
+
+static const double kMaximumMercatorLatitude = 85.051128779806589;
+
+// Deepest bisection of a single segment, which bounds the vertices added to it at 2^16.
+static const NSUInteger kMaximumDepth = 16;
+
+// Arcs longer than this are always split. A long arc can swing to both sides of its chord, for
+// example where it crosses the equator, and still have its midpoint on the chord.
+static const CLLocationDistance kMaximumUncheckedLength = 500 * 1000;
+
+/** Projects a coordinate onto the unit Web Mercator square. */
+static void ProjectCoordinate(double latitude, double longitude, double *x, double *y) {
+  latitude = fmax(fmin(latitude, kMaximumMercatorLatitude), -kMaximumMercatorLatitude);
+  double sinLatitude = sin(latitude * M_PI / 180);
+  *x = (longitude + 180) / 360;
+  *y = 0.5 - log((1 + sinLatitude) / (1 - sinLatitude)) / (4 * M_PI);
+}
+
+/** Returns the distance from point |p| to the segment |a|-|b|. */
+static double SegmentDistance(double px, double py, double ax, double ay, double bx, double by) {
+  double dx = bx - ax;
+  double dy = by - ay;
+  double lengthSquared = dx * dx + dy * dy;
+  double t = lengthSquared > 0 ? ((px - ax) * dx + (py - ay) * dy) / lengthSquared : 0;
+  t = fmax(0, fmin(1, t));
+  return hypot(px - (ax + t * dx), py - (ay + t * dy));
+}
+
+/** Shifts |x| by whole worlds to within half a world of |reference|, as map segments are drawn. */
+static double UnwrapX(double x, double reference) {
+  return x - round(x - reference);
+}
+
+/**
+ * Returns how far the great circle midpoint |middle| lies from the chord between |from| and |to|,
+ * in unit Web Mercator lengths.
+ */
+static double ChordDeviation(CLLocationCoordinate2D from, CLLocationCoordinate2D middle,
+                             CLLocationCoordinate2D to) {
+  double fromX, fromY, middleX, middleY, toX, toY;
+  ProjectCoordinate(from.latitude, from.longitude, &fromX, &fromY);
+  ProjectCoordinate(middle.latitude, middle.longitude, &middleX, &middleY);
+  ProjectCoordinate(to.latitude, to.longitude, &toX, &toY);
+  return SegmentDistance(UnwrapX(middleX, fromX), middleY, fromX, fromY, UnwrapX(toX, fromX), toY);
+}
+
+typedef struct {
+  double startFraction;
+  double endFraction;
+  CLLocationCoordinate2D start;
+  CLLocationCoordinate2D end;
+  NSUInteger depth;
+} Arc;
+
+NSUInteger GMSGeodesicDensify(const double *latitudes, const double *longitudes, NSUInteger count,
+                              float zoom, CGFloat tolerance, double *densifiedLatitudes,
+                              double *densifiedLongitudes, NSUInteger capacity) {
+  if (count == 0) {
+    return 0;
+  }
+  double maximumDeviation = tolerance / (kWorldSize * exp2(zoom));
+  NSUInteger written = 0;
+  if (capacity > 0) {
+    densifiedLatitudes[0] = latitudes[0];
+    densifiedLongitudes[0] = longitudes[0];
+  }
+  written++;
+
+  // Arcs are bisected depth first, right half pushed first, so end points come off in path order.
+  Arc stack[kMaximumDepth + 1];
+  for (NSUInteger i = 0; i + 1 < count; i++) {
+    CLLocationCoordinate2D from = CLLocationCoordinate2DMake(latitudes[i], longitudes[i]);
+    CLLocationCoordinate2D to = CLLocationCoordinate2DMake(latitudes[i + 1], longitudes[i + 1]);
+    CLLocationDistance length = GMSGreatCircleDistance(from, to);
+    NSUInteger depth = 0;
+    stack[depth++] = (Arc){0, 1, from, to, 0};
+    while (depth > 0) {
+      Arc arc = stack[--depth];
+      if (arc.depth < kMaximumDepth) {
+        double middleFraction = (arc.startFraction + arc.endFraction) / 2;
+        CLLocationCoordinate2D middle = GMSGreatCircleInterpolate(from, to, middleFraction);
+        if ((arc.endFraction - arc.startFraction) * length > kMaximumUncheckedLength ||
+            ChordDeviation(arc.start, middle, arc.end) > maximumDeviation) {
+          stack[depth++] = (Arc){middleFraction, arc.endFraction, middle, arc.end, arc.depth + 1};
+          stack[depth++] =
+              (Arc){arc.startFraction, middleFraction, arc.start, middle, arc.depth + 1};
+          continue;
+        }
+      }
+      if (written < capacity) {
+        densifiedLatitudes[written] = arc.end.latitude;
+        densifiedLongitudes[written] = arc.end.longitude;
+      }
+      written++;
+    }
+  }
+  return written;
+}
+
+@implementation GMSDensifiedPaths {
+  NSMutableData *_latitudes;
+  NSMutableData *_longitudes;
+  // Start offset of each path, followed by the total coordinate count.
+  NSMutableData *_offsets;
+}
+
++ (instancetype)pathsByDensifyingPaths:(NSArray<GMSPath *> *)paths
+                                  zoom:(float)zoom
+                             tolerance:(CGFloat)tolerance {
+  NSUInteger count = paths.count;
+  // Gather every original vertex so both passes read from flat buffers.
+  NSMutableData *offsets = [NSMutableData dataWithLength:(count + 1) * sizeof(NSUInteger)];
+  NSUInteger *offsetValues = offsets.mutableBytes;
+  NSUInteger total = 0;
+  for (NSUInteger i = 0; i < count; i++) {
+    offsetValues[i] = total;
+    total += paths[i].count;
+  }
+  offsetValues[count] = total;
+  NSMutableData *sourceData = [NSMutableData dataWithLength:total * 2 * sizeof(double)];
+  double *sourceLatitudes = sourceData.mutableBytes;
+  double *sourceLongitudes = sourceLatitudes + total;
+  for (NSUInteger i = 0; i < count; i++) {
+    GMSPath *path = paths[i];
+    for (NSUInteger j = 0; j < path.count; j++) {
+      CLLocationCoordinate2D coordinate = [path coordinateAtIndex:j];
+      sourceLatitudes[offsetValues[i] + j] = coordinate.latitude;
+      sourceLongitudes[offsetValues[i] + j] = coordinate.longitude;
+    }
+  }
+
+  NSMutableData *densifiedOffsets =
+      [NSMutableData dataWithLength:(count + 1) * sizeof(NSUInteger)];
+  NSUInteger *densifiedOffsetValues = densifiedOffsets.mutableBytes;
+  NSUInteger densifiedTotal = 0;
+  for (NSUInteger i = 0; i < count; i++) {
+    densifiedOffsetValues[i] = densifiedTotal;
+    densifiedTotal += GMSGeodesicDensify(sourceLatitudes + offsetValues[i],
+                                         sourceLongitudes + offsetValues[i],
+                                         offsetValues[i + 1] - offsetValues[i], zoom, tolerance,
+                                         NULL, NULL, 0);
+  }
+  densifiedOffsetValues[count] = densifiedTotal;
+
+  NSMutableData *latitudes = [NSMutableData dataWithLength:densifiedTotal * sizeof(double)];
+  NSMutableData *longitudes = [NSMutableData dataWithLength:densifiedTotal * sizeof(double)];
+  double *latitudeValues = latitudes.mutableBytes;
+  double *longitudeValues = longitudes.mutableBytes;
+  for (NSUInteger i = 0; i < count; i++) {
+    NSUInteger start = densifiedOffsetValues[i];
+    GMSGeodesicDensify(sourceLatitudes + offsetValues[i], sourceLongitudes + offsetValues[i],
+                       offsetValues[i + 1] - offsetValues[i], zoom, tolerance,
+                       latitudeValues + start, longitudeValues + start,
+                       densifiedOffsetValues[i + 1] - start);
+  }
+  return [[self alloc] initWithLatitudes:latitudes longitudes:longitudes offsets:densifiedOffsets];
+}
+
+- (instancetype)initWithLatitudes:(NSMutableData *)latitudes
+                       longitudes:(NSMutableData *)longitudes
+                          offsets:(NSMutableData *)offsets {
+  if ((self = [super init])) {
+    _latitudes = latitudes;
+    _longitudes = longitudes;
+    _offsets = offsets;
+  }
+  return self;
+}
+
+- (NSUInteger)count {
+  return _offsets.length / sizeof(NSUInteger) - 1;
+}
+
+- (NSUInteger)coordinateCount {
+  return _latitudes.length / sizeof(double);
+}
+
+- (const double *)latitudes {
+  return _latitudes.bytes;
+}
+
+- (const double *)longitudes {
+  return _longitudes.bytes;
+}
+
+- (NSRange)coordinateRangeAtIndex:(NSUInteger)index {
+  const NSUInteger *offsets = _offsets.bytes;
+  return NSMakeRange(offsets[index], offsets[index + 1] - offsets[index]);
+}
+
+- (GMSPath *)pathAtIndex:(NSUInteger)index {
+  NSRange range = [self coordinateRangeAtIndex:index];
+  const double *latitudes = self.latitudes;
+  const double *longitudes = self.longitudes;
+  GMSMutablePath *path = [GMSMutablePath path];
+  for (NSUInteger i = range.location; i < NSMaxRange(range); i++) {
+    [path addLatitude:latitudes[i] longitude:longitudes[i]];
+  }
+  return path;
+}
+
+@end
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2026 Google LLC. All rights reserved.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#import <UIKit/UIKit.h>
+
+@class GMSStyleSpan;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** Number of entries in the colour lookup table. */
+FOUNDATION_EXTERN const NSUInteger kGMSGradientLevelCount;
+
+/**
+ * Maps each of |count| values onto a lookup table level in [0, kGMSGradientLevelCount). Values at
+ * or below 0 map to level 0 and values at or above |maximum| map to the last level.
+ */
+FOUNDATION_EXTERN void GMSGradientQuantize(const double *values, NSUInteger count, double maximum,
+                                           uint8_t *levels);
+
+/**
+ * Splits a polyline whose vertex |i| has colour |levels[i]| into the fewest runs that can each be
+ * drawn as one linear gradient, such that no vertex inside a run strays more than |tolerance|
+ * levels from the gradient. Runs are found greedily in a single pass by narrowing the range of
+ * slopes that still fits every vertex seen so far.
+ *
+ * A gradient span blends its two end colours in RGB, which only follows the lookup table where
+ * the table is linear. The levels are therefore split into |bands| equal bands, each assumed to be
+ * linear in RGB, and a run only covers several segments when both of its ends lie in one band.
+ *
+ * @param runEnds Receives the index of the last vertex of each run; the first run starts at
+ *     vertex 0 and every other run starts where the previous one ended. Must have room for
+ *     |count| - 1 entries.
+ * @return The number of runs written.
+ */
+FOUNDATION_EXTERN NSUInteger GMSGradientMergeRuns(const uint8_t *levels, NSUInteger count,
+                                                  double tolerance, NSUInteger bands,
+                                                  NSUInteger *runEnds);
+
+/**
+ * Builds the hue-by-elevation style spans for a track, merging neighbouring segments whose colours
+ * are indistinguishable into a single gradient span covering several segments.
+ */
+@interface GMSGradientSpanBuilder : NSObject
+
+/**
+ * @param maximumElevation The elevation drawn with the last hue of the colour table.
+ * @param tolerance How far, in lookup table levels, a merged span may stray from the exact colour.
+ */
+- (instancetype)initWithMaximumElevation:(double)maximumElevation
+                               tolerance:(double)tolerance NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/** Returns the spans for a polyline whose vertex |i| is at |elevations[i]|. */
+- (NSArray<GMSStyleSpan *> *)spansForElevations:(const double *)elevations count:(NSUInteger)count;
+
+@end
+
+NS_ASSUME_NONNULL_END
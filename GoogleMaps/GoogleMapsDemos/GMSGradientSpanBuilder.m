@@ -0,0 +1,115 @@
+/*
+ * Copyright 2026 Google LLC. All rights reserved.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#import "GoogleMapsDemos/GMSGradientSpanBuilder.h"
+
+#include <math.h>
+
+#import <GoogleMaps/GoogleMaps.h>
+
+const NSUInteger kGMSGradientLevelCount = 256;
+
+// The hue wheel is linear in RGB between each pair of neighbouring primary and secondary colours.
+static const NSUInteger kHueBands = 6;
+
+void GMSGradientQuantize(const double *values, NSUInteger count, double maximum, uint8_t *levels) {
+  const double scale = (kGMSGradientLevelCount - 1) / maximum;
+  for (NSUInteger i = 0; i < count; i++) {
+    double level = fmin(fmax(values[i] * scale, 0), kGMSGradientLevelCount - 1);
+    levels[i] = (uint8_t)(level + 0.5);
+  }
+}
+
+/** Returns the band of |level| when the levels are split into |bands| equal bands. */
+static NSUInteger BandOfLevel(uint8_t level, NSUInteger bands) {
+  return MIN(level * bands / (kGMSGradientLevelCount - 1), bands - 1);
+}
+
+NSUInteger GMSGradientMergeRuns(const uint8_t *levels, NSUInteger count, double tolerance,
+                                NSUInteger bands, NSUInteger *runEnds) {
+  if (count < 2) {
+    return 0;
+  }
+  NSUInteger runs = 0;
+  NSUInteger start = 0;
+  // Range of gradient slopes, in levels per segment, that keeps every vertex after |start| within
+  // |tolerance| of the gradient.
+  double low = -INFINITY;
+  double high = INFINITY;
+  for (NSUInteger end = 1; end < count; end++) {
+    double slope = ((double)levels[end] - levels[start]) / (end - start);
+    // A single segment is always drawn as it is, even when its ends lie in different bands.
+    BOOL crossesBand = end - start > 1 &&
+                       BandOfLevel(levels[end], bands) != BandOfLevel(levels[start], bands);
+    if (crossesBand || slope < low || slope > high) {
+      runEnds[runs++] = end - 1;
+      start = end - 1;
+      low = -INFINITY;
+      high = INFINITY;
+    }
+    double distance = end - start;
+    low = fmax(low, ((double)levels[end] - tolerance - levels[start]) / distance);
+    high = fmin(high, ((double)levels[end] + tolerance - levels[start]) / distance);
+  }
+  runEnds[runs++] = count - 1;
+  return runs;
+}
+
+@implementation GMSGradientSpanBuilder {
+  double _maximumElevation;
+  double _tolerance;
+  NSArray<UIColor *> *_colors;
+}
+
+- (instancetype)initWithMaximumElevation:(double)maximumElevation tolerance:(double)tolerance {
+  if ((self = [super init])) {
+    _maximumElevation = maximumElevation;
+    _tolerance = tolerance;
+    NSMutableArray<UIColor *> *colors = [NSMutableArray arrayWithCapacity:kGMSGradientLevelCount];
+    for (NSUInteger i = 0; i < kGMSGradientLevelCount; i++) {
+      [colors addObject:[UIColor colorWithHue:(CGFloat)i / (kGMSGradientLevelCount - 1)
+                                   saturation:1.f
+                                   brightness:.9f
+                                        alpha:1.f]];
+    }
+    _colors = colors;
+  }
+  return self;
+}
+
+- (NSArray<GMSStyleSpan *> *)spansForElevations:(const double *)elevations count:(NSUInteger)count {
+  if (count < 2) {
+    return @[];
+  }
+  NSMutableData *levelData = [NSMutableData dataWithLength:count];
+  NSMutableData *runData = [NSMutableData dataWithLength:(count - 1) * sizeof(NSUInteger)];
+  uint8_t *levels = levelData.mutableBytes;
+  NSUInteger *runEnds = runData.mutableBytes;
+  GMSGradientQuantize(elevations, count, _maximumElevation, levels);
+  NSUInteger runs = GMSGradientMergeRuns(levels, count, _tolerance, kHueBands, runEnds);
+
+  NSMutableArray<GMSStyleSpan *> *spans = [NSMutableArray arrayWithCapacity:runs];
+  NSUInteger start = 0;
+  for (NSUInteger i = 0; i < runs; i++) {
+    NSUInteger end = runEnds[i];
+    GMSStrokeStyle *style = [GMSStrokeStyle gradientFromColor:_colors[levels[start]]
+                                                      toColor:_colors[levels[end]]];
+    [spans addObject:[GMSStyleSpan spanWithStyle:style segments:end - start]];
+    start = end;
+  }
+  return spans;
+}
+
+@end
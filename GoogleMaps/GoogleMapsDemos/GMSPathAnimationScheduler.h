@@ -0,0 +1,71 @@
+/*
+ * Copyright 2026 Google LLC. All rights reserved.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#import <CoreLocation/CoreLocation.h>
+
+@class GMSPath;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Moves many entities around closed paths at constant speeds, advancing all of them together in
+ * fixed timesteps.
+ *
+ * Entities live in flat arrays rather than in one object each. The length and heading of every leg
+ * are measured when an entity is added, so an advance is only an addition per entity plus a walk
+ * to the next leg when one is crossed, however many timesteps it covers. Positions and headings
+ * are produced for all entities at once after each call to |advanceByTime:|.
+ */
+@interface GMSPathAnimationScheduler : NSObject
+
+/** Simulated time covered by one step, in seconds. */
+@property(nonatomic, readonly) NSTimeInterval timestep;
+
+/** Number of entities added so far. */
+@property(nonatomic, readonly) NSUInteger entityCount;
+
+/** Latitude of each entity after the last advance. */
+@property(nonatomic, readonly) const double *latitudes NS_RETURNS_INNER_POINTER;
+
+/** Longitude of each entity after the last advance. */
+@property(nonatomic, readonly) const double *longitudes NS_RETURNS_INNER_POINTER;
+
+/** Heading of the leg each entity is on after the last advance, in degrees. */
+@property(nonatomic, readonly) const double *headings NS_RETURNS_INNER_POINTER;
+
+- (instancetype)initWithTimestep:(NSTimeInterval)timestep NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Adds an entity at the first coordinate of |path|, which it will follow back to the start and
+ * around again. |path| must not be empty.
+ *
+ * @param speed Speed along the path, in meters per second.
+ * @return The index of the entity in the position and heading arrays.
+ */
+- (NSUInteger)addEntityWithPath:(GMSPath *)path speed:(CLLocationSpeed)speed;
+
+/**
+ * Runs as many whole timesteps as fit in |elapsed| plus the time left over from previous calls,
+ * then updates the positions and headings of every entity.
+ *
+ * @return The number of timesteps run.
+ */
+- (NSUInteger)advanceByTime:(NSTimeInterval)elapsed;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,254 @@
+/*
+ * Copyright 2026 Google LLC. All rights reserved.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#import "GoogleMapsDemos/GMSPolygonHitTestIndex.h"
+
+#include <math.h>
+
+#import <GoogleMaps/GoogleMaps.h>
+
+// Target number of edges per slab. Edges spanning several slabs are stored once per slab.
+static const NSUInteger kEdgesPerSlab = 2;
+
+typedef struct {
+  double latitude0, longitude0, latitude1, longitude1;
+} Edge;
+
+typedef struct {
+  double minLatitude, maxLatitude, minLongitude, maxLongitude;
+  // The polygon's slabs split [minLatitude, maxLatitude] evenly. The edges of slab |i| are
+  // |_edges[_slabOffsets[firstSlab + i]]| up to |_edges[_slabOffsets[firstSlab + i + 1]]|.
+  double slabHeight;
+  NSUInteger slabCount;
+  NSUInteger firstSlab;
+} Polygon;
+
+static NSUInteger SlabForLatitude(double latitude, double minLatitude, double slabHeight,
+                                  NSUInteger slabCount) {
+  if (slabHeight <= 0) {
+    return 0;
+  }
+  double slab = floor((latitude - minLatitude) / slabHeight);
+  return (NSUInteger)fmax(0, fmin(slab, slabCount - 1));
+}
+
+/** Appends the edges of the closed ring |path|, skipping horizontal ones a ray never crosses. */
+static void AppendRingEdges(GMSPath *path, NSMutableData *edges) {
+  NSUInteger count = path.count;
+  for (NSUInteger i = 0; i < count; i++) {
+    CLLocationCoordinate2D from = [path coordinateAtIndex:i];
+    CLLocationCoordinate2D to = [path coordinateAtIndex:(i + 1) % count];
+    if (from.latitude == to.latitude) {
+      continue;
+    }
+    Edge edge = {from.latitude, from.longitude, to.latitude, to.longitude};
+    [edges appendBytes:&edge length:sizeof(edge)];
+  }
+}
+
+@implementation GMSPolygonHitTestIndex {
+  NSMutableData *_polygons;
+  NSMutableData *_slabOffsets;
+  NSMutableData *_edges;
+
+  // Polygons binned by the latitude range of their bounding boxes, rebuilt when polygons are added.
+  BOOL _polygonSlabsValid;
+  double _minLatitude;
+  double _polygonSlabHeight;
+  NSUInteger _polygonSlabCount;
+  NSMutableData *_polygonSlabOffsets;
+  NSMutableData *_polygonSlabIndices;
+}
+
+- (instancetype)init {
+  if ((self = [super init])) {
+    _polygons = [NSMutableData data];
+    _slabOffsets = [NSMutableData data];
+    _edges = [NSMutableData data];
+  }
+  return self;
+}
+
+- (NSUInteger)count {
+  return _polygons.length / sizeof(Polygon);
+}
+
+- (NSUInteger)addPolygonWithPath:(GMSPath *)path holes:(nullable NSArray<GMSPath *> *)holes {
+  NSMutableData *ringEdges = [NSMutableData data];
+  AppendRingEdges(path, ringEdges);
+  for (GMSPath *hole in holes) {
+    AppendRingEdges(hole, ringEdges);
+  }
+  const Edge *edges = ringEdges.bytes;
+  NSUInteger edgeCount = ringEdges.length / sizeof(Edge);
+
+  Polygon polygon = {INFINITY, -INFINITY, INFINITY, -INFINITY, 0, 1, 0};
+  for (NSUInteger i = 0; i < path.count; i++) {
+    CLLocationCoordinate2D coordinate = [path coordinateAtIndex:i];
+    polygon.minLatitude = fmin(polygon.minLatitude, coordinate.latitude);
+    polygon.maxLatitude = fmax(polygon.maxLatitude, coordinate.latitude);
+    polygon.minLongitude = fmin(polygon.minLongitude, coordinate.longitude);
+    polygon.maxLongitude = fmax(polygon.maxLongitude, coordinate.longitude);
+  }
+  polygon.slabCount = MAX(1, edgeCount / kEdgesPerSlab);
+  polygon.slabHeight = (polygon.maxLatitude - polygon.minLatitude) / polygon.slabCount;
+  polygon.firstSlab = _slabOffsets.length / sizeof(NSUInteger);
+
+  // Count the edges overlapping each slab, turn the counts into offsets, then fill the slabs.
+  NSUInteger slabCount = polygon.slabCount;
+  NSUInteger edgeBase = _edges.length / sizeof(Edge);
+  [_slabOffsets increaseLengthBy:(slabCount + 1) * sizeof(NSUInteger)];
+  NSUInteger *offsets = (NSUInteger *)_slabOffsets.mutableBytes + polygon.firstSlab;
+  NSMutableData *firstSlabData = [NSMutableData dataWithLength:edgeCount * sizeof(NSUInteger)];
+  NSMutableData *lastSlabData = [NSMutableData dataWithLength:edgeCount * sizeof(NSUInteger)];
+  NSUInteger *firstSlabs = firstSlabData.mutableBytes;
+  NSUInteger *lastSlabs = lastSlabData.mutableBytes;
+  for (NSUInteger i = 0; i < edgeCount; i++) {
+    double low = fmin(edges[i].latitude0, edges[i].latitude1);
+    double high = fmax(edges[i].latitude0, edges[i].latitude1);
+    firstSlabs[i] = SlabForLatitude(low, polygon.minLatitude, polygon.slabHeight, slabCount);
+    lastSlabs[i] = SlabForLatitude(high, polygon.minLatitude, polygon.slabHeight, slabCount);
+    for (NSUInteger slab = firstSlabs[i]; slab <= lastSlabs[i]; slab++) {
+      offsets[slab + 1]++;
+    }
+  }
+  offsets[0] = edgeBase;
+  for (NSUInteger slab = 0; slab < slabCount; slab++) {
+    offsets[slab + 1] += offsets[slab];
+  }
+  [_edges increaseLengthBy:(offsets[slabCount] - edgeBase) * sizeof(Edge)];
+  Edge *slabEdges = _edges.mutableBytes;
+  NSMutableData *cursorData = [NSMutableData dataWithBytes:offsets
+                                                    length:slabCount * sizeof(NSUInteger)];
+  NSUInteger *cursors = cursorData.mutableBytes;
+  for (NSUInteger i = 0; i < edgeCount; i++) {
+    for (NSUInteger slab = firstSlabs[i]; slab <= lastSlabs[i]; slab++) {
+      slabEdges[cursors[slab]++] = edges[i];
+    }
+  }
+
+  [_polygons appendBytes:&polygon length:sizeof(polygon)];
+  _polygonSlabsValid = NO;
+  return self.count - 1;
+}
+
+/** Returns whether polygon |index| contains the point, by even-odd ray casting within one slab. */
+- (BOOL)polygonAtIndex:(NSUInteger)index
+    containsLatitude:(double)latitude
+           longitude:(double)longitude {
+  const Polygon *polygon = (const Polygon *)_polygons.bytes + index;
+  if (latitude < polygon->minLatitude || latitude > polygon->maxLatitude ||
+      longitude < polygon->minLongitude || longitude > polygon->maxLongitude) {
+    return NO;
+  }
+  NSUInteger slab = SlabForLatitude(latitude, polygon->minLatitude, polygon->slabHeight,
+                                    polygon->slabCount);
+  const NSUInteger *offsets = (const NSUInteger *)_slabOffsets.bytes + polygon->firstSlab;
+  const Edge *edges = _edges.bytes;
+  BOOL inside = NO;
+  for (NSUInteger i = offsets[slab]; i < offsets[slab + 1]; i++) {
+    const Edge *edge = &edges[i];
+    if ((edge->latitude0 > latitude) != (edge->latitude1 > latitude)) {
+      double crossing = edge->longitude0 + (latitude - edge->latitude0) *
+                                               (edge->longitude1 - edge->longitude0) /
+                                               (edge->latitude1 - edge->latitude0);
+      if (longitude < crossing) {
+        inside = !inside;
+      }
+    }
+  }
+  return inside;
+}
+
+- (void)buildPolygonSlabsIfNeeded {
+  if (_polygonSlabsValid) {
+    return;
+  }
+  _polygonSlabsValid = YES;
+  const Polygon *polygons = _polygons.bytes;
+  NSUInteger count = self.count;
+  double minLatitude = INFINITY;
+  double maxLatitude = -INFINITY;
+  for (NSUInteger i = 0; i < count; i++) {
+    minLatitude = fmin(minLatitude, polygons[i].minLatitude);
+    maxLatitude = fmax(maxLatitude, polygons[i].maxLatitude);
+  }
+  _minLatitude = minLatitude;
+  _polygonSlabCount = MAX(1, count);
+  _polygonSlabHeight = count > 0 ? (maxLatitude - minLatitude) / _polygonSlabCount : 0;
+
+  _polygonSlabOffsets = [NSMutableData dataWithLength:(_polygonSlabCount + 1) * sizeof(NSUInteger)];
+  NSUInteger *offsets = _polygonSlabOffsets.mutableBytes;
+  for (NSUInteger i = 0; i < count; i++) {
+    NSUInteger first = SlabForLatitude(polygons[i].minLatitude, _minLatitude, _polygonSlabHeight,
+                                       _polygonSlabCount);
+    NSUInteger last = SlabForLatitude(polygons[i].maxLatitude, _minLatitude, _polygonSlabHeight,
+                                      _polygonSlabCount);
+    for (NSUInteger slab = first; slab <= last; slab++) {
+      offsets[slab + 1]++;
+    }
+  }
+  for (NSUInteger slab = 0; slab < _polygonSlabCount; slab++) {
+    offsets[slab + 1] += offsets[slab];
+  }
+  _polygonSlabIndices =
+      [NSMutableData dataWithLength:offsets[_polygonSlabCount] * sizeof(NSUInteger)];
+  NSUInteger *indices = _polygonSlabIndices.mutableBytes;
+  NSMutableData *cursorData =
+      [NSMutableData dataWithBytes:offsets length:_polygonSlabCount * sizeof(NSUInteger)];
+  NSUInteger *cursors = cursorData.mutableBytes;
+  for (NSUInteger i = 0; i < count; i++) {
+    NSUInteger first = SlabForLatitude(polygons[i].minLatitude, _minLatitude, _polygonSlabHeight,
+                                       _polygonSlabCount);
+    NSUInteger last = SlabForLatitude(polygons[i].maxLatitude, _minLatitude, _polygonSlabHeight,
+                                      _polygonSlabCount);
+    for (NSUInteger slab = first; slab <= last; slab++) {
+      indices[cursors[slab]++] = i;
+    }
+  }
+}
+
+- (NSUInteger)indexOfPolygonContainingCoordinate:(CLLocationCoordinate2D)coordinate {
+  NSUInteger index;
+  [self classifyLatitudes:&coordinate.latitude
+               longitudes:&coordinate.longitude
+                    count:1
+                  indices:&index];
+  return index;
+}
+
+- (void)classifyLatitudes:(const double *)latitudes
+               longitudes:(const double *)longitudes
+                    count:(NSUInteger)count
+                  indices:(NSUInteger *)indices {
+  [self buildPolygonSlabsIfNeeded];
+  const NSUInteger *offsets = _polygonSlabOffsets.bytes;
+  const NSUInteger *slabIndices = _polygonSlabIndices.bytes;
+  for (NSUInteger i = 0; i < count; i++) {
+    indices[i] = NSNotFound;
+    NSUInteger slab =
+        SlabForLatitude(latitudes[i], _minLatitude, _polygonSlabHeight, _polygonSlabCount);
+    // Polygons are stored in the order they were added, so walk backwards to find the top one.
+    for (NSUInteger j = offsets[slab + 1]; j > offsets[slab]; j--) {
+      NSUInteger polygon = slabIndices[j - 1];
+      if ([self polygonAtIndex:polygon containsLatitude:latitudes[i] longitude:longitudes[i]]) {
+        indices[i] = polygon;
+        break;
+      }
+    }
+  }
+}
+
+@end
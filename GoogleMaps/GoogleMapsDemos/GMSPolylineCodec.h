@@ -0,0 +1,87 @@
+/*
+ * Copyright 2026 Google LLC. All rights reserved.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class GMSPath;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Returns the number of coordinates in an encoded polyline without decoding it. The count is only
+ * meaningful for well formed input; |GMSPolylineCodecDecode| performs the validation.
+ */
+FOUNDATION_EXTERN NSUInteger GMSPolylineCodecCountCoordinates(const char *encoded, size_t length);
+
+/**
+ * Decodes an encoded polyline into separate latitude and longitude arrays, each of which must have
+ * room for |capacity| values.
+ *
+ * @return The number of coordinates decoded, or -1 if the input is malformed or does not fit.
+ */
+FOUNDATION_EXTERN NSInteger GMSPolylineCodecDecode(const char *encoded, size_t length,
+                                                   double *latitudes, double *longitudes,
+                                                   NSUInteger capacity);
+
+/** Returns the largest number of bytes |GMSPolylineCodecEncode| can write for |count| points. */
+FOUNDATION_EXTERN size_t GMSPolylineCodecMaxEncodedLength(NSUInteger count);
+
+/**
+ * Encodes |count| coordinates into |buffer|. The output is not NUL terminated.
+ *
+ * @return The number of bytes written, or 0 if |capacity| is too small.
+ */
+FOUNDATION_EXTERN size_t GMSPolylineCodecEncode(const double *latitudes, const double *longitudes,
+                                                NSUInteger count, char *buffer, size_t capacity);
+
+/** Returns the encoded polyline string for |path|. */
+FOUNDATION_EXTERN NSString *GMSPolylineCodecEncodePath(GMSPath *path);
+
+/**
+ * The coordinates of many encoded polylines, decoded into one pair of contiguous latitude and
+ * longitude buffers. Polyline |i| occupies |coordinateRangeAtIndex:i| within both buffers.
+ */
+@interface GMSDecodedPolylines : NSObject
+
+/** Number of polylines decoded. */
+@property(nonatomic, readonly) NSUInteger count;
+
+/** Total number of coordinates across all polylines. */
+@property(nonatomic, readonly) NSUInteger coordinateCount;
+
+/** Latitudes of every coordinate, in degrees. */
+@property(nonatomic, readonly) const double *latitudes NS_RETURNS_INNER_POINTER;
+
+/** Longitudes of every coordinate, in degrees. */
+@property(nonatomic, readonly) const double *longitudes NS_RETURNS_INNER_POINTER;
+
+/**
+ * Decodes all of |encodedPaths| in two passes: the first sizes the buffers, the second fills them.
+ *
+ * @return The decoded polylines, or nil if any of the strings is malformed.
+ */
++ (nullable instancetype)polylinesByDecodingStrings:(NSArray<NSString *> *)encodedPaths;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/** Returns the range of polyline |index| within |latitudes| and |longitudes|. */
+- (NSRange)coordinateRangeAtIndex:(NSUInteger)index;
+
+/** Returns polyline |index| as a path that can be handed to a GMSPolyline. */
+- (GMSPath *)pathAtIndex:(NSUInteger)index;
+
+@end
+
+NS_ASSUME_NONNULL_END
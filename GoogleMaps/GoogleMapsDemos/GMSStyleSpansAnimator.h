@@ -0,0 +1,50 @@
+/*
+ * Copyright 2026 Google LLC. All rights reserved.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class GMSPath;
+@class GMSStrokeStyle;
+@class GMSStyleSpan;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Produces the same repeating style pattern as |GMSStyleSpansOffset| with geodesic lengths, but
+ * measures the path only once. Every later offset is resolved against the cached cumulative
+ * segment lengths, so the cost of a frame depends on the number of spans rather than on the
+ * number of vertices.
+ */
+@interface GMSStyleSpansAnimator : NSObject
+
+/** Total geodesic length of the path, in meters. */
+@property(nonatomic, readonly) double length;
+
+/**
+ * Measures |path| and prepares the pattern. Style |i| of the pattern is drawn for
+ * |lengths[i % lengths.count]| meters, and the pattern repeats until the end of the path.
+ */
+- (instancetype)initWithPath:(GMSPath *)path
+                      styles:(NSArray<GMSStrokeStyle *> *)styles
+                     lengths:(NSArray<NSNumber *> *)lengths NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/** Returns the spans for the pattern shifted by |offset| meters along the path. */
+- (NSArray<GMSStyleSpan *> *)spansWithOffset:(double)offset;
+
+@end
+
+NS_ASSUME_NONNULL_END
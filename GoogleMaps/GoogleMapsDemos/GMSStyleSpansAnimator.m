@@ -0,0 +1,133 @@
+/*
+ * Copyright 2026 Google LLC. All rights reserved.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#import "GoogleMapsDemos/GMSStyleSpansAnimator.h"
+
+#include <math.h>
+
+#import <GoogleMaps/GoogleMaps.h>
+
+/**
+ * Converts a distance along the path into a fractional segment index, which is the unit
+ * GMSStyleSpan uses. |*segment| is a cursor that only moves forward, since the spans of one frame
+ * are emitted in path order; the segment is then found by binary search between the cursor and
+ * the end of the path.
+ */
+static double SegmentPositionForDistance(const double *cumulative, NSUInteger count,
+                                         double distance, NSUInteger *segment) {
+  NSUInteger low = *segment;
+  NSUInteger high = count - 2;
+  while (low < high) {
+    NSUInteger middle = low + (high - low + 1) / 2;
+    if (cumulative[middle] <= distance) {
+      low = middle;
+    } else {
+      high = middle - 1;
+    }
+  }
+  *segment = low;
+  double segmentLength = cumulative[low + 1] - cumulative[low];
+  if (segmentLength <= 0) {
+    return low;
+  }
+  return low + fmin((distance - cumulative[low]) / segmentLength, 1);
+}
+
+@implementation GMSStyleSpansAnimator {
+  NSArray<GMSStrokeStyle *> *_styles;
+  // Distance from the first vertex to each vertex, in meters.
+  NSMutableData *_cumulativeLengths;
+  // One full period of the pattern. Entry |i| uses style |i % _styles.count|.
+  NSMutableData *_patternLengths;
+  double _period;
+}
+
+- (instancetype)initWithPath:(GMSPath *)path
+                      styles:(NSArray<GMSStrokeStyle *> *)styles
+                     lengths:(NSArray<NSNumber *> *)lengths {
+  if ((self = [super init])) {
+    _styles = [styles copy];
+
+    NSUInteger count = path.count;
+    _cumulativeLengths = [NSMutableData dataWithLength:count * sizeof(double)];
+    double *cumulative = _cumulativeLengths.mutableBytes;
+    for (NSUInteger i = 1; i < count; i++) {
+      cumulative[i] = cumulative[i - 1] + GMSGeometryDistance([path coordinateAtIndex:i - 1],
+                                                              [path coordinateAtIndex:i]);
+    }
+    _length = count > 1 ? cumulative[count - 1] : 0;
+
+    // The pattern only repeats exactly once both the styles and the lengths have wrapped around.
+    NSUInteger a = styles.count;
+    NSUInteger b = lengths.count;
+    while (b != 0) {
+      NSUInteger remainder = a % b;
+      a = b;
+      b = remainder;
+    }
+    NSUInteger entries = a == 0 ? 0 : styles.count / a * lengths.count;
+    _patternLengths = [NSMutableData dataWithLength:entries * sizeof(double)];
+    double *pattern = _patternLengths.mutableBytes;
+    for (NSUInteger i = 0; i < entries; i++) {
+      pattern[i] = fmax([lengths[i % lengths.count] doubleValue], 0);
+      _period += pattern[i];
+    }
+  }
+  return self;
+}
+
+- (NSArray<GMSStyleSpan *> *)spansWithOffset:(double)offset {
+  if (_length <= 0 || _period <= 0) {
+    return @[];
+  }
+  const double *cumulative = _cumulativeLengths.bytes;
+  const double *pattern = _patternLengths.bytes;
+  NSUInteger entries = _patternLengths.length / sizeof(double);
+  NSUInteger vertices = _cumulativeLengths.length / sizeof(double);
+  NSUInteger styleCount = _styles.count;
+
+  // Find the pattern entry under the first vertex.
+  double phase = fmod(offset, _period);
+  if (phase < 0) {
+    phase += _period;
+  }
+  NSUInteger entry = 0;
+  while (phase >= pattern[entry]) {
+    phase -= pattern[entry];
+    entry = (entry + 1) % entries;
+  }
+
+  NSMutableArray<GMSStyleSpan *> *spans =
+      [NSMutableArray arrayWithCapacity:(NSUInteger)ceil(_length / _period * entries) + 1];
+  double remaining = pattern[entry] - phase;
+  double distance = 0;
+  double position = 0;
+  NSUInteger segment = 0;
+  while (distance < _length) {
+    if (remaining > 0) {
+      double end = fmin(distance + remaining, _length);
+      double endPosition = SegmentPositionForDistance(cumulative, vertices, end, &segment);
+      [spans addObject:[GMSStyleSpan spanWithStyle:_styles[entry % styleCount]
+                                          segments:endPosition - position]];
+      position = endPosition;
+      distance = end;
+    }
+    entry = (entry + 1) % entries;
+    remaining = pattern[entry];
+  }
+  return spans;
+}
+
+@end
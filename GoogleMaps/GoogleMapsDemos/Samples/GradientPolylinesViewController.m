@@ -15,12 +15,30 @@
 
 #import "GoogleMapsDemos/Samples/GradientPolylinesViewController.h"
 
+#import "GoogleMapsDemos/GMSGradientSpanBuilder.h"
+#import "GoogleMapsDemos/GMSPathSimplificationPyramid.h"
 #import <GoogleMaps/GoogleMaps.h>
 
+// Largest distance, in points, between the drawn track and the recorded one.
+static const double kSimplificationTolerance = 1;
+
+// Elevation, in meters, drawn with the last hue of the gradient.
+static const double kMaximumElevation = 700;
+
+// Largest colour error, in gradient levels, allowed when neighbouring segments are merged.
+static const double kColorTolerance = 2;
+
+@interface GradientPolylinesViewController () <GMSMapViewDelegate>
+
+@end
+
 @implementation GradientPolylinesViewController {
   GMSMapView *_mapView;
   GMSPolyline *_polyline;
-  NSMutableArray *_trackData;
+  NSMutableData *_elevations;
+  GMSPathSimplificationPyramid *_pyramid;
+  GMSGradientSpanBuilder *_spanBuilder;
+  NSInteger _zoomLevel;
 }
 
 - (void)viewDidLoad {
@@ -31,57 +49,75 @@
                                                             bearing:328.f
                                                        viewingAngle:40.f];
   _mapView = [GMSMapView mapWithFrame:CGRectZero camera:camera];
+  _mapView.delegate = self;
   self.view = _mapView;
 
+  _zoomLevel = -1;
+  _spanBuilder = [[GMSGradientSpanBuilder alloc] initWithMaximumElevation:kMaximumElevation
+                                                                tolerance:kColorTolerance];
   [self parseTrackFile];
-  [_polyline setSpans:[self gradientSpans]];
+  [self updatePolylineForZoom:camera.zoom];
 }
 
-- (NSArray *)gradientSpans {
-  NSMutableArray *colorSpans = [NSMutableArray array];
-  NSUInteger count = _trackData.count;
-  UIColor *prevColor;
-  for (NSUInteger i = 0; i < count; i++) {
-    NSDictionary *dict = [_trackData objectAtIndex:i];
-    double elevation = [[dict objectForKey:@"elevation"] doubleValue];
-
-    UIColor *toColor = [UIColor colorWithHue:(float)elevation / 700
-                                  saturation:1.f
-                                  brightness:.9f
-                                       alpha:1.f];
-
-    if (prevColor == nil) {
-      prevColor = toColor;
-    }
+/**
+ * Replaces the polyline's vertices and spans with the simplification for |zoom|. The track only
+ * changes when the camera crosses an integer zoom level.
+ */
+- (void)updatePolylineForZoom:(float)zoom {
+  NSInteger zoomLevel = (NSInteger)ceilf(zoom);
+  if (zoomLevel == _zoomLevel) {
+    return;
+  }
+  _zoomLevel = zoomLevel;
 
-    GMSStrokeStyle *style = [GMSStrokeStyle gradientFromColor:prevColor toColor:toColor];
-    [colorSpans addObject:[GMSStyleSpan spanWithStyle:style]];
+  NSUInteger count;
+  const uint32_t *indices = [_pyramid indicesForZoom:zoom count:&count];
+  _polyline.path = [_pyramid pathForZoom:zoom];
+  _polyline.spans = [self gradientSpansForIndices:indices count:count];
+}
 
-    prevColor = toColor;
+- (NSArray *)gradientSpansForIndices:(const uint32_t *)indices count:(NSUInteger)count {
+  NSMutableData *elevationData = [NSMutableData dataWithLength:count * sizeof(double)];
+  double *elevations = elevationData.mutableBytes;
+  const double *trackElevations = _elevations.bytes;
+  for (NSUInteger i = 0; i < count; i++) {
+    elevations[i] = trackElevations[indices[i]];
   }
-  return colorSpans;
+  return [_spanBuilder spansForElevations:elevations count:count];
 }
 
 - (void)parseTrackFile {
   NSString *filePath = [[NSBundle mainBundle] pathForResource:@"track" ofType:@"json"];
   NSData *data = [NSData dataWithContentsOfFile:filePath];
   NSArray *json = [NSJSONSerialization JSONObjectWithData:data options:kNilOptions error:nil];
-  _trackData = [[NSMutableArray alloc] init];
-  GMSMutablePath *path = [GMSMutablePath path];
+  NSUInteger count = json.count;
+  NSMutableData *latitudes = [NSMutableData dataWithLength:count * sizeof(double)];
+  NSMutableData *longitudes = [NSMutableData dataWithLength:count * sizeof(double)];
+  _elevations = [NSMutableData dataWithLength:count * sizeof(double)];
+  double *latitudeValues = latitudes.mutableBytes;
+  double *longitudeValues = longitudes.mutableBytes;
+  double *elevationValues = _elevations.mutableBytes;
 
-  for (NSUInteger i = 0; i < json.count; i++) {
+  for (NSUInteger i = 0; i < count; i++) {
     NSDictionary *info = [json objectAtIndex:i];
-    NSNumber *elevation = [info objectForKey:@"elevation"];
-    CLLocationDegrees lat = [[info objectForKey:@"lat"] doubleValue];
-    CLLocationDegrees lng = [[info objectForKey:@"lng"] doubleValue];
-    CLLocation *loc = [[CLLocation alloc] initWithLatitude:lat longitude:lng];
-    [_trackData addObject:@{@"loc" : loc, @"elevation" : elevation}];
-    [path addLatitude:lat longitude:lng];
+    latitudeValues[i] = [[info objectForKey:@"lat"] doubleValue];
+    longitudeValues[i] = [[info objectForKey:@"lng"] doubleValue];
+    elevationValues[i] = [[info objectForKey:@"elevation"] doubleValue];
   }
 
-  _polyline = [GMSPolyline polylineWithPath:path];
+  _pyramid = [[GMSPathSimplificationPyramid alloc] initWithLatitudes:latitudeValues
+                                                          longitudes:longitudeValues
+                                                               count:count
+                                                           tolerance:kSimplificationTolerance];
+  _polyline = [[GMSPolyline alloc] init];
   _polyline.strokeWidth = 6;
   _polyline.map = _mapView;
 }
 
+#pragma mark - GMSMapViewDelegate
+
+- (void)mapView:(GMSMapView *)mapView didChangeCameraPosition:(GMSCameraPosition *)position {
+  [self updatePolylineForZoom:position.zoom];
+}
+
 @end
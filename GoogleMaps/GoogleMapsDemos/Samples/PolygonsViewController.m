@@ -15,6 +15,7 @@
 // [START maps_ios_sample_draw_polygons]
 #import "GoogleMapsDemos/Samples/PolygonsViewController.h"
 
+#import "GoogleMapsDemos/GMSPolygonHitTestIndex.h"
 #import <GoogleMaps/GoogleMaps.h>
 
 @interface PolygonsViewController ()
@@ -24,7 +25,12 @@
 
 @end
 
-@implementation PolygonsViewController
+@implementation PolygonsViewController {
+  // Taps are resolved against this index rather than the SDK's overlay hit testing. The polygon
+  // at each index of |_polygons| is the one registered under the same index in |_hitTestIndex|.
+  GMSPolygonHitTestIndex *_hitTestIndex;
+  NSMutableArray<GMSPolygon *> *_polygons;
+}
 
 - (void)viewDidLoad {
   [super viewDidLoad];
@@ -32,7 +38,7 @@
                                                           longitude:-77.508545
                                                                zoom:4];
   GMSMapView *mapView = [GMSMapView mapWithFrame:CGRectZero camera:camera];
-  mapView.delegate = self;  // needed for didTapOverlay delegate method
+  mapView.delegate = self;  // needed for didTapAtCoordinate delegate method
 
   self.view = mapView;
 }
@@ -52,7 +58,8 @@
   polygon.fillColor = [UIColor colorWithRed:0.25 green:0 blue:0 alpha:0.2f];
   polygon.strokeColor = [UIColor blackColor];
   polygon.strokeWidth = 2;
-  polygon.tappable = YES;
+  // Taps go to mapView:didTapAtCoordinate: and are hit tested by |_hitTestIndex|.
+  polygon.tappable = NO;
   polygon.map = mapView;
   self.polygonOfNewYork = polygon;
 
@@ -63,12 +70,23 @@
   polygon.fillColor = [UIColor colorWithRed:0 green:0.25 blue:0 alpha:0.5];
   polygon.map = mapView;
   self.polygonOfNorthCarolina = polygon;
+
+  _hitTestIndex = [[GMSPolygonHitTestIndex alloc] init];
+  _polygons = [NSMutableArray array];
+  for (GMSPolygon *indexedPolygon in @[ self.polygonOfNewYork, self.polygonOfNorthCarolina ]) {
+    GMSPath *path = indexedPolygon.path;
+    if (path) {
+      [_hitTestIndex addPolygonWithPath:path holes:indexedPolygon.holes];
+      [_polygons addObject:indexedPolygon];
+    }
+  }
 }
 
-- (void)mapView:(GMSMapView *)mapView didTapOverlay:(GMSOverlay *)overlay {
+- (void)mapView:(GMSMapView *)mapView didTapAtCoordinate:(CLLocationCoordinate2D)coordinate {
   // When a polygon is tapped, randomly change its fill color to a new hue.
-  if ([overlay isKindOfClass:[GMSPolygon class]]) {
-    GMSPolygon *polygon = (GMSPolygon *)overlay;
+  NSUInteger index = [_hitTestIndex indexOfPolygonContainingCoordinate:coordinate];
+  if (index != NSNotFound) {
+    GMSPolygon *polygon = _polygons[index];
     CGFloat hue = (((float)arc4random() / 0x100000000) * 1.0f);
     polygon.fillColor = [UIColor colorWithHue:hue saturation:1 brightness:1 alpha:0.5];
   }
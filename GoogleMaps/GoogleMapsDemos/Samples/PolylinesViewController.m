@@ -15,6 +15,8 @@
 // [START maps_ios_sample_draw_polylines]
 #import "GoogleMapsDemos/Samples/PolylinesViewController.h"
 
+#import "GoogleMapsDemos/GMSGeodesicDensifier.h"
+#import "GoogleMapsDemos/GMSStyleSpansAnimator.h"
 #import <GoogleMaps/GoogleMaps.h>
 
 static CLLocationCoordinate2D kSydneyAustralia = {-33.866901, 151.195988};
@@ -24,18 +26,25 @@ static CLLocationCoordinate2D kMountainViewUSA = {37.423802, -122.091859};
 static CLLocationCoordinate2D kLimaPeru = {-12, -77};
 static bool kAnimate = true;
 
+// The lines are densified ahead of time to follow their great circles to within
+// kDensifyTolerance points up to kDensifyZoom, instead of being subdivided while rendering.
+static const float kDensifyZoom = 8;
+static const CGFloat kDensifyTolerance = 1;
+
 @implementation PolylinesViewController {
   NSArray *_styles;
   NSArray *_lengths;
   NSArray *_polys;
+  NSArray<GMSStyleSpansAnimator *> *_animators;
   double _pos, _step;
   GMSMapView *_mapView;
 }
 
 - (void)tick {
-  for (GMSPolyline *poly in _polys) {
-    poly.spans = GMSStyleSpansOffset(poly.path, _styles, _lengths, kGMSLengthGeodesic, _pos);
-  }
+  // The animators measured each path once in -initLines, so a frame only has to lay out spans.
+  [_polys enumerateObjectsUsingBlock:^(GMSPolyline *poly, NSUInteger idx, BOOL *stop) {
+    poly.spans = [self->_animators[idx] spansWithOffset:self->_pos];
+  }];
   _pos -= _step;
   if (kAnimate) {
     __weak id weakSelf = self;
@@ -49,6 +58,7 @@ static bool kAnimate = true;
 - (void)initLines {
   if (!_polys) {
     NSMutableArray *polys = [NSMutableArray array];
+    NSMutableArray<GMSStyleSpansAnimator *> *animators = [NSMutableArray array];
     GMSMutablePath *path = [GMSMutablePath path];
     [path addCoordinate:kSydneyAustralia];
     [path addCoordinate:kFiji];
@@ -58,15 +68,28 @@ static bool kAnimate = true;
     [path addCoordinate:kSydneyAustralia];
     path = [path pathOffsetByLatitude:-30 longitude:0];
     _lengths = @[ @([path lengthOfKind:kGMSLengthGeodesic] / 21) ];
+    NSMutableArray<GMSPath *> *linePaths = [NSMutableArray array];
+    for (int i = 0; i < 30; ++i) {
+      [linePaths addObject:[path pathOffsetByLatitude:(i * 1.5) longitude:0]];
+    }
+    GMSDensifiedPaths *densifiedPaths =
+        [GMSDensifiedPaths pathsByDensifyingPaths:linePaths
+                                             zoom:kDensifyZoom
+                                        tolerance:kDensifyTolerance];
     for (int i = 0; i < 30; ++i) {
       GMSPolyline *poly = [[GMSPolyline alloc] init];
-      poly.path = [path pathOffsetByLatitude:(i * 1.5) longitude:0];
+      GMSPath *linePath = [densifiedPaths pathAtIndex:i];
+      poly.path = linePath;
       poly.strokeWidth = 8;
-      poly.geodesic = YES;
+      poly.geodesic = NO;
       poly.map = _mapView;
       [polys addObject:poly];
+      [animators addObject:[[GMSStyleSpansAnimator alloc] initWithPath:linePath
+                                                                 styles:_styles
+                                                                lengths:_lengths]];
     }
     _polys = polys;
+    _animators = animators;
   }
 }
 
@@ -0,0 +1,321 @@
+/*
+ * Copyright 2026 Google LLC. All rights reserved.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#import "GoogleMapsXCFrameworkDemos/Common/GMSCoordinateBox.h"
+
+#include <simd/simd.h>
+#include <string.h>
+// Makes sin, asin and friends accept SIMD vectors as well as scalars.
+#include <tgmath.h>
+
+#if __has_feature(modules)
+@import GoogleMaps;
+#else
+#import <GoogleMaps/GoogleMaps.h>
+#endif
+
+typedef simd_double4 Lanes;
+
+static const NSUInteger kLaneCount = 4;
+
+// Same radius as kGMSEarthRadius.
+static const double kEarthRadius = 6371009;
+static const double kRadiansPerDegree = M_PI / 180;
+
+const GMSCoordinateBox kGMSCoordinateBoxEmpty = {90, 0, -90, 0};
+
+/** Wraps |longitude| into [-180, 180). */
+static CLLocationDegrees NormalizeLongitude(CLLocationDegrees longitude) {
+  return longitude - 360 * floor((longitude + 180) / 360);
+}
+
+/** Returns how far east |to| is from |from|, in [0, 360). */
+static CLLocationDegrees EastwardDistance(CLLocationDegrees from, CLLocationDegrees to) {
+  CLLocationDegrees distance = to - from;
+  return distance < 0 ? distance + 360 : distance;
+}
+
+static BOOL IsFullLongitude(GMSCoordinateBox box) { return box.west == -180 && box.east == 180; }
+
+/** Returns whether the normalized |longitude| lies between |west| and |east|, going east. */
+static BOOL LongitudeInRange(CLLocationDegrees longitude, CLLocationDegrees west,
+                             CLLocationDegrees east) {
+  if (west <= east) {
+    return longitude >= west && longitude <= east;
+  }
+  return longitude >= west || longitude <= east;
+}
+
+static GMSCoordinateBox BoxWithFullLongitude(CLLocationDegrees south, CLLocationDegrees north) {
+  return (GMSCoordinateBox){south, -180, north, 180};
+}
+
+GMSCoordinateBox GMSCoordinateBoxMake(CLLocationCoordinate2D southWest,
+                                      CLLocationCoordinate2D northEast) {
+  if (southWest.latitude > northEast.latitude) {
+    return kGMSCoordinateBoxEmpty;
+  }
+  CLLocationDegrees span = northEast.longitude - southWest.longitude;
+  if (span >= 360 || span <= -360) {
+    return BoxWithFullLongitude(southWest.latitude, northEast.latitude);
+  }
+  return (GMSCoordinateBox){southWest.latitude, NormalizeLongitude(southWest.longitude),
+                            northEast.latitude, NormalizeLongitude(northEast.longitude)};
+}
+
+GMSCoordinateBox GMSCoordinateBoxFromBounds(GMSCoordinateBounds *bounds) {
+  if (!bounds.isValid) {
+    return kGMSCoordinateBoxEmpty;
+  }
+  return GMSCoordinateBoxMake(bounds.southWest, bounds.northEast);
+}
+
+BOOL GMSCoordinateBoxIsEmpty(GMSCoordinateBox box) { return box.south > box.north; }
+
+CLLocationDegrees GMSCoordinateBoxLongitudeSpan(GMSCoordinateBox box) {
+  if (GMSCoordinateBoxIsEmpty(box)) {
+    return 0;
+  }
+  return IsFullLongitude(box) ? 360 : EastwardDistance(box.west, box.east);
+}
+
+BOOL GMSCoordinateBoxContainsCoordinate(GMSCoordinateBox box, CLLocationCoordinate2D coordinate) {
+  return coordinate.latitude >= box.south && coordinate.latitude <= box.north &&
+         LongitudeInRange(NormalizeLongitude(coordinate.longitude), box.west, box.east);
+}
+
+BOOL GMSCoordinateBoxContainsBox(GMSCoordinateBox outer, GMSCoordinateBox inner) {
+  if (GMSCoordinateBoxIsEmpty(inner)) {
+    return YES;
+  }
+  if (inner.south < outer.south || inner.north > outer.north) {
+    return NO;
+  }
+  if (IsFullLongitude(outer)) {
+    return YES;
+  }
+  if (IsFullLongitude(inner)) {
+    return NO;
+  }
+  // Both edges of |inner| must be in range, with its west edge reached first going east. This
+  // compares edges directly rather than adding spans, so rounding cannot break containment.
+  return LongitudeInRange(inner.west, outer.west, outer.east) &&
+         LongitudeInRange(inner.east, outer.west, outer.east) &&
+         EastwardDistance(outer.west, inner.west) <= EastwardDistance(outer.west, inner.east);
+}
+
+BOOL GMSCoordinateBoxIntersectsBox(GMSCoordinateBox a, GMSCoordinateBox b) {
+  if (GMSCoordinateBoxIsEmpty(a) || GMSCoordinateBoxIsEmpty(b) || a.south > b.north ||
+      b.south > a.north) {
+    return NO;
+  }
+  // Overlapping longitude ranges always have one range's west edge inside the other range.
+  return LongitudeInRange(b.west, a.west, a.east) || LongitudeInRange(a.west, b.west, b.east);
+}
+
+GMSCoordinateBox GMSCoordinateBoxUnion(GMSCoordinateBox a, GMSCoordinateBox b) {
+  if (GMSCoordinateBoxIsEmpty(a)) {
+    return b;
+  }
+  if (GMSCoordinateBoxIsEmpty(b)) {
+    return a;
+  }
+  CLLocationDegrees south = fmin(a.south, b.south);
+  CLLocationDegrees north = fmax(a.north, b.north);
+  GMSCoordinateBox aLongitudes = {south, a.west, north, a.east};
+  GMSCoordinateBox bLongitudes = {south, b.west, north, b.east};
+  if (GMSCoordinateBoxContainsBox(aLongitudes, bLongitudes)) {
+    return aLongitudes;
+  }
+  if (GMSCoordinateBoxContainsBox(bLongitudes, aLongitudes)) {
+    return bLongitudes;
+  }
+  BOOL aReachesB = LongitudeInRange(b.west, a.west, a.east);
+  BOOL bReachesA = LongitudeInRange(a.west, b.west, b.east);
+  if (aReachesB && bReachesA) {
+    // The ranges overlap at both ends and so cover every longitude between them.
+    return BoxWithFullLongitude(south, north);
+  }
+  if (!aReachesB && !bReachesA) {
+    // Disjoint ranges: bridge whichever gap between them is narrower.
+    aReachesB = EastwardDistance(a.east, b.west) <= EastwardDistance(b.east, a.west);
+  }
+  return aReachesB ? (GMSCoordinateBox){south, a.west, north, b.east}
+                   : (GMSCoordinateBox){south, b.west, north, a.east};
+}
+
+NSUInteger GMSCoordinateBoxIntersection(GMSCoordinateBox a, GMSCoordinateBox b,
+                                        GMSCoordinateBox *pieces) {
+  CLLocationDegrees south = fmax(a.south, b.south);
+  CLLocationDegrees north = fmin(a.north, b.north);
+  if (GMSCoordinateBoxIsEmpty(a) || GMSCoordinateBoxIsEmpty(b) || south > north) {
+    return 0;
+  }
+  if (IsFullLongitude(a) || IsFullLongitude(b)) {
+    GMSCoordinateBox narrower = IsFullLongitude(a) ? b : a;
+    pieces[0] = (GMSCoordinateBox){south, narrower.west, north, narrower.east};
+    return 1;
+  }
+  // Every piece of the intersection starts at the west edge of one range that lies inside the
+  // other, and ends at whichever east edge comes first from there.
+  NSUInteger count = 0;
+  if (LongitudeInRange(b.west, a.west, a.east)) {
+    CLLocationDegrees east =
+        EastwardDistance(b.west, a.east) < EastwardDistance(b.west, b.east) ? a.east : b.east;
+    pieces[count++] = (GMSCoordinateBox){south, b.west, north, east};
+  }
+  if (a.west != b.west && LongitudeInRange(a.west, b.west, b.east)) {
+    CLLocationDegrees east =
+        EastwardDistance(a.west, a.east) < EastwardDistance(a.west, b.east) ? a.east : b.east;
+    pieces[count++] = (GMSCoordinateBox){south, a.west, north, east};
+  }
+  return count;
+}
+
+GMSCoordinateBox GMSCoordinateBoxExpandedByDistance(GMSCoordinateBox box,
+                                                    CLLocationDistance distance) {
+  if (GMSCoordinateBoxIsEmpty(box) || distance <= 0) {
+    return box;
+  }
+  double angle = distance / kEarthRadius;
+  CLLocationDegrees south = box.south - angle / kRadiansPerDegree;
+  CLLocationDegrees north = box.north + angle / kRadiansPerDegree;
+  if (south <= -90 || north >= 90) {
+    return BoxWithFullLongitude(fmax(south, -90), fmin(north, 90));
+  }
+  // A circle of angular radius |angle| centred at latitude |phi| spans
+  // asin(sin(angle) / cos(phi)) of longitude either side, which is widest at the box's edge
+  // nearest a pole.
+  double cosLatitude = cos(fmax(fabs(box.south), fabs(box.north)) * kRadiansPerDegree);
+  double sinAngle = sin(angle);
+  if (IsFullLongitude(box) || sinAngle >= cosLatitude) {
+    return BoxWithFullLongitude(south, north);
+  }
+  CLLocationDegrees delta = asin(sinAngle / cosLatitude) / kRadiansPerDegree;
+  if (GMSCoordinateBoxLongitudeSpan(box) + 2 * delta >= 360) {
+    return BoxWithFullLongitude(south, north);
+  }
+  return (GMSCoordinateBox){south, NormalizeLongitude(box.west - delta), north,
+                            NormalizeLongitude(box.east + delta)};
+}
+
+#pragma mark - Batch operations
+
+/** Loads up to four values, repeating the last one to fill the vector. */
+static Lanes LoadLanes(const double *values, NSUInteger count) {
+  Lanes lanes;
+  if (count >= kLaneCount) {
+    memcpy(&lanes, values, sizeof(lanes));
+    return lanes;
+  }
+  for (NSUInteger i = 0; i < kLaneCount; i++) {
+    lanes[i] = values[MIN(i, count - 1)];
+  }
+  return lanes;
+}
+
+/** Stores the first |count| lanes. */
+static void StoreLanes(Lanes lanes, double *values, NSUInteger count) {
+  if (count >= kLaneCount) {
+    memcpy(values, &lanes, sizeof(lanes));
+    return;
+  }
+  for (NSUInteger i = 0; i < count; i++) {
+    values[i] = lanes[i];
+  }
+}
+
+/** Stores the first |count| lanes of |mask| as BOOLs. */
+static void StoreMask(simd_long4 mask, BOOL *values, NSUInteger count) {
+  for (NSUInteger i = 0; i < MIN(count, kLaneCount); i++) {
+    values[i] = mask[i] != 0;
+  }
+}
+
+/** Loads up to four boxes, one field per vector, repeating the last box to fill the vectors. */
+static void LoadBoxes(const GMSCoordinateBox *boxes, NSUInteger count, Lanes *south, Lanes *west,
+                      Lanes *north, Lanes *east) {
+  simd_double4x4 rows;
+  for (NSUInteger i = 0; i < kLaneCount; i++) {
+    memcpy(&rows.columns[i], &boxes[MIN(i, count - 1)], sizeof(Lanes));
+  }
+  simd_double4x4 fields = simd_transpose(rows);
+  *south = fields.columns[0];
+  *west = fields.columns[1];
+  *north = fields.columns[2];
+  *east = fields.columns[3];
+}
+
+/** Vector form of |LongitudeInRange|. */
+static simd_long4 LongitudeInRangeLanes(Lanes longitude, Lanes west, Lanes east) {
+  simd_long4 afterWest = longitude >= west;
+  simd_long4 beforeEast = longitude <= east;
+  simd_long4 wraps = west > east;
+  return (afterWest & beforeEast) | (wraps & (afterWest | beforeEast));
+}
+
+void GMSCoordinateBoxSample(GMSCoordinateBox box, const double *latitudeValues,
+                            const double *longitudeValues, NSUInteger count, double *latitudes,
+                            double *longitudes) {
+  // Latitudes are spread evenly in sin(latitude), which is proportional to the area of the band
+  // below them.
+  double sinSouth = sin(box.south * kRadiansPerDegree);
+  double sinNorth = sin(box.north * kRadiansPerDegree);
+  double span = GMSCoordinateBoxLongitudeSpan(box);
+  for (NSUInteger i = 0; i < count; i += kLaneCount) {
+    NSUInteger lanes = MIN(kLaneCount, count - i);
+    Lanes sinLatitude = sinSouth + LoadLanes(latitudeValues + i, lanes) * (sinNorth - sinSouth);
+    Lanes latitude = asin(sinLatitude) / kRadiansPerDegree;
+    Lanes longitude = box.west + LoadLanes(longitudeValues + i, lanes) * span;
+    longitude = simd_select(longitude, longitude - 360, longitude >= 180);
+    StoreLanes(latitude, latitudes + i, lanes);
+    StoreLanes(longitude, longitudes + i, lanes);
+  }
+}
+
+void GMSCoordinateBoxesContainCoordinate(const GMSCoordinateBox *boxes, NSUInteger count,
+                                         CLLocationCoordinate2D coordinate, BOOL *contains) {
+  Lanes latitude = coordinate.latitude;
+  Lanes longitude = NormalizeLongitude(coordinate.longitude);
+  for (NSUInteger i = 0; i < count; i += kLaneCount) {
+    NSUInteger lanes = MIN(kLaneCount, count - i);
+    Lanes south, west, north, east;
+    LoadBoxes(boxes + i, lanes, &south, &west, &north, &east);
+    simd_long4 inside = (latitude >= south) & (latitude <= north) &
+                        LongitudeInRangeLanes(longitude, west, east);
+    StoreMask(inside, contains + i, lanes);
+  }
+}
+
+void GMSCoordinateBoxesIntersectBox(const GMSCoordinateBox *boxes, NSUInteger count,
+                                    GMSCoordinateBox box, BOOL *intersects) {
+  if (GMSCoordinateBoxIsEmpty(box)) {
+    memset(intersects, NO, count * sizeof(BOOL));
+    return;
+  }
+  Lanes boxSouth = box.south;
+  Lanes boxWest = box.west;
+  Lanes boxNorth = box.north;
+  Lanes boxEast = box.east;
+  for (NSUInteger i = 0; i < count; i += kLaneCount) {
+    NSUInteger lanes = MIN(kLaneCount, count - i);
+    Lanes south, west, north, east;
+    LoadBoxes(boxes + i, lanes, &south, &west, &north, &east);
+    simd_long4 latitudesOverlap = (south <= north) & (south <= boxNorth) & (north >= boxSouth);
+    simd_long4 longitudesOverlap = LongitudeInRangeLanes(boxWest, west, east) |
+                                   LongitudeInRangeLanes(west, boxWest, boxEast);
+    StoreMask(latitudesOverlap & longitudesOverlap, intersects + i, lanes);
+  }
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2026 Google LLC. All rights reserved.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#import <CoreLocation/CoreLocation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Great circle maths over arrays of coordinates, for when the same question is asked about many
+ * pairs of points at once. All angles are in degrees and all distances in meters on a sphere with
+ * the same radius as GMSGeometryDistance.
+ *
+ * The batch functions read the start points from |fromLatitudes|/|fromLongitudes| and the end
+ * points from |toLatitudes|/|toLongitudes|, and process four pairs per iteration using SIMD
+ * vectors. To measure the legs of a path, pass the path's arrays as the start points and the same
+ * arrays offset by one as the end points. The single pair functions run the same vector kernels,
+ * so they agree exactly with the batch results.
+ */
+
+/** Returns the haversine distance between two points. */
+FOUNDATION_EXTERN CLLocationDistance GMSGreatCircleDistance(CLLocationCoordinate2D from,
+                                                            CLLocationCoordinate2D to);
+
+/** Returns the initial bearing from |from| to |to|, in [0, 360). */
+FOUNDATION_EXTERN CLLocationDirection GMSGreatCircleHeading(CLLocationCoordinate2D from,
+                                                            CLLocationCoordinate2D to);
+
+/** Returns the point |fraction| of the way from |from| to |to| along the great circle. */
+FOUNDATION_EXTERN CLLocationCoordinate2D GMSGreatCircleInterpolate(CLLocationCoordinate2D from,
+                                                                   CLLocationCoordinate2D to,
+                                                                   double fraction);
+
+/** Writes the haversine distance of each pair to |distances|. */
+FOUNDATION_EXTERN void GMSGreatCircleDistances(const double *fromLatitudes,
+                                               const double *fromLongitudes,
+                                               const double *toLatitudes,
+                                               const double *toLongitudes, NSUInteger count,
+                                               double *distances);
+
+/** Writes the initial bearing of each pair to |headings|. */
+FOUNDATION_EXTERN void GMSGreatCircleHeadings(const double *fromLatitudes,
+                                              const double *fromLongitudes,
+                                              const double *toLatitudes,
+                                              const double *toLongitudes, NSUInteger count,
+                                              double *headings);
+
+/** Writes the point |fractions[i]| of the way along each pair to |latitudes| and |longitudes|. */
+FOUNDATION_EXTERN void GMSGreatCircleInterpolations(const double *fromLatitudes,
+                                                    const double *fromLongitudes,
+                                                    const double *toLatitudes,
+                                                    const double *toLongitudes,
+                                                    const double *fractions, NSUInteger count,
+                                                    double *latitudes, double *longitudes);
+
+NS_ASSUME_NONNULL_END
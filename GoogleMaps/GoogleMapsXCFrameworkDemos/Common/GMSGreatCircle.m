@@ -0,0 +1,163 @@
+/*
+ * Copyright 2026 Google LLC. All rights reserved.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#import "GoogleMapsXCFrameworkDemos/Common/GMSGreatCircle.h"
+
+#include <simd/simd.h>
+#include <string.h>
+// Makes sin, cos, atan2 and friends accept SIMD vectors as well as scalars.
+#include <tgmath.h>
+
+typedef simd_double4 Lanes;
+
+static const NSUInteger kLaneCount = 4;
+
+// Same radius as kGMSEarthRadius.
+static const double kEarthRadius = 6371009;
+static const double kRadiansPerDegree = M_PI / 180;
+
+// Below this the two points are treated as coincident and interpolated linearly.
+static const double kMinimumSinAngle = 1e-12;
+
+static const Lanes kOne = {1, 1, 1, 1};
+static const Lanes kFullCircle = {360, 360, 360, 360};
+
+/** Loads up to four values, repeating the last one to fill the vector. */
+static Lanes LoadLanes(const double *values, NSUInteger count) {
+  Lanes lanes;
+  if (count >= kLaneCount) {
+    memcpy(&lanes, values, sizeof(lanes));
+    return lanes;
+  }
+  for (NSUInteger i = 0; i < kLaneCount; i++) {
+    lanes[i] = values[MIN(i, count - 1)];
+  }
+  return lanes;
+}
+
+/** Stores the first |count| lanes. */
+static void StoreLanes(Lanes lanes, double *values, NSUInteger count) {
+  if (count >= kLaneCount) {
+    memcpy(values, &lanes, sizeof(lanes));
+    return;
+  }
+  for (NSUInteger i = 0; i < count; i++) {
+    values[i] = lanes[i];
+  }
+}
+
+/** Returns the central angle between two points, given in radians. */
+static Lanes CentralAngleLanes(Lanes lat1, Lanes lng1, Lanes lat2, Lanes lng2) {
+  Lanes sinHalfLat = sin((lat2 - lat1) * 0.5);
+  Lanes sinHalfLng = sin((lng2 - lng1) * 0.5);
+  Lanes h = sinHalfLat * sinHalfLat + cos(lat1) * cos(lat2) * sinHalfLng * sinHalfLng;
+  return 2 * asin(sqrt(simd_min(h, kOne)));
+}
+
+static Lanes DistanceLanes(Lanes lat1, Lanes lng1, Lanes lat2, Lanes lng2) {
+  return kEarthRadius * CentralAngleLanes(lat1 * kRadiansPerDegree, lng1 * kRadiansPerDegree,
+                                          lat2 * kRadiansPerDegree, lng2 * kRadiansPerDegree);
+}
+
+static Lanes HeadingLanes(Lanes lat1, Lanes lng1, Lanes lat2, Lanes lng2) {
+  lat1 *= kRadiansPerDegree;
+  lat2 *= kRadiansPerDegree;
+  Lanes deltaLng = (lng2 - lng1) * kRadiansPerDegree;
+  Lanes y = sin(deltaLng) * cos(lat2);
+  Lanes x = cos(lat1) * sin(lat2) - sin(lat1) * cos(lat2) * cos(deltaLng);
+  return fmod(atan2(y, x) / kRadiansPerDegree + kFullCircle, kFullCircle);
+}
+
+static void InterpolateLanes(Lanes lat1, Lanes lng1, Lanes lat2, Lanes lng2, Lanes fraction,
+                             Lanes *latitude, Lanes *longitude) {
+  lat1 *= kRadiansPerDegree;
+  lng1 *= kRadiansPerDegree;
+  lat2 *= kRadiansPerDegree;
+  lng2 *= kRadiansPerDegree;
+  Lanes angle = CentralAngleLanes(lat1, lng1, lat2, lng2);
+  Lanes sinAngle = sin(angle);
+  simd_long4 coincident = sinAngle < kMinimumSinAngle;
+  Lanes a = simd_select(sin((1 - fraction) * angle) / sinAngle, 1 - fraction, coincident);
+  Lanes b = simd_select(sin(fraction * angle) / sinAngle, fraction, coincident);
+
+  Lanes cosLat1 = cos(lat1);
+  Lanes cosLat2 = cos(lat2);
+  Lanes x = a * cosLat1 * cos(lng1) + b * cosLat2 * cos(lng2);
+  Lanes y = a * cosLat1 * sin(lng1) + b * cosLat2 * sin(lng2);
+  Lanes z = a * sin(lat1) + b * sin(lat2);
+  *latitude = atan2(z, sqrt(x * x + y * y)) / kRadiansPerDegree;
+  *longitude = atan2(y, x) / kRadiansPerDegree;
+}
+
+CLLocationDistance GMSGreatCircleDistance(CLLocationCoordinate2D from, CLLocationCoordinate2D to) {
+  double distance;
+  GMSGreatCircleDistances(&from.latitude, &from.longitude, &to.latitude, &to.longitude, 1,
+                          &distance);
+  return distance;
+}
+
+CLLocationDirection GMSGreatCircleHeading(CLLocationCoordinate2D from, CLLocationCoordinate2D to) {
+  double heading;
+  GMSGreatCircleHeadings(&from.latitude, &from.longitude, &to.latitude, &to.longitude, 1,
+                         &heading);
+  return heading;
+}
+
+CLLocationCoordinate2D GMSGreatCircleInterpolate(CLLocationCoordinate2D from,
+                                                 CLLocationCoordinate2D to, double fraction) {
+  CLLocationCoordinate2D result;
+  GMSGreatCircleInterpolations(&from.latitude, &from.longitude, &to.latitude, &to.longitude,
+                               &fraction, 1, &result.latitude, &result.longitude);
+  return result;
+}
+
+void GMSGreatCircleDistances(const double *fromLatitudes, const double *fromLongitudes,
+                             const double *toLatitudes, const double *toLongitudes,
+                             NSUInteger count, double *distances) {
+  for (NSUInteger i = 0; i < count; i += kLaneCount) {
+    NSUInteger lanes = MIN(kLaneCount, count - i);
+    Lanes distance =
+        DistanceLanes(LoadLanes(fromLatitudes + i, lanes), LoadLanes(fromLongitudes + i, lanes),
+                      LoadLanes(toLatitudes + i, lanes), LoadLanes(toLongitudes + i, lanes));
+    StoreLanes(distance, distances + i, lanes);
+  }
+}
+
+void GMSGreatCircleHeadings(const double *fromLatitudes, const double *fromLongitudes,
+                            const double *toLatitudes, const double *toLongitudes,
+                            NSUInteger count, double *headings) {
+  for (NSUInteger i = 0; i < count; i += kLaneCount) {
+    NSUInteger lanes = MIN(kLaneCount, count - i);
+    Lanes heading =
+        HeadingLanes(LoadLanes(fromLatitudes + i, lanes), LoadLanes(fromLongitudes + i, lanes),
+                     LoadLanes(toLatitudes + i, lanes), LoadLanes(toLongitudes + i, lanes));
+    StoreLanes(heading, headings + i, lanes);
+  }
+}
+
+void GMSGreatCircleInterpolations(const double *fromLatitudes, const double *fromLongitudes,
+                                  const double *toLatitudes, const double *toLongitudes,
+                                  const double *fractions, NSUInteger count, double *latitudes,
+                                  double *longitudes) {
+  for (NSUInteger i = 0; i < count; i += kLaneCount) {
+    NSUInteger lanes = MIN(kLaneCount, count - i);
+    Lanes latitude, longitude;
+    InterpolateLanes(LoadLanes(fromLatitudes + i, lanes), LoadLanes(fromLongitudes + i, lanes),
+                     LoadLanes(toLatitudes + i, lanes), LoadLanes(toLongitudes + i, lanes),
+                     LoadLanes(fractions + i, lanes), &latitude, &longitude);
+    StoreLanes(latitude, latitudes + i, lanes);
+    StoreLanes(longitude, longitudes + i, lanes);
+  }
+}
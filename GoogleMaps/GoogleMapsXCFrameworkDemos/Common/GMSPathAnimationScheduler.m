@@ -0,0 +1,206 @@
+/*
+ * Copyright 2026 Google LLC. All rights reserved.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#import "GoogleMapsXCFrameworkDemos/Common/GMSPathAnimationScheduler.h"
+
+#include <math.h>
+
+#import "GoogleMapsXCFrameworkDemos/Common/GMSGreatCircle.h"
+#if __has_feature(modules)
+@import GoogleMaps;
+#else
+#import <GoogleMaps/GoogleMaps.h>
+#endif
+
+/** Grows |data| by |count| values of |size| bytes and returns the first new value. */
+static void *AppendValues(NSMutableData *data, NSUInteger count, size_t size) {
+  NSUInteger offset = data.length;
+  [data increaseLengthBy:count * size];
+  return (uint8_t *)data.mutableBytes + offset;
+}
+
+@implementation GMSPathAnimationScheduler {
+  NSTimeInterval _pendingTime;
+
+  // Every leg of every path. Leg |i| runs from |_legFrom*[i]| to |_legTo*[i]| and starts
+  // |_legStarts[i]| meters into its path.
+  NSMutableData *_legFromLatitudes;
+  NSMutableData *_legFromLongitudes;
+  NSMutableData *_legToLatitudes;
+  NSMutableData *_legToLongitudes;
+  NSMutableData *_legLengths;
+  NSMutableData *_legHeadings;
+  NSMutableData *_legStarts;
+
+  // Per entity state: the entity's legs are |_firstLegs[i]| up to |_firstLegs[i] + _legCounts[i]|.
+  NSMutableData *_firstLegs;
+  NSMutableData *_legCounts;
+  NSMutableData *_currentLegs;
+  NSMutableData *_loopLengths;
+  NSMutableData *_distances;
+  NSMutableData *_speeds;
+
+  // Per entity output.
+  NSMutableData *_latitudes;
+  NSMutableData *_longitudes;
+  NSMutableData *_headings;
+}
+
+- (instancetype)initWithTimestep:(NSTimeInterval)timestep {
+  if ((self = [super init])) {
+    _timestep = timestep;
+    _legFromLatitudes = [NSMutableData data];
+    _legFromLongitudes = [NSMutableData data];
+    _legToLatitudes = [NSMutableData data];
+    _legToLongitudes = [NSMutableData data];
+    _legLengths = [NSMutableData data];
+    _legHeadings = [NSMutableData data];
+    _legStarts = [NSMutableData data];
+    _firstLegs = [NSMutableData data];
+    _legCounts = [NSMutableData data];
+    _currentLegs = [NSMutableData data];
+    _loopLengths = [NSMutableData data];
+    _distances = [NSMutableData data];
+    _speeds = [NSMutableData data];
+    _latitudes = [NSMutableData data];
+    _longitudes = [NSMutableData data];
+    _headings = [NSMutableData data];
+  }
+  return self;
+}
+
+- (const double *)latitudes {
+  return _latitudes.bytes;
+}
+
+- (const double *)longitudes {
+  return _longitudes.bytes;
+}
+
+- (const double *)headings {
+  return _headings.bytes;
+}
+
+- (NSUInteger)addEntityWithPath:(GMSPath *)path speed:(CLLocationSpeed)speed {
+  NSUInteger firstLeg = _legLengths.length / sizeof(double);
+  // A closed path has as many legs as vertices. A single vertex becomes one empty leg, which keeps
+  // the entity in place.
+  NSUInteger count = MAX(path.count, 1);
+  double *fromLatitudes = AppendValues(_legFromLatitudes, count, sizeof(double));
+  double *fromLongitudes = AppendValues(_legFromLongitudes, count, sizeof(double));
+  double *toLatitudes = AppendValues(_legToLatitudes, count, sizeof(double));
+  double *toLongitudes = AppendValues(_legToLongitudes, count, sizeof(double));
+  for (NSUInteger i = 0; i < count; i++) {
+    CLLocationCoordinate2D from = [path coordinateAtIndex:i % path.count];
+    CLLocationCoordinate2D to = [path coordinateAtIndex:(i + 1) % path.count];
+    fromLatitudes[i] = from.latitude;
+    fromLongitudes[i] = from.longitude;
+    toLatitudes[i] = to.latitude;
+    toLongitudes[i] = to.longitude;
+  }
+  double *lengths = AppendValues(_legLengths, count, sizeof(double));
+  double *headings = AppendValues(_legHeadings, count, sizeof(double));
+  double *starts = AppendValues(_legStarts, count, sizeof(double));
+  GMSGreatCircleDistances(fromLatitudes, fromLongitudes, toLatitudes, toLongitudes, count,
+                          lengths);
+  GMSGreatCircleHeadings(fromLatitudes, fromLongitudes, toLatitudes, toLongitudes, count,
+                         headings);
+  double loopLength = 0;
+  for (NSUInteger i = 0; i < count; i++) {
+    starts[i] = loopLength;
+    loopLength += lengths[i];
+  }
+
+  NSUInteger entity = _entityCount++;
+  *(NSUInteger *)AppendValues(_firstLegs, 1, sizeof(NSUInteger)) = firstLeg;
+  *(NSUInteger *)AppendValues(_legCounts, 1, sizeof(NSUInteger)) = count;
+  *(NSUInteger *)AppendValues(_currentLegs, 1, sizeof(NSUInteger)) = firstLeg;
+  *(double *)AppendValues(_loopLengths, 1, sizeof(double)) = loopLength;
+  *(double *)AppendValues(_distances, 1, sizeof(double)) = 0;
+  *(double *)AppendValues(_speeds, 1, sizeof(double)) = speed;
+  *(double *)AppendValues(_latitudes, 1, sizeof(double)) = fromLatitudes[0];
+  *(double *)AppendValues(_longitudes, 1, sizeof(double)) = fromLongitudes[0];
+  *(double *)AppendValues(_headings, 1, sizeof(double)) = headings[0];
+  return entity;
+}
+
+- (NSUInteger)advanceByTime:(NSTimeInterval)elapsed {
+  _pendingTime += elapsed;
+  NSUInteger steps = (NSUInteger)floor(_pendingTime / _timestep);
+  if (steps == 0) {
+    return 0;
+  }
+  _pendingTime -= steps * _timestep;
+
+  const double *legLengths = _legLengths.bytes;
+  const double *legStarts = _legStarts.bytes;
+  const NSUInteger *firstLegs = _firstLegs.bytes;
+  const NSUInteger *legCounts = _legCounts.bytes;
+  const double *loopLengths = _loopLengths.bytes;
+  const double *speeds = _speeds.bytes;
+  NSUInteger *currentLegs = _currentLegs.mutableBytes;
+  double *distances = _distances.mutableBytes;
+  // Speeds are constant, so all the steps are covered in one move per entity. This keeps the cost
+  // of a long gap, such as the app returning from the background, the same as a single step.
+  NSTimeInterval time = steps * _timestep;
+  for (NSUInteger i = 0; i < _entityCount; i++) {
+    if (loopLengths[i] <= 0) {
+      continue;
+    }
+    double distance = distances[i] + speeds[i] * time;
+    NSUInteger leg = currentLegs[i];
+    if (distance >= loopLengths[i]) {
+      distance = fmod(distance, loopLengths[i]);
+      leg = firstLegs[i];
+    }
+    NSUInteger lastLeg = firstLegs[i] + legCounts[i] - 1;
+    while (leg < lastLeg && distance >= legStarts[leg] + legLengths[leg]) {
+      leg++;
+    }
+    distances[i] = distance;
+    currentLegs[i] = leg;
+  }
+
+  // Gather each entity's leg and fraction, then interpolate every position in one batch.
+  const double *legFromLatitudes = _legFromLatitudes.bytes;
+  const double *legFromLongitudes = _legFromLongitudes.bytes;
+  const double *legToLatitudes = _legToLatitudes.bytes;
+  const double *legToLongitudes = _legToLongitudes.bytes;
+  const double *legHeadings = _legHeadings.bytes;
+  double *latitudes = _latitudes.mutableBytes;
+  double *longitudes = _longitudes.mutableBytes;
+  double *headings = _headings.mutableBytes;
+  NSMutableData *scratch = [NSMutableData dataWithLength:_entityCount * 5 * sizeof(double)];
+  double *fromLatitudes = scratch.mutableBytes;
+  double *fromLongitudes = fromLatitudes + _entityCount;
+  double *toLatitudes = fromLongitudes + _entityCount;
+  double *toLongitudes = toLatitudes + _entityCount;
+  double *fractions = toLongitudes + _entityCount;
+  for (NSUInteger i = 0; i < _entityCount; i++) {
+    NSUInteger leg = currentLegs[i];
+    fromLatitudes[i] = legFromLatitudes[leg];
+    fromLongitudes[i] = legFromLongitudes[leg];
+    toLatitudes[i] = legToLatitudes[leg];
+    toLongitudes[i] = legToLongitudes[leg];
+    fractions[i] =
+        legLengths[leg] > 0 ? fmin((distances[i] - legStarts[leg]) / legLengths[leg], 1) : 0;
+    headings[i] = legHeadings[leg];
+  }
+  GMSGreatCircleInterpolations(fromLatitudes, fromLongitudes, toLatitudes, toLongitudes, fractions,
+                               _entityCount, latitudes, longitudes);
+  return steps;
+}
+
+@end
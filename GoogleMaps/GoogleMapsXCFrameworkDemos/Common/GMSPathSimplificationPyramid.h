@@ -0,0 +1,62 @@
+/*
+ * Copyright 2026 Google LLC. All rights reserved.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class GMSPath;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A Douglas-Peucker simplification of a track, precomputed for every integer zoom level.
+ *
+ * Each vertex is assigned an importance, the deviation it corrects when the track is simplified,
+ * and from that the lowest zoom at which the deviation becomes visible. The vertices kept at each
+ * zoom are stored in path order, so a query only touches the vertices it returns. At every zoom
+ * the simplified track stays within |tolerance| screen points of the original. A fractional zoom
+ * uses the level of the integer zoom above it, since a level also holds at every lower zoom.
+ */
+@interface GMSPathSimplificationPyramid : NSObject
+
+/** Highest zoom level with its own simplification. Every vertex is kept from this level on. */
+@property(class, nonatomic, readonly) NSUInteger maximumZoomLevel;
+
+/** Number of vertices in the original track. */
+@property(nonatomic, readonly) NSUInteger count;
+
+/**
+ * Builds the pyramid for |count| coordinates.
+ *
+ * @param tolerance The largest allowed deviation from the original track, in screen points.
+ */
+- (instancetype)initWithLatitudes:(const double *)latitudes
+                       longitudes:(const double *)longitudes
+                            count:(NSUInteger)count
+                        tolerance:(double)tolerance NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Returns the indices of the vertices kept at |zoom|, rounded up to an integer zoom level, in
+ * path order. The returned buffer is owned by the pyramid.
+ */
+- (const uint32_t *)indicesForZoom:(float)zoom count:(NSUInteger *)count;
+
+/** Returns the simplified track for |zoom|. */
+- (GMSPath *)pathForZoom:(float)zoom;
+
+@end
+
+NS_ASSUME_NONNULL_END
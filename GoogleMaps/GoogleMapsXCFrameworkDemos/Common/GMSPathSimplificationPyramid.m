@@ -0,0 +1,187 @@
+/*
+ * Copyright 2026 Google LLC. All rights reserved.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#import "GoogleMapsXCFrameworkDemos/Common/GMSPathSimplificationPyramid.h"
+
+#include <math.h>
+
+#if __has_feature(modules)
+@import GoogleMaps;
+#else
+#import <GoogleMaps/GoogleMaps.h>
+#endif
+
+static const NSUInteger kMaximumZoomLevel = 21;
+
+// Width of the whole world, in points, at zoom level 0.
+static const double kWorldSize = 256;
+
+static const double kMaximumMercatorLatitude = 85.051128779806589;
+
+/** Projects a coordinate onto the unit Web Mercator square. */
+static void ProjectCoordinate(double latitude, double longitude, double *x, double *y) {
+  latitude = fmax(fmin(latitude, kMaximumMercatorLatitude), -kMaximumMercatorLatitude);
+  double sinLatitude = sin(latitude * M_PI / 180);
+  *x = (longitude + 180) / 360;
+  *y = 0.5 - log((1 + sinLatitude) / (1 - sinLatitude)) / (4 * M_PI);
+}
+
+/** Returns the distance from point |p| to the segment |a|-|b|. */
+static double SegmentDistance(double px, double py, double ax, double ay, double bx, double by) {
+  double dx = bx - ax;
+  double dy = by - ay;
+  double lengthSquared = dx * dx + dy * dy;
+  double t = lengthSquared > 0 ? ((px - ax) * dx + (py - ay) * dy) / lengthSquared : 0;
+  t = fmax(0, fmin(1, t));
+  return hypot(px - (ax + t * dx), py - (ay + t * dy));
+}
+
+/**
+ * Runs Douglas-Peucker to completion and records, for each interior vertex, the largest tolerance
+ * at which it survives. A vertex never outlives the vertex whose split exposed it, so keeping
+ * every vertex whose importance exceeds |t| reproduces Douglas-Peucker with tolerance |t|.
+ */
+static void ComputeImportance(const double *x, const double *y, NSUInteger count,
+                              double *importance) {
+  importance[0] = INFINITY;
+  importance[count - 1] = INFINITY;
+  if (count < 3) {
+    return;
+  }
+  // Each pending range is stored as its first index, last index and the importance of the split
+  // that created it. The ranges nest, so the stack never holds more than |count| of them.
+  NSMutableData *stackData = [NSMutableData dataWithLength:count * 3 * sizeof(double)];
+  double *stack = stackData.mutableBytes;
+  NSUInteger depth = 0;
+  stack[depth++] = 0;
+  stack[depth++] = count - 1;
+  stack[depth++] = INFINITY;
+  while (depth > 0) {
+    double limit = stack[--depth];
+    NSUInteger last = (NSUInteger)stack[--depth];
+    NSUInteger first = (NSUInteger)stack[--depth];
+    if (last - first < 2) {
+      continue;
+    }
+    NSUInteger split = first + 1;
+    double maximum = -1;
+    for (NSUInteger i = first + 1; i < last; i++) {
+      double distance = SegmentDistance(x[i], y[i], x[first], y[first], x[last], y[last]);
+      if (distance > maximum) {
+        maximum = distance;
+        split = i;
+      }
+    }
+    double splitImportance = fmin(maximum, limit);
+    importance[split] = splitImportance;
+    stack[depth++] = first;
+    stack[depth++] = split;
+    stack[depth++] = splitImportance;
+    stack[depth++] = split;
+    stack[depth++] = last;
+    stack[depth++] = splitImportance;
+  }
+}
+
+@implementation GMSPathSimplificationPyramid {
+  NSData *_latitudes;
+  NSData *_longitudes;
+  // Kept vertex indices for each zoom level, from 0 up to |kMaximumZoomLevel|.
+  NSArray<NSData *> *_levels;
+}
+
++ (NSUInteger)maximumZoomLevel {
+  return kMaximumZoomLevel;
+}
+
+- (instancetype)initWithLatitudes:(const double *)latitudes
+                       longitudes:(const double *)longitudes
+                            count:(NSUInteger)count
+                        tolerance:(double)tolerance {
+  if ((self = [super init])) {
+    _count = count;
+    _latitudes = [NSData dataWithBytes:latitudes length:count * sizeof(double)];
+    _longitudes = [NSData dataWithBytes:longitudes length:count * sizeof(double)];
+    if (count == 0) {
+      _levels = @[];
+      return self;
+    }
+
+    NSMutableData *xData = [NSMutableData dataWithLength:count * sizeof(double)];
+    NSMutableData *yData = [NSMutableData dataWithLength:count * sizeof(double)];
+    NSMutableData *importanceData = [NSMutableData dataWithLength:count * sizeof(double)];
+    double *x = xData.mutableBytes;
+    double *y = yData.mutableBytes;
+    double *importance = importanceData.mutableBytes;
+    for (NSUInteger i = 0; i < count; i++) {
+      ProjectCoordinate(latitudes[i], longitudes[i], &x[i], &y[i]);
+    }
+    ComputeImportance(x, y, count, importance);
+
+    // At zoom z one point spans 1 / (256 * 2^z) of the world, so a vertex becomes visible at the
+    // first zoom where its importance is larger than the tolerance in world units.
+    NSMutableData *minimumZoomData = [NSMutableData dataWithLength:count];
+    uint8_t *minimumZoom = minimumZoomData.mutableBytes;
+    NSUInteger levelCounts[kMaximumZoomLevel + 1] = {0};
+    for (NSUInteger i = 0; i < count; i++) {
+      double zoom = importance[i] > 0 ? floor(log2(tolerance / (kWorldSize * importance[i]))) + 1
+                                      : kMaximumZoomLevel;
+      minimumZoom[i] = (uint8_t)fmax(0, fmin(zoom, kMaximumZoomLevel));
+      levelCounts[minimumZoom[i]]++;
+    }
+
+    NSMutableArray<NSData *> *levels = [NSMutableArray arrayWithCapacity:kMaximumZoomLevel + 1];
+    NSUInteger kept = 0;
+    for (NSUInteger zoom = 0; zoom <= kMaximumZoomLevel; zoom++) {
+      kept += levelCounts[zoom];
+      NSMutableData *level = [NSMutableData dataWithLength:kept * sizeof(uint32_t)];
+      uint32_t *indices = level.mutableBytes;
+      NSUInteger next = 0;
+      for (NSUInteger i = 0; i < count; i++) {
+        if (minimumZoom[i] <= zoom) {
+          indices[next++] = (uint32_t)i;
+        }
+      }
+      [levels addObject:level];
+    }
+    _levels = levels;
+  }
+  return self;
+}
+
+- (const uint32_t *)indicesForZoom:(float)zoom count:(NSUInteger *)count {
+  if (_levels.count == 0) {
+    *count = 0;
+    return NULL;
+  }
+  NSUInteger level = (NSUInteger)fmax(0, fmin(ceilf(zoom), kMaximumZoomLevel));
+  NSData *indices = _levels[level];
+  *count = indices.length / sizeof(uint32_t);
+  return indices.bytes;
+}
+
+- (GMSPath *)pathForZoom:(float)zoom {
+  NSUInteger count;
+  const uint32_t *indices = [self indicesForZoom:zoom count:&count];
+  const double *latitudes = _latitudes.bytes;
+  const double *longitudes = _longitudes.bytes;
+  GMSMutablePath *path = [GMSMutablePath path];
+  for (NSUInteger i = 0; i < count; i++) {
+    [path addLatitude:latitudes[indices[i]] longitude:longitudes[indices[i]]];
+  }
+  return path;
+}
+
+@end
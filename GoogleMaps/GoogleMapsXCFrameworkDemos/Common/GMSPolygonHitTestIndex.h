@@ -0,0 +1,60 @@
+/*
+ * Copyright 2026 Google LLC. All rights reserved.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#import <CoreLocation/CoreLocation.h>
+
+@class GMSPath;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Answers which of many polygons, holes included, contains a point.
+ *
+ * Each polygon's edges are binned into horizontal latitude slabs, so a point is only tested
+ * against the few edges that cross its own slab. The polygons themselves are binned the same way
+ * by their bounding boxes, which keeps a lookup fast when thousands of polygons are indexed.
+ * Edges are treated as straight lines in latitude and longitude, and polygons must not cross the
+ * antimeridian.
+ */
+@interface GMSPolygonHitTestIndex : NSObject
+
+/** Number of polygons added so far. */
+@property(nonatomic, readonly) NSUInteger count;
+
+/**
+ * Adds a polygon. Points inside any of |holes| are outside the polygon.
+ *
+ * @return The index the polygon is reported under.
+ */
+- (NSUInteger)addPolygonWithPath:(GMSPath *)path holes:(nullable NSArray<GMSPath *> *)holes;
+
+/**
+ * Returns the index of the polygon containing |coordinate|, or NSNotFound. When polygons overlap
+ * the one added last wins, matching the drawing order of overlays with equal z-index.
+ */
+- (NSUInteger)indexOfPolygonContainingCoordinate:(CLLocationCoordinate2D)coordinate;
+
+/**
+ * Classifies |count| points at once, writing the result of
+ * |indexOfPolygonContainingCoordinate:| for point |i| to |indices[i]|.
+ */
+- (void)classifyLatitudes:(const double *)latitudes
+               longitudes:(const double *)longitudes
+                    count:(NSUInteger)count
+                  indices:(NSUInteger *)indices;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,229 @@
+/*
+ * Copyright 2026 Google LLC. All rights reserved.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#import "GoogleMapsXCFrameworkDemos/Common/GMSPolylineCodec.h"
+
+#include <math.h>
+#include <string.h>
+
+#if __has_feature(modules)
+@import GoogleMaps;
+#else
+#import <GoogleMaps/GoogleMaps.h>
+#endif
+
+// Every encoded byte is a 5-bit chunk offset by 63. A chunk below 0x20 ends a value, so any byte
+// below 63 + 0x20 is the last byte of a latitude or longitude delta.
+static const unsigned char kChunkOffset = 63;
+static const unsigned char kContinuationBit = 0x20;
+static const unsigned char kTerminatorLimit = kChunkOffset + kContinuationBit;
+static const double kCoordinateFactor = 1e5;
+
+// A 32-bit zigzag value never needs more than 7 chunks.
+static const size_t kMaxBytesPerValue = 7;
+
+NSUInteger GMSPolylineCodecCountCoordinates(const char *encoded, size_t length) {
+  // Adding 128 - 95 to each byte sets its high bit exactly when the byte is not a terminator, so
+  // eight bytes are classified per add instead of one per branch.
+  static const uint64_t kBias = 0x2121212121212121ULL;
+  static const uint64_t kHighBits = 0x8080808080808080ULL;
+  const unsigned char *bytes = (const unsigned char *)encoded;
+  NSUInteger terminators = 0;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, bytes + i, sizeof(word));
+    terminators += sizeof(uint64_t) - (NSUInteger)__builtin_popcountll((word + kBias) & kHighBits);
+  }
+  for (; i < length; i++) {
+    terminators += bytes[i] < kTerminatorLimit;
+  }
+  return terminators / 2;
+}
+
+/** Reads one zigzag-encoded delta starting at |*index|. Returns NO if the input is malformed. */
+static BOOL DecodeValue(const unsigned char *bytes, size_t length, size_t *index, int32_t *value) {
+  uint32_t result = 0;
+  unsigned int shift = 0;
+  size_t i = *index;
+  while (i < length && shift < 32) {
+    unsigned int chunk = (unsigned int)bytes[i++] - kChunkOffset;
+    if (chunk > 0x3f) {
+      return NO;
+    }
+    result |= (chunk & 0x1f) << shift;
+    shift += 5;
+    if (chunk < kContinuationBit) {
+      *index = i;
+      *value = (result & 1) ? ~(int32_t)(result >> 1) : (int32_t)(result >> 1);
+      return YES;
+    }
+  }
+  return NO;
+}
+
+NSInteger GMSPolylineCodecDecode(const char *encoded, size_t length, double *latitudes,
+                                 double *longitudes, NSUInteger capacity) {
+  const unsigned char *bytes = (const unsigned char *)encoded;
+  int32_t latitude = 0;
+  int32_t longitude = 0;
+  NSUInteger count = 0;
+  size_t i = 0;
+  while (i < length) {
+    int32_t deltaLatitude, deltaLongitude;
+    if (count == capacity || !DecodeValue(bytes, length, &i, &deltaLatitude) ||
+        !DecodeValue(bytes, length, &i, &deltaLongitude)) {
+      return -1;
+    }
+    latitude += deltaLatitude;
+    longitude += deltaLongitude;
+    latitudes[count] = latitude / kCoordinateFactor;
+    longitudes[count] = longitude / kCoordinateFactor;
+    count++;
+  }
+  return (NSInteger)count;
+}
+
+size_t GMSPolylineCodecMaxEncodedLength(NSUInteger count) { return count * 2 * kMaxBytesPerValue; }
+
+static size_t EncodeValue(int32_t value, char *buffer) {
+  uint32_t zigzag = value < 0 ? ~((uint32_t)value << 1) : (uint32_t)value << 1;
+  size_t length = 0;
+  while (zigzag >= kContinuationBit) {
+    buffer[length++] = (char)((kContinuationBit | (zigzag & 0x1f)) + kChunkOffset);
+    zigzag >>= 5;
+  }
+  buffer[length++] = (char)(zigzag + kChunkOffset);
+  return length;
+}
+
+size_t GMSPolylineCodecEncode(const double *latitudes, const double *longitudes, NSUInteger count,
+                              char *buffer, size_t capacity) {
+  int32_t previousLatitude = 0;
+  int32_t previousLongitude = 0;
+  size_t length = 0;
+  for (NSUInteger i = 0; i < count; i++) {
+    if (capacity - length < 2 * kMaxBytesPerValue) {
+      return 0;
+    }
+    int32_t latitude = (int32_t)lround(latitudes[i] * kCoordinateFactor);
+    int32_t longitude = (int32_t)lround(longitudes[i] * kCoordinateFactor);
+    length += EncodeValue(latitude - previousLatitude, buffer + length);
+    length += EncodeValue(longitude - previousLongitude, buffer + length);
+    previousLatitude = latitude;
+    previousLongitude = longitude;
+  }
+  return length;
+}
+
+NSString *GMSPolylineCodecEncodePath(GMSPath *path) {
+  NSUInteger count = path.count;
+  NSMutableData *latitudes = [NSMutableData dataWithLength:count * sizeof(double)];
+  NSMutableData *longitudes = [NSMutableData dataWithLength:count * sizeof(double)];
+  double *latitudeValues = latitudes.mutableBytes;
+  double *longitudeValues = longitudes.mutableBytes;
+  for (NSUInteger i = 0; i < count; i++) {
+    CLLocationCoordinate2D coordinate = [path coordinateAtIndex:i];
+    latitudeValues[i] = coordinate.latitude;
+    longitudeValues[i] = coordinate.longitude;
+  }
+  NSMutableData *buffer = [NSMutableData dataWithLength:GMSPolylineCodecMaxEncodedLength(count)];
+  size_t length = GMSPolylineCodecEncode(latitudeValues, longitudeValues, count,
+                                         buffer.mutableBytes, buffer.length);
+  return [[NSString alloc] initWithBytes:buffer.bytes
+                                  length:length
+                                encoding:NSASCIIStringEncoding];
+}
+
+@implementation GMSDecodedPolylines {
+  NSMutableData *_latitudes;
+  NSMutableData *_longitudes;
+  // Start offset of each polyline, followed by the total coordinate count.
+  NSMutableData *_offsets;
+}
+
++ (nullable instancetype)polylinesByDecodingStrings:(NSArray<NSString *> *)encodedPaths {
+  NSUInteger count = encodedPaths.count;
+  NSMutableData *offsets = [NSMutableData dataWithLength:(count + 1) * sizeof(NSUInteger)];
+  NSUInteger *offsetValues = offsets.mutableBytes;
+  NSUInteger total = 0;
+  for (NSUInteger i = 0; i < count; i++) {
+    const char *encoded = encodedPaths[i].UTF8String;
+    offsetValues[i] = total;
+    total += GMSPolylineCodecCountCoordinates(encoded, strlen(encoded));
+  }
+  offsetValues[count] = total;
+
+  NSMutableData *latitudes = [NSMutableData dataWithLength:total * sizeof(double)];
+  NSMutableData *longitudes = [NSMutableData dataWithLength:total * sizeof(double)];
+  double *latitudeValues = latitudes.mutableBytes;
+  double *longitudeValues = longitudes.mutableBytes;
+  for (NSUInteger i = 0; i < count; i++) {
+    const char *encoded = encodedPaths[i].UTF8String;
+    NSUInteger start = offsetValues[i];
+    NSUInteger capacity = offsetValues[i + 1] - start;
+    NSInteger decoded = GMSPolylineCodecDecode(encoded, strlen(encoded), latitudeValues + start,
+                                               longitudeValues + start, capacity);
+    if (decoded != (NSInteger)capacity) {
+      return nil;
+    }
+  }
+  return [[self alloc] initWithLatitudes:latitudes longitudes:longitudes offsets:offsets];
+}
+
+- (instancetype)initWithLatitudes:(NSMutableData *)latitudes
+                       longitudes:(NSMutableData *)longitudes
+                          offsets:(NSMutableData *)offsets {
+  if ((self = [super init])) {
+    _latitudes = latitudes;
+    _longitudes = longitudes;
+    _offsets = offsets;
+  }
+  return self;
+}
+
+- (NSUInteger)count {
+  return _offsets.length / sizeof(NSUInteger) - 1;
+}
+
+- (NSUInteger)coordinateCount {
+  return _latitudes.length / sizeof(double);
+}
+
+- (const double *)latitudes {
+  return _latitudes.bytes;
+}
+
+- (const double *)longitudes {
+  return _longitudes.bytes;
+}
+
+- (NSRange)coordinateRangeAtIndex:(NSUInteger)index {
+  const NSUInteger *offsets = _offsets.bytes;
+  return NSMakeRange(offsets[index], offsets[index + 1] - offsets[index]);
+}
+
+- (GMSPath *)pathAtIndex:(NSUInteger)index {
+  NSRange range = [self coordinateRangeAtIndex:index];
+  const double *latitudes = self.latitudes;
+  const double *longitudes = self.longitudes;
+  GMSMutablePath *path = [GMSMutablePath path];
+  for (NSUInteger i = range.location; i < NSMaxRange(range); i++) {
+    [path addLatitude:latitudes[i] longitude:longitudes[i]];
+  }
+  return path;
+}
+
+@end
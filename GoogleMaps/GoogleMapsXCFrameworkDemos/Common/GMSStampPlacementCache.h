@@ -0,0 +1,71 @@
+/*
+ * Copyright 2026 Google LLC. All rights reserved.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#import <CoreGraphics/CoreGraphics.h>
+#import <Foundation/Foundation.h>
+
+@class GMSPath;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** Where stamps land along a path for one zoom bucket. */
+@interface GMSStampPlacement : NSObject
+
+/** The integer zoom level the placement was computed for. */
+@property(nonatomic, readonly) NSUInteger zoomBucket;
+
+/** Number of stamps. */
+@property(nonatomic, readonly) NSUInteger count;
+
+/** Latitude of each stamp. */
+@property(nonatomic, readonly) const double *latitudes NS_RETURNS_INNER_POINTER;
+
+/** Longitude of each stamp. */
+@property(nonatomic, readonly) const double *longitudes NS_RETURNS_INNER_POINTER;
+
+/** Direction of the path at each stamp, in degrees clockwise from north. */
+@property(nonatomic, readonly) const double *headings NS_RETURNS_INNER_POINTER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+/**
+ * Computes and caches stamp positions along a path, spaced a fixed number of screen points apart.
+ *
+ * The path is projected to Web Mercator and measured once. A placement is computed the first time
+ * each integer zoom level is asked for and reused afterwards, so panning and fractional zoom
+ * changes never recompute it. Within a bucket the spacing is exact at the bucket's zoom level and
+ * grows towards twice the spacing as the camera zooms in to the next level.
+ */
+@interface GMSStampPlacementCache : NSObject
+
+/** Distance between consecutive stamps, in screen points. */
+@property(nonatomic, readonly) CGFloat spacing;
+
+/**
+ * Creates a cache for stamps along |path|. The first stamp sits half the spacing in from the
+ * start, and segments follow straight lines on the map, as non-geodesic polylines do.
+ */
+- (instancetype)initWithPath:(GMSPath *)path spacing:(CGFloat)spacing NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/** Returns the placement for the zoom bucket containing |zoom|. */
+- (GMSStampPlacement *)placementForZoom:(float)zoom;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2026 Google LLC. All rights reserved.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#import "GoogleMapsXCFrameworkDemos/Common/GMSStampPlacementCache.h"
+
+#include <math.h>
+
+#if __has_feature(modules)
+@import GoogleMaps;
+#else
+#import <GoogleMaps/GoogleMaps.h>
+#endif
+
+static const NSUInteger kMaximumZoomBucket = 21;
+
+// Width of the whole world, in points, at zoom level 0.
+static const double kWorldSize = 256;
+
+static const double kMaximumMercatorLatitude = 85.051128779806589;
+
+/** Projects a coordinate onto the unit Web Mercator square. */
+static void ProjectCoordinate(double latitude, double longitude, double *x, double *y) {
+  latitude = fmax(fmin(latitude, kMaximumMercatorLatitude), -kMaximumMercatorLatitude);
+  double sinLatitude = sin(latitude * M_PI / 180);
+  *x = (longitude + 180) / 360;
+  *y = 0.5 - log((1 + sinLatitude) / (1 - sinLatitude)) / (4 * M_PI);
+}
+
+/** Returns the latitude of a point on the unit Web Mercator square. */
+static double UnprojectLatitude(double y) { return atan(sinh(M_PI * (1 - 2 * y))) * 180 / M_PI; }
+
+/**
+ * Places a stamp every |spacing| along the polyline |x|/|y|, whose cumulative lengths are
+ * |distances|, starting half a spacing in. Returns the number of stamps, writing up to |capacity|
+ * of them; call with a zero capacity to size the output.
+ */
+static NSUInteger PlaceStamps(const double *x, const double *y, const double *distances,
+                              NSUInteger count, double spacing, NSUInteger capacity,
+                              double *latitudes, double *longitudes, double *headings) {
+  if (count < 2 || spacing <= 0) {
+    return 0;
+  }
+  NSUInteger stampCount = (NSUInteger)floor(distances[count - 1] / spacing + 0.5);
+  NSUInteger segment = 0;
+  for (NSUInteger i = 0; i < MIN(stampCount, capacity); i++) {
+    double distance = (i + 0.5) * spacing;
+    // Stamps are visited in order, so the segment cursor only moves forward.
+    while (segment < count - 2 && distances[segment + 1] < distance) {
+      segment++;
+    }
+    double dx = x[segment + 1] - x[segment];
+    double dy = y[segment + 1] - y[segment];
+    double length = distances[segment + 1] - distances[segment];
+    double t = length > 0 ? fmin((distance - distances[segment]) / length, 1) : 0;
+    latitudes[i] = UnprojectLatitude(y[segment] + t * dy);
+    longitudes[i] = (x[segment] + t * dx) * 360 - 180;
+    // Mercator y grows southwards, so north is -y.
+    headings[i] = fmod(atan2(dx, -dy) * 180 / M_PI + 360, 360);
+  }
+  return stampCount;
+}
+
+@interface GMSStampPlacement ()
+
+@property(nonatomic, readonly) double *mutableLatitudes NS_RETURNS_INNER_POINTER;
+@property(nonatomic, readonly) double *mutableLongitudes NS_RETURNS_INNER_POINTER;
+@property(nonatomic, readonly) double *mutableHeadings NS_RETURNS_INNER_POINTER;
+
+- (instancetype)initWithZoomBucket:(NSUInteger)zoomBucket count:(NSUInteger)count;
+
+@end
+
+@implementation GMSStampPlacement {
+  NSMutableData *_latitudes;
+  NSMutableData *_longitudes;
+  NSMutableData *_headings;
+}
+
+- (instancetype)initWithZoomBucket:(NSUInteger)zoomBucket count:(NSUInteger)count {
+  if ((self = [super init])) {
+    _zoomBucket = zoomBucket;
+    _count = count;
+    _latitudes = [NSMutableData dataWithLength:count * sizeof(double)];
+    _longitudes = [NSMutableData dataWithLength:count * sizeof(double)];
+    _headings = [NSMutableData dataWithLength:count * sizeof(double)];
+  }
+  return self;
+}
+
+- (const double *)latitudes {
+  return _latitudes.bytes;
+}
+
+- (const double *)longitudes {
+  return _longitudes.bytes;
+}
+
+- (const double *)headings {
+  return _headings.bytes;
+}
+
+- (double *)mutableLatitudes {
+  return _latitudes.mutableBytes;
+}
+
+- (double *)mutableLongitudes {
+  return _longitudes.mutableBytes;
+}
+
+- (double *)mutableHeadings {
+  return _headings.mutableBytes;
+}
+
+@end
+
+@implementation GMSStampPlacementCache {
+  NSUInteger _count;
+  NSMutableData *_x;
+  NSMutableData *_y;
+  // Distance from the start of the path to each vertex, in unit Web Mercator lengths.
+  NSMutableData *_distances;
+  NSMutableDictionary<NSNumber *, GMSStampPlacement *> *_placements;
+}
+
+- (instancetype)initWithPath:(GMSPath *)path spacing:(CGFloat)spacing {
+  if ((self = [super init])) {
+    _spacing = spacing;
+    _count = path.count;
+    _x = [NSMutableData dataWithLength:_count * sizeof(double)];
+    _y = [NSMutableData dataWithLength:_count * sizeof(double)];
+    _distances = [NSMutableData dataWithLength:_count * sizeof(double)];
+    _placements = [NSMutableDictionary dictionary];
+
+    double *x = _x.mutableBytes;
+    double *y = _y.mutableBytes;
+    double *distances = _distances.mutableBytes;
+    for (NSUInteger i = 0; i < _count; i++) {
+      CLLocationCoordinate2D coordinate = [path coordinateAtIndex:i];
+      ProjectCoordinate(coordinate.latitude, coordinate.longitude, &x[i], &y[i]);
+      distances[i] = i == 0 ? 0 : distances[i - 1] + hypot(x[i] - x[i - 1], y[i] - y[i - 1]);
+    }
+  }
+  return self;
+}
+
+- (GMSStampPlacement *)placementForZoom:(float)zoom {
+  NSUInteger zoomBucket = (NSUInteger)fmin(fmax(floor(zoom), 0), kMaximumZoomBucket);
+  GMSStampPlacement *placement = _placements[@(zoomBucket)];
+  if (placement) {
+    return placement;
+  }
+  // One screen point covers 1 / (kWorldSize * 2^zoom) of the unit square.
+  double spacing = _spacing / ldexp(kWorldSize, (int)zoomBucket);
+  const double *x = _x.bytes;
+  const double *y = _y.bytes;
+  const double *distances = _distances.bytes;
+  NSUInteger count = PlaceStamps(x, y, distances, _count, spacing, 0, NULL, NULL, NULL);
+  placement = [[GMSStampPlacement alloc] initWithZoomBucket:zoomBucket count:count];
+  PlaceStamps(x, y, distances, _count, spacing, count, placement.mutableLatitudes,
+              placement.mutableLongitudes, placement.mutableHeadings);
+  _placements[@(zoomBucket)] = placement;
+  return placement;
+}
+
+@end
@@ -15,6 +15,7 @@
 
 #import "GoogleMapsXCFrameworkDemos/Samples/CustomMarkersViewController.h"
 
+#import "GoogleMapsXCFrameworkDemos/Common/GMSCoordinateBox.h"
 #if __has_feature(modules)
 @import GoogleMaps;
 #else
@@ -94,22 +95,18 @@ static CGFloat randf() { return (((float)arc4random() / 0x100000000) * 1.0f); }
 }
 
 - (void)addMarkerInBounds:(GMSCoordinateBounds *)bounds {
-  CLLocationDegrees latitude =
-      bounds.southWest.latitude + randf() * (bounds.northEast.latitude - bounds.southWest.latitude);
-
-  // If the visible region crosses the antimeridian (the right-most point is "smaller" than the
-  // left-most point), adjust the longitude accordingly.
-  BOOL offset = (bounds.northEast.longitude < bounds.southWest.longitude);
-  CLLocationDegrees longitude =
-      bounds.southWest.longitude +
-      randf() * (bounds.northEast.longitude - bounds.southWest.longitude + (offset ? 360 : 0));
-  if (longitude > 180.f) {
-    longitude -= 360.f;
+  GMSCoordinateBox box = GMSCoordinateBoxFromBounds(bounds);
+  if (GMSCoordinateBoxIsEmpty(box)) {
+    return;
   }
+  // GMSCoordinateBoxSample handles visible regions which cross the antimeridian.
+  double latitudeValue = randf();
+  double longitudeValue = randf();
+  CLLocationCoordinate2D position;
+  GMSCoordinateBoxSample(box, &latitudeValue, &longitudeValue, 1, &position.latitude,
+                         &position.longitude);
 
   UIColor *color = [UIColor colorWithHue:randf() saturation:1.f brightness:1.f alpha:1.0f];
-
-  CLLocationCoordinate2D position = CLLocationCoordinate2DMake(latitude, longitude);
   GMSMarker *marker = [GMSMarker markerWithPosition:position];
   marker.title = [NSString stringWithFormat:@"Marker #%d", ++kMarkerCount];
   marker.appearAnimation = kGMSMarkerAnimationPop;
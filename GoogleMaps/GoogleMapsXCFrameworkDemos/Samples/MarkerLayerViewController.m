@@ -15,46 +15,27 @@
 
 #import "GoogleMapsXCFrameworkDemos/Samples/MarkerLayerViewController.h"
 
+#import "GoogleMapsXCFrameworkDemos/Common/GMSPathAnimationScheduler.h"
 #if __has_feature(modules)
 @import GoogleMaps;
 #else
 #import <GoogleMaps/GoogleMaps.h>
 #endif
 
-@interface CoordsList : NSObject
+// Simulated time covered by each animation step, which is also how often the markers move.
+static const NSTimeInterval kTimestep = 1.0 / 30;
 
-@property(nonatomic, readonly, copy) GMSPath *path;
-@property(nonatomic, readonly) NSUInteger target;
-
-- (id)initWithPath:(GMSPath *)path;
-
-- (CLLocationCoordinate2D)next;
-
-@end
-
-@implementation CoordsList
-
-- (id)initWithPath:(GMSPath *)path {
-  if ((self = [super init])) {
-    _path = [path copy];
-    _target = 0;
-  }
-  return self;
-}
-
-- (CLLocationCoordinate2D)next {
-  ++_target;
-  if (_target == _path.count) {
-    _target = 0;
-  }
-  return [_path coordinateAtIndex:_target];
-}
-
-@end
+// Speed of the moving markers, in meters per second.
+static const CLLocationSpeed kSpeed = 50 * 1000;
 
 @implementation MarkerLayerViewController {
   GMSMapView *_mapView;
   GMSMarker *_fadedMarker;
+  GMSPathAnimationScheduler *_scheduler;
+  // Marker |i| follows entity |i| of |_scheduler|.
+  NSMutableArray<GMSMarker *> *_movingMarkers;
+  NSTimer *_timer;
+  CFTimeInterval _lastTickTime;
 }
 
 - (void)viewDidLoad {
@@ -66,6 +47,9 @@
   _mapView.delegate = self;
   self.view = _mapView;
 
+  _scheduler = [[GMSPathAnimationScheduler alloc] initWithTimestep:kTimestep];
+  _movingMarkers = [NSMutableArray array];
+
   GMSMutablePath *coords;
   GMSMarker *marker;
 
@@ -80,8 +64,7 @@
   marker.groundAnchor = CGPointMake(0.5f, 0.5f);
   marker.flat = YES;
   marker.map = _mapView;
-  marker.userData = [[CoordsList alloc] initWithPath:coords];
-  [self animateToNextCoord:marker];
+  [self addMovingMarker:marker alongPath:coords];
 
   // Create a boat that moves around the Baltic Sea.
   coords = [GMSMutablePath path];
@@ -99,36 +82,50 @@
   marker = [GMSMarker markerWithPosition:[coords coordinateAtIndex:0]];
   marker.icon = [UIImage imageNamed:@"boat"];
   marker.map = _mapView;
-  marker.userData = [[CoordsList alloc] initWithPath:coords];
-  [self animateToNextCoord:marker];
+  [self addMovingMarker:marker alongPath:coords];
+}
+
+- (void)viewDidAppear:(BOOL)animated {
+  [super viewDidAppear:animated];
+  _lastTickTime = CACurrentMediaTime();
+  _timer = [NSTimer scheduledTimerWithTimeInterval:kTimestep
+                                            target:self
+                                          selector:@selector(tick:)
+                                          userInfo:nil
+                                           repeats:YES];
 }
 
-- (void)animateToNextCoord:(GMSMarker *)marker {
-  CoordsList *coords = marker.userData;
-  CLLocationCoordinate2D coord = [coords next];
-  CLLocationCoordinate2D previous = marker.position;
+- (void)viewDidDisappear:(BOOL)animated {
+  [super viewDidDisappear:animated];
+  [_timer invalidate];
+}
 
-  CLLocationDirection heading = GMSGeometryHeading(previous, coord);
-  CLLocationDistance distance = GMSGeometryDistance(previous, coord);
+- (void)addMovingMarker:(GMSMarker *)marker alongPath:(GMSPath *)path {
+  [_scheduler addEntityWithPath:path speed:kSpeed];
+  [_movingMarkers addObject:marker];
+}
 
-  // If this marker is flat, implicitly trigger a change in rotation, which will finish quickly.
-  if (marker.flat) {
-    marker.rotation = heading;
+- (void)tick:(NSTimer *)timer {
+  CFTimeInterval now = CACurrentMediaTime();
+  NSUInteger steps = [_scheduler advanceByTime:now - _lastTickTime];
+  _lastTickTime = now;
+  if (steps == 0) {
+    return;
   }
 
-  // Use CATransaction to set a custom duration for this animation. By default, changes to the
-  // position are already animated, but with a very short default duration. When the animation is
-  // complete, trigger another animation step.
+  // Apply every marker's update in a single transaction, animated over one step so the markers
+  // glide between positions instead of jumping.
+  const double *latitudes = _scheduler.latitudes;
+  const double *longitudes = _scheduler.longitudes;
+  const double *headings = _scheduler.headings;
   [CATransaction begin];
-  [CATransaction setAnimationDuration:(distance / (50 * 1000))];  // custom duration, 50km/sec
-
-  __weak MarkerLayerViewController *weakSelf = self;
-  [CATransaction setCompletionBlock:^{
-    [weakSelf animateToNextCoord:marker];
+  [CATransaction setAnimationDuration:kTimestep];
+  [_movingMarkers enumerateObjectsUsingBlock:^(GMSMarker *marker, NSUInteger idx, BOOL *stop) {
+    marker.position = CLLocationCoordinate2DMake(latitudes[idx], longitudes[idx]);
+    if (marker.flat) {
+      marker.rotation = headings[idx];
+    }
   }];
-
-  marker.position = coord;
-
   [CATransaction commit];
 }
 
@@ -15,6 +15,8 @@
 
 #import "GoogleMapsXCFrameworkDemos/Samples/StampedPolylinesViewController.h"
 
+#import "GoogleMapsXCFrameworkDemos/Common/GMSPolylineCodec.h"
+#import "GoogleMapsXCFrameworkDemos/Common/GMSStampPlacementCache.h"
 #if __has_feature(modules)
 @import GoogleMaps;
 #else
@@ -27,6 +29,8 @@ static const double kSeattleLatitudeDegrees = 47.6089945;
 static const double kSeattleLongitudeDegrees = -122.3410462;
 static const double kZoom = 14;
 static const double kStrokeWidth = 20;
+// Screen distance between the direction arrows drawn along the walking route.
+static const CGFloat kArrowSpacing = 96;
 
 /**
  * The following encoded path was constructed by using the Directions API.
@@ -41,7 +45,14 @@ static NSString *const kEncodedPathForWalkingDirections =
     @"eA`@o@|@iBCCRa@DD^aAf@{@`@}@Xc@GIVc@DDj@iANe@x@cBHUACRYNPZQHLDFDCVSB?CGKYHGr@s@r@g@v@o@"
     @"GUVSBC@FDJJK";
 
-@implementation StampedPolylinesViewController
+@interface StampedPolylinesViewController () <GMSMapViewDelegate>
+@end
+
+@implementation StampedPolylinesViewController {
+  GMSStampPlacementCache *_Nullable _arrowPlacements;
+  GMSStampPlacement *_Nullable _arrowPlacement;
+  NSMutableArray<GMSMarker *> *_Nullable _arrowMarkers;
+}
 
 - (void)viewDidLoad {
   [super viewDidLoad];
@@ -54,11 +65,61 @@ static NSString *const kEncodedPathForWalkingDirections =
   // Opt the MapView in automatic dark mode switching.
   map.overrideUserInterfaceStyle = UIUserInterfaceStyleUnspecified;
   map.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
+  map.delegate = self;
   [self.view addSubview:map];
 
   [self addTextureStampedPolylineToMap:map];
   [self addGradientTextureStampedPolylineToMap:map];
   [self addSpriteWalkingDotStampedPolylineToMap:map];
+  [self updateArrowsForMap:map];
+}
+
+#pragma mark - GMSMapViewDelegate
+
+- (void)mapView:(GMSMapView *)mapView didChangeCameraPosition:(GMSCameraPosition *)position {
+  [self updateArrowsForMap:mapView];
+}
+
+#pragma mark - Private
+
+/**
+ * Places direction arrows along the walking route. Placements are cached per zoom bucket, so
+ * markers only move when the camera crosses an integer zoom level.
+ *
+ * @param map The map the arrows are shown on.
+ */
+- (void)updateArrowsForMap:(GMSMapView *)map {
+  if (!_arrowPlacements) {
+    return;
+  }
+  GMSStampPlacement *placement = [_arrowPlacements placementForZoom:map.camera.zoom];
+  if (placement == _arrowPlacement) {
+    return;
+  }
+  _arrowPlacement = placement;
+
+  // Reuse the markers already on the map, adding or removing only the difference.
+  UIImage *arrow = [UIImage imageNamed:@"arrow"];
+  while (_arrowMarkers.count < placement.count) {
+    GMSMarker *marker = [[GMSMarker alloc] init];
+    marker.icon = arrow;
+    marker.flat = YES;
+    marker.groundAnchor = CGPointMake(0.5, 0.5);
+    marker.zIndex = 2;
+    marker.map = map;
+    [_arrowMarkers addObject:marker];
+  }
+  while (_arrowMarkers.count > placement.count) {
+    _arrowMarkers.lastObject.map = nil;
+    [_arrowMarkers removeLastObject];
+  }
+  for (NSUInteger i = 0; i < placement.count; i++) {
+    GMSMarker *marker = _arrowMarkers[i];
+    marker.position =
+        CLLocationCoordinate2DMake(placement.latitudes[i], placement.longitudes[i]);
+    // The arrow image points south.
+    marker.rotation = placement.headings[i] + 180;
+  }
 }
 
 /**
@@ -112,7 +173,14 @@ static NSString *const kEncodedPathForWalkingDirections =
  * @param map The map to add the polyline to.
  */
 - (void)addSpriteWalkingDotStampedPolylineToMap:(GMSMapView *)map {
-  GMSPath *path = [GMSPath pathFromEncodedPath:kEncodedPathForWalkingDirections];
+  // Routes arrive as encoded strings, often many at once; decode them in a single batch into flat
+  // coordinate buffers rather than one coordinate object at a time.
+  GMSDecodedPolylines *routes =
+      [GMSDecodedPolylines polylinesByDecodingStrings:@[ kEncodedPathForWalkingDirections ]];
+  if (!routes) {
+    return;
+  }
+  GMSPath *path = [routes pathAtIndex:0];
 
   UIImage *_Nonnull stamp = (UIImage *_Nonnull)[UIImage imageNamed:@"walking_dot.png"];
   GMSStrokeStyle *stroke = [GMSStrokeStyle solidColor:[UIColor redColor]];
@@ -121,6 +189,9 @@ static NSString *const kEncodedPathForWalkingDirections =
   polyline.map = map;
   polyline.strokeWidth = kStrokeWidth;
   polyline.spans = @[ [GMSStyleSpan spanWithStyle:stroke] ];
+
+  _arrowPlacements = [[GMSStampPlacementCache alloc] initWithPath:path spacing:kArrowSpacing];
+  _arrowMarkers = [NSMutableArray array];
 }
 
 @end
@@ -27,53 +27,30 @@ static NSString *const kGrayscaleType = @"Grayscale";
 static NSString *const kNightType = @"Night";
 static NSString *const kNoPOIsType = @"No business points of interest, no transit";
 
+// The bundle resource holding each type's style. The styles are checked and compacted when the
+// app is built, by compile_map_styles.py.
+static NSDictionary<NSString *, NSString *> *StyleResources(void) {
+  return @{
+    kRetroType : @"mapstyle-retro",
+    kGrayscaleType : @"mapstyle-silver",
+    kNightType : @"mapstyle-night",
+    kNoPOIsType : @"mapstyle-no-pois",
+  };
+}
+
 @implementation StyledMapViewController {
   UIBarButtonItem *_barButtonItem;
   GMSMapView *_mapView;
-  GMSMapStyle *_retroStyle;
-  GMSMapStyle *_grayscaleStyle;
-  GMSMapStyle *_nightStyle;
-  GMSMapStyle *_noPOIsStyle;
+
+  // The styles selected so far, by type. A style is only read once it is first selected, so that
+  // loading the view does not read every style.
+  NSMutableDictionary<NSString *, GMSMapStyle *> *_styles;
 }
 
 - (void)viewDidLoad {
   [super viewDidLoad];
 
-  // Error handling is skipped here for brevity, however it is recommended that you look at the
-  // error returned from |styleWithContentsOfFileURL:error:| if it returns nil. This error will
-  // provide information on why your style was not able to be loaded.
-
-  NSURL *retroURL = [[NSBundle mainBundle] URLForResource:@"mapstyle-retro" withExtension:@"json"];
-  _retroStyle = [GMSMapStyle styleWithContentsOfFileURL:retroURL error:NULL];
-
-  NSURL *grayscaleURL = [[NSBundle mainBundle] URLForResource:@"mapstyle-silver"
-                                                withExtension:@"json"];
-  _grayscaleStyle = [GMSMapStyle styleWithContentsOfFileURL:grayscaleURL error:NULL];
-
-  NSURL *nightURL = [[NSBundle mainBundle] URLForResource:@"mapstyle-night" withExtension:@"json"];
-  _nightStyle = [GMSMapStyle styleWithContentsOfFileURL:nightURL error:NULL];
-
-  NSString *noPOIsString = @" [\n"
-                            "  {\n"
-                            "  \"featureType\": \"poi.business\",\n"
-                            "  \"elementType\": \"all\",\n"
-                            "  \"stylers\": [\n"
-                            "              {\n"
-                            "              \"visibility\": \"off\"\n"
-                            "              }\n"
-                            "              ]\n"
-                            "  },\n"
-                            "  {\n"
-                            "  \"featureType\": \"transit\",\n"
-                            "  \"elementType\": \"all\",\n"
-                            "  \"stylers\": [\n"
-                            "              {\n"
-                            "              \"visibility\": \"off\"\n"
-                            "              }\n"
-                            "              ]\n"
-                            "  }\n"
-                            "  ]";
-  _noPOIsStyle = [GMSMapStyle styleWithJSONString:noPOIsString error:NULL];
+  _styles = [NSMutableDictionary dictionary];
 
   GMSCameraPosition *camera = [GMSCameraPosition cameraWithLatitude:-33.868
                                                           longitude:151.2086
@@ -84,7 +61,7 @@ static NSString *const kNoPOIsType = @"No business points of interest, no transi
   _mapView.overrideUserInterfaceStyle = UIUserInterfaceStyleUnspecified;
   self.view = _mapView;
 
-  _mapView.mapStyle = _retroStyle;
+  _mapView.mapStyle = [self styleForType:kRetroType];
 
   UIBarButtonItem *styleButton = [[UIBarButtonItem alloc] initWithTitle:@"Style"
                                                                   style:UIBarButtonItemStylePlain
@@ -94,15 +71,29 @@ static NSString *const kNoPOIsType = @"No business points of interest, no transi
   self.navigationItem.title = kRetroType;
 }
 
-- (UIAlertAction *_Nonnull)actionWithTitle:(nonnull NSString *)title
-                                     style:(nullable GMSMapStyle *)style {
+/** Returns the style for |type|, reading it the first time it is asked for, or nil for none. */
+- (nullable GMSMapStyle *)styleForType:(nonnull NSString *)type {
+  GMSMapStyle *style = _styles[type];
+  NSString *resource = StyleResources()[type];
+  if (!style && resource) {
+    // Error handling is skipped here for brevity, however it is recommended that you look at the
+    // error returned from |styleWithContentsOfFileURL:error:| if it returns nil. This error will
+    // provide information on why your style was not able to be loaded.
+    NSURL *url = [[NSBundle mainBundle] URLForResource:resource withExtension:@"json"];
+    style = [GMSMapStyle styleWithContentsOfFileURL:url error:NULL];
+    _styles[type] = style;
+  }
+  return style;
+}
+
+- (UIAlertAction *_Nonnull)actionWithTitle:(nonnull NSString *)title {
   __weak __typeof__(self) weakSelf = self;
   return [UIAlertAction actionWithTitle:title
                                   style:UIAlertActionStyleDefault
                                 handler:^(UIAlertAction *_Nonnull action) {
                                   __strong __typeof__(self) strongSelf = weakSelf;
                                   if (strongSelf) {
-                                    strongSelf->_mapView.mapStyle = style;
+                                    strongSelf->_mapView.mapStyle = [strongSelf styleForType:title];
                                     strongSelf.navigationItem.title = title;
                                   }
                                 }];
@@ -113,11 +104,11 @@ static NSString *const kNoPOIsType = @"No business points of interest, no transi
       [UIAlertController alertControllerWithTitle:@"Select map style"
                                           message:nil
                                    preferredStyle:UIAlertControllerStyleActionSheet];
-  [alert addAction:[self actionWithTitle:kRetroType style:_retroStyle]];
-  [alert addAction:[self actionWithTitle:kGrayscaleType style:_grayscaleStyle]];
-  [alert addAction:[self actionWithTitle:kNightType style:_nightStyle]];
-  [alert addAction:[self actionWithTitle:kNormalType style:nil]];
-  [alert addAction:[self actionWithTitle:kNoPOIsType style:_noPOIsStyle]];
+  [alert addAction:[self actionWithTitle:kRetroType]];
+  [alert addAction:[self actionWithTitle:kGrayscaleType]];
+  [alert addAction:[self actionWithTitle:kNightType]];
+  [alert addAction:[self actionWithTitle:kNormalType]];
+  [alert addAction:[self actionWithTitle:kNoPOIsType]];
   [alert addAction:[UIAlertAction actionWithTitle:@"Cancel"
                                             style:UIAlertActionStyleCancel
                                           handler:nil]];
@@ -0,0 +1,186 @@
+/* Copyright (c) 2026 Google Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+import CoreText
+import UIKit
+import GoogleMapsUtils
+
+/// A cluster icon generator that draws each bucket's icon once, instead of drawing a new image
+/// every time a cluster is shown
+///
+/// Like GMUDefaultClusterIconGenerator, clusters at least as large as a bucket show that bucket's
+/// label ("10+", "50+", ...), and smaller clusters show their exact count. The bucket icons are
+/// drawn together into one atlas on first use and handed out as views into it; exact-count icons
+/// are kept in a small least-recently-used cache. Drawing uses an off-screen bitmap and Core Text,
+/// so it needs no UIKit graphics context.
+class ClusterIconAtlas: NSObject, GMUClusterIconGenerator {
+
+    /// Diameter of the smallest icon in points; each bucket after the first adds diameterStep
+    private static let baseDiameter: CGFloat = 30
+    private static let diameterStep: CGFloat = 4
+
+    /// Exact-count icons kept before the least recently used is dropped
+    private static let exactIconCapacity = 64
+
+    private let buckets: [UInt]
+    private let backgroundColors: [UIColor]
+    private let scale: CGFloat
+
+    /// Each bucket's icon, all views into one atlas image
+    private lazy var bucketIcons: [UIImage] = drawAtlas()
+
+    /// Exact-count icons by count, and their counts from least to most recently used
+    private var exactIcons = [UInt: UIImage]()
+    private var exactIconOrder = [UInt]()
+
+    /// The constructor; the defaults match GMUDefaultClusterIconGenerator
+    ///
+    /// - Parameters:
+    ///   - buckets: The ascending cluster sizes that get their own icon.
+    ///   - backgroundColors: One colour for each bucket; smaller clusters use the first.
+    ///   - scale: The number of pixels per point.
+    init(
+        buckets: [UInt] = [10, 50, 100, 200, 1000],
+        backgroundColors: [UIColor] = [
+            UIColor(red: 0x00 / 255, green: 0x99 / 255, blue: 0xCC / 255, alpha: 1),
+            UIColor(red: 0x66 / 255, green: 0x99 / 255, blue: 0x00 / 255, alpha: 1),
+            UIColor(red: 0xFF / 255, green: 0x88 / 255, blue: 0x00 / 255, alpha: 1),
+            UIColor(red: 0xCC / 255, green: 0x00 / 255, blue: 0x00 / 255, alpha: 1),
+            UIColor(red: 0x99 / 255, green: 0x33 / 255, blue: 0xCC / 255, alpha: 1),
+        ],
+        scale: CGFloat = UIScreen.main.scale
+    ) {
+        precondition(!buckets.isEmpty && buckets.count == backgroundColors.count)
+        self.buckets = buckets
+        self.backgroundColors = backgroundColors
+        self.scale = scale
+    }
+
+    // MARK: GMUClusterIconGenerator
+
+    func icon(forSize size: UInt) -> UIImage {
+        if let bucket = buckets.lastIndex(where: { size >= $0 }) {
+            return bucketIcons[bucket]
+        }
+        if let icon = exactIcons[size] {
+            exactIconOrder.removeAll { $0 == size }
+            exactIconOrder.append(size)
+            return icon
+        }
+        let pixels = Int((ClusterIconAtlas.baseDiameter * scale).rounded(.up))
+        let context = ClusterIconAtlas.bitmapContext(width: pixels, height: pixels)
+        ClusterIconAtlas.drawIcon(
+            in: context,
+            rect: CGRect(x: 0, y: 0, width: pixels, height: pixels),
+            color: backgroundColors[0],
+            label: "\(size)"
+        )
+        let icon = UIImage(cgImage: context.makeImage()!, scale: scale, orientation: .up)
+        if exactIconOrder.count == ClusterIconAtlas.exactIconCapacity {
+            exactIcons[exactIconOrder.removeFirst()] = nil
+        }
+        exactIcons[size] = icon
+        exactIconOrder.append(size)
+        return icon
+    }
+
+    // MARK: Private
+
+    /// Draws every bucket's icon side by side into one image, then cuts out a view of each
+    private func drawAtlas() -> [UIImage] {
+        var frames = [CGRect]()
+        var atlasWidth: CGFloat = 0
+        for index in buckets.indices {
+            let diameter = ClusterIconAtlas.baseDiameter
+                + CGFloat(index) * ClusterIconAtlas.diameterStep
+            let pixels = (diameter * scale).rounded(.up)
+            frames.append(CGRect(x: atlasWidth, y: 0, width: pixels, height: pixels))
+            atlasWidth += pixels
+        }
+        let atlasHeight = frames.map { $0.height }.max() ?? 0
+        let context = ClusterIconAtlas.bitmapContext(
+            width: Int(atlasWidth),
+            height: Int(atlasHeight)
+        )
+        for (index, frame) in frames.enumerated() {
+            ClusterIconAtlas.drawIcon(
+                in: context,
+                rect: frame,
+                color: backgroundColors[index],
+                label: "\(buckets[index])+"
+            )
+        }
+        let atlas = context.makeImage()!
+
+        // The bitmap's origin is at the bottom left and the image's at the top left
+        return frames.map { frame in
+            var rect = frame
+            rect.origin.y = atlasHeight - frame.maxY
+            return UIImage(cgImage: atlas.cropping(to: rect)!, scale: scale, orientation: .up)
+        }
+    }
+
+    /// Returns an empty bitmap context, in pixels
+    private static func bitmapContext(width: Int, height: Int) -> CGContext {
+        return CGContext(
+            data: nil,
+            width: width,
+            height: height,
+            bitsPerComponent: 8,
+            bytesPerRow: 0,
+            space: CGColorSpace(name: CGColorSpace.sRGB)!,
+            bitmapInfo: CGImageAlphaInfo.premultipliedLast.rawValue
+                | CGBitmapInfo.byteOrder32Big.rawValue
+        )!
+    }
+
+    /// Draws a filled circle with a white outline and a centred white label
+    ///
+    /// - Parameters:
+    ///   - context: The bitmap context, in pixels.
+    ///   - rect: The square to draw in.
+    ///   - color: The fill colour.
+    ///   - label: The text to centre in the circle.
+    private static func drawIcon(
+        in context: CGContext,
+        rect: CGRect,
+        color: UIColor,
+        label: String
+    ) {
+        let strokeWidth = 2 * rect.width / baseDiameter
+        let circle = rect.insetBy(dx: strokeWidth / 2, dy: strokeWidth / 2)
+        context.setFillColor(color.cgColor)
+        context.fillEllipse(in: circle)
+        context.setStrokeColor(UIColor.white.cgColor)
+        context.setLineWidth(strokeWidth)
+        context.strokeEllipse(in: circle)
+
+        let font = CTFontCreateUIFontForLanguage(.emphasizedSystem, rect.width * 0.4, nil)!
+        let text = NSAttributedString(string: label, attributes: [
+            NSAttributedString.Key(kCTFontAttributeName as String): font,
+            NSAttributedString.Key(kCTForegroundColorAttributeName as String):
+                UIColor.white.cgColor,
+        ])
+        let line = CTLineCreateWithAttributedString(text)
+        var ascent: CGFloat = 0
+        var descent: CGFloat = 0
+        let width = CGFloat(CTLineGetTypographicBounds(line, &ascent, &descent, nil))
+        context.textPosition = CGPoint(
+            x: rect.midX - width / 2,
+            y: rect.midY - (ascent - descent) / 2
+        )
+        CTLineDraw(line, context)
+    }
+}
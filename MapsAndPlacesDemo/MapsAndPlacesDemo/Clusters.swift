@@ -18,6 +18,8 @@ import GoogleMapsUtils
 import UIKit
 
 class POIItem: NSObject, GMUClusterItem {
+    /// The coordinates of the POIItem; after changing them, pass the item to
+    /// HierarchicalClusterAlgorithm.move(_:) so it is reclustered
     internal var position: CLLocationCoordinate2D
 
     // MARK: Initialization functions
@@ -0,0 +1,537 @@
+/* Copyright (c) 2026 Google Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+import Accelerate
+import UIKit
+import GoogleMaps
+import GoogleMapsUtils
+
+/// Width of a map tile, in pixels
+private let tileSize = 256
+
+/// Spreads the low 32 bits of a value onto the even bits
+private func spreadBits(_ value: UInt64) -> UInt64 {
+    var bits = value & 0xFFFF_FFFF
+    bits = (bits | (bits << 16)) & 0x0000_FFFF_0000_FFFF
+    bits = (bits | (bits << 8)) & 0x00FF_00FF_00FF_00FF
+    bits = (bits | (bits << 4)) & 0x0F0F_0F0F_0F0F_0F0F
+    bits = (bits | (bits << 2)) & 0x3333_3333_3333_3333
+    bits = (bits | (bits << 1)) & 0x5555_5555_5555_5555
+    return bits
+}
+
+/// Gathers the even bits of a value into its low 32 bits
+private func gatherBits(_ value: UInt64) -> UInt64 {
+    var bits = value & 0x5555_5555_5555_5555
+    bits = (bits | (bits >> 1)) & 0x3333_3333_3333_3333
+    bits = (bits | (bits >> 2)) & 0x0F0F_0F0F_0F0F_0F0F
+    bits = (bits | (bits >> 4)) & 0x00FF_00FF_00FF_00FF
+    bits = (bits | (bits >> 8)) & 0x0000_FFFF_0000_FFFF
+    bits = (bits | (bits >> 16)) & 0x0000_0000_FFFF_FFFF
+    return bits
+}
+
+/// Returns the Morton (Z-order) key of a cell, so cells in the same block sort together
+private func mortonKey(x: Int, y: Int) -> UInt64 {
+    return spreadBits(UInt64(x)) | (spreadBits(UInt64(y)) << 1)
+}
+
+/// Rounds a division towards negative infinity
+private func floorDivide(_ value: Int, _ divisor: Int) -> Int {
+    return value >= 0 ? value / divisor : -((divisor - 1 - value) / divisor)
+}
+
+/// Heatmap intensities summed onto a grid of pixels at every zoom, so a tile only reads the cells
+/// under it instead of every point
+///
+/// The grid at each zoom is sparse: only cells with points are kept, sorted by Morton key, so the
+/// cells of one tile lie together and are found by binary search. Each zoom's grid is made by
+/// merging neighbouring cells of the zoom above, and the largest intensity each zoom is scaled by
+/// is worked out at the same time. The pyramid is laid out as one flat buffer, which is written to
+/// the caches directory and mapped back in on later launches, skipping the build entirely.
+final class HeatmapPyramid {
+
+    /// The zoom of the finest grid, the deepest a map can be zoomed, so every point keeps its own
+    /// pixel and its peak stays as bright at every zoom, as with GMUHeatmapTileLayer
+    static let finestZoom = 22
+
+    /// Marks a pyramid file, followed by its layout version
+    private static let magic: UInt32 = 0x4859_504D
+    private static let version: UInt32 = 1
+
+    /// The blur radius in pixels the maximum intensities were taken for
+    let radius: Int
+
+    /// The largest sum of intensities within a cell twice the radius wide, at each zoom
+    let maximumIntensities: [Float]
+
+    /// The header, then each zoom's cell count and maximum, then each zoom's keys and sums
+    private let storage: Data
+
+    /// The number of cells at each zoom, and where its keys and sums start in storage
+    private let counts: [Int]
+    private let keyOffsets: [Int]
+    private let sumOffsets: [Int]
+
+    // MARK: Initialization functions
+
+    /// Maps in a pyramid cached by an earlier launch
+    ///
+    /// - Parameters:
+    ///   - name: The name the pyramid was cached under.
+    ///   - sourceHash: The hash of the data it must have been built from.
+    ///   - radius: The blur radius it must have been built for.
+    /// - Returns: nil if there is no cached pyramid for that data and radius.
+    convenience init?(cacheNamed name: String, sourceHash: UInt64, radius: Int) {
+        guard let url = HeatmapPyramid.cacheURL(named: name),
+            let storage = try? Data(contentsOf: url, options: .alwaysMapped) else {
+            return nil
+        }
+        self.init(storage: storage, sourceHash: sourceHash, radius: radius)
+    }
+
+    /// Builds a pyramid over weighted points
+    ///
+    /// - Parameters:
+    ///   - points: The weighted points.
+    ///   - sourceHash: The hash of the data the points were read from, which a cached copy is
+    ///     checked against.
+    ///   - radius: The blur radius in pixels the maximum intensities are taken for.
+    convenience init(points: [GMUWeightedLatLng], sourceHash: UInt64, radius: Int) {
+        let storage = HeatmapPyramid.layOut(points: points, sourceHash: sourceHash, radius: radius)
+        self.init(storage: storage, sourceHash: sourceHash, radius: radius)!
+    }
+
+    private init?(storage: Data, sourceHash: UInt64, radius: Int) {
+        let levelCount = HeatmapPyramid.finestZoom + 1
+        let headerSize = 24
+        let tableSize = levelCount * 8 + (levelCount * 4 + 7) / 8 * 8
+        guard storage.count >= headerSize + tableSize else { return nil }
+        let header = storage.withUnsafeBytes { bytes in
+            (
+                bytes.load(fromByteOffset: 0, as: UInt32.self),
+                bytes.load(fromByteOffset: 4, as: UInt32.self),
+                bytes.load(fromByteOffset: 8, as: UInt64.self),
+                bytes.load(fromByteOffset: 16, as: UInt32.self),
+                bytes.load(fromByteOffset: 20, as: UInt32.self)
+            )
+        }
+        guard header == (
+            HeatmapPyramid.magic,
+            HeatmapPyramid.version,
+            sourceHash,
+            UInt32(radius),
+            UInt32(levelCount)
+        ) else {
+            return nil
+        }
+        let counts = storage.withUnsafeBytes { bytes in
+            (0..<levelCount).map {
+                Int(bytes.load(fromByteOffset: headerSize + 8 * $0, as: UInt64.self))
+            }
+        }
+        maximumIntensities = storage.withUnsafeBytes { bytes in
+            (0..<levelCount).map {
+                bytes.load(fromByteOffset: headerSize + 8 * levelCount + 4 * $0, as: Float.self)
+            }
+        }
+        var keyOffsets = [Int]()
+        var sumOffsets = [Int]()
+        var offset = headerSize + tableSize
+        for count in counts {
+            keyOffsets.append(offset)
+            sumOffsets.append(offset + 8 * count)
+            offset += 8 * count + (4 * count + 7) / 8 * 8
+        }
+        guard offset == storage.count else { return nil }
+        self.storage = storage
+        self.radius = radius
+        self.counts = counts
+        self.keyOffsets = keyOffsets
+        self.sumOffsets = sumOffsets
+    }
+
+    // MARK: Caching
+
+    /// Returns a 64-bit FNV-1a hash of data, to tell whether a cached pyramid is still current
+    ///
+    /// - Parameter data: The data the pyramid is built from.
+    static func sourceHash(of data: Data) -> UInt64 {
+        return data.reduce(0xCBF2_9CE4_8422_2325) { hash, byte in
+            (hash ^ UInt64(byte)) &* 0x100_0000_01B3
+        }
+    }
+
+    /// Writes the pyramid to the caches directory, to be mapped back in by a later launch
+    ///
+    /// - Parameter name: The name to cache the pyramid under.
+    func writeCache(named name: String) {
+        guard let url = HeatmapPyramid.cacheURL(named: name) else { return }
+        do {
+            try storage.write(to: url, options: .atomic)
+        } catch {
+            print(error.localizedDescription)
+        }
+    }
+
+    private static func cacheURL(named name: String) -> URL? {
+        let directory = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask).first
+        return directory?.appendingPathComponent("\(name).heatmap-pyramid")
+    }
+
+    // MARK: Reading cells
+
+    /// Calls body with each cell of a zoom's grid that lies within a box of cells
+    ///
+    /// - Parameters:
+    ///   - zoom: The zoom of the grid, no deeper than finestZoom.
+    ///   - minX: The west edge of the box, which may lie west of the antimeridian.
+    ///   - minY: The north edge of the box.
+    ///   - maxX: The east edge of the box, which may lie east of the antimeridian.
+    ///   - maxY: The south edge of the box.
+    ///   - body: Takes the cell's column, in the box's frame, its row and its summed intensity.
+    func forEachCell(
+        zoom: Int,
+        minX: Int,
+        minY: Int,
+        maxX: Int,
+        maxY: Int,
+        _ body: (Int, Int, Float) -> Void
+    ) {
+        let side = tileSize << zoom
+        let blocksPerSide = 1 << zoom
+        let count = counts[zoom]
+        guard count > 0, maxY >= 0, minY < side else { return }
+        storage.withUnsafeBytes { bytes in
+            let keys = (bytes.baseAddress! + keyOffsets[zoom]).assumingMemoryBound(to: UInt64.self)
+            let sums = (bytes.baseAddress! + sumOffsets[zoom]).assumingMemoryBound(to: Float.self)
+
+            // Each block of cells a tile wide has its own range of keys
+            for blockY in max(minY, 0) / tileSize...min(maxY, side - 1) / tileSize {
+                for blockX in floorDivide(minX, tileSize)...floorDivide(maxX, tileSize) {
+                    let wrappedX = (blockX % blocksPerSide + blocksPerSide) % blocksPerSide
+                    let worldOffset = (blockX - wrappedX) * tileSize
+                    let firstKey = mortonKey(x: wrappedX, y: blockY) << 16
+                    var low = 0
+                    var high = count
+                    while low < high {
+                        let middle = (low + high) / 2
+                        if keys[middle] < firstKey {
+                            low = middle + 1
+                        } else {
+                            high = middle
+                        }
+                    }
+                    var index = low
+                    while index < count && keys[index] >> 16 == firstKey >> 16 {
+                        let x = Int(gatherBits(keys[index])) + worldOffset
+                        let y = Int(gatherBits(keys[index] >> 1))
+                        if x >= minX && x <= maxX && y >= minY && y <= maxY {
+                            body(x, y, sums[index])
+                        }
+                        index += 1
+                    }
+                }
+            }
+        }
+    }
+
+    // MARK: Building
+
+    /// Sums the points onto the finest grid, then merges each grid into the next coarser one, and
+    /// lays the result out as it is stored
+    private static func layOut(
+        points: [GMUWeightedLatLng],
+        sourceHash: UInt64,
+        radius: Int
+    ) -> Data {
+        let levelCount = finestZoom + 1
+        let side = Double(tileSize << finestZoom)
+        let maximumLatitude = 85.051128779806589
+
+        // The finest grid, merging points that share a cell
+        var cells = points.map { point -> (UInt64, Float) in
+            let coordinate = GMSUnproject(GMSMapPoint(x: point.point().x, y: point.point().y))
+            let latitude = min(max(coordinate.latitude, -maximumLatitude), maximumLatitude)
+            let sinLatitude = sin(latitude * .pi / 180)
+            let x = (coordinate.longitude + 180) / 360
+            let y = 0.5 - log((1 + sinLatitude) / (1 - sinLatitude)) / (4 * .pi)
+            let column = min(max(Int(x * side), 0), Int(side) - 1)
+            let row = min(max(Int(y * side), 0), Int(side) - 1)
+            return (mortonKey(x: column, y: row), point.intensity)
+        }
+        cells.sort { $0.0 < $1.0 }
+        var levels = [[(UInt64, Float)]](repeating: [], count: levelCount)
+        levels[finestZoom] = merge(cells, shift: 0)
+        for zoom in stride(from: finestZoom - 1, through: 0, by: -1) {
+            levels[zoom] = merge(levels[zoom + 1], shift: 2)
+        }
+
+        var storage = Data()
+        func append<T>(_ value: T) {
+            withUnsafeBytes(of: value) { storage.append(contentsOf: $0) }
+        }
+        func pad() {
+            storage.append(contentsOf: [UInt8](repeating: 0, count: (8 - storage.count % 8) % 8))
+        }
+        append(magic)
+        append(version)
+        append(sourceHash)
+        append(UInt32(radius))
+        append(UInt32(levelCount))
+        levels.forEach { append(UInt64($0.count)) }
+        levels.forEach { append(maximumIntensity($0, radius: radius)) }
+        pad()
+        for level in levels {
+            level.forEach { append($0.0) }
+            level.forEach { append($0.1) }
+            pad()
+        }
+        return storage
+    }
+
+    /// Merges sorted cells whose keys match once shifted, keeping them sorted
+    private static func merge(_ cells: [(UInt64, Float)], shift: UInt64) -> [(UInt64, Float)] {
+        var merged = [(UInt64, Float)]()
+        for (key, sum) in cells {
+            let parent = key >> shift
+            if let last = merged.last, last.0 == parent {
+                merged[merged.count - 1].1 += sum
+            } else {
+                merged.append((parent, sum))
+            }
+        }
+        return merged
+    }
+
+    /// Returns the largest sum of intensities within a cell twice the radius wide, matching how
+    /// GMUHeatmapTileLayer scales intensities
+    private static func maximumIntensity(_ cells: [(UInt64, Float)], radius: Int) -> Float {
+        var sums = [UInt64: Float]()
+        for (key, sum) in cells {
+            let x = gatherBits(key) / UInt64(2 * radius)
+            let y = gatherBits(key >> 1) / UInt64(2 * radius)
+            sums[mortonKey(x: Int(x), y: Int(y)), default: 0] += sum
+        }
+        return sums.values.max() ?? 0
+    }
+}
+
+/// A heatmap tile layer that reads a HeatmapPyramid instead of searching the points for each tile
+///
+/// A tile sums the pyramid's cells under it and a border of the blur radius into a grid, blurs the
+/// grid with a Gaussian one axis at a time, and maps the result through the gradient's colours,
+/// all as Accelerate vector operations.
+final class HeatmapPyramidTileLayer: GMSSyncTileLayer {
+
+    /// The pyramid to render, or nil to leave the layer empty
+    var pyramid: HeatmapPyramid? {
+        didSet {
+            update()
+        }
+    }
+
+    /// The gradient intensities are coloured with
+    var gradient = GMUGradient(
+        colors: [UIColor.green, UIColor.red],
+        startPoints: [NSNumber(0.2), NSNumber(1.0)],
+        colorMapSize: 256
+    ) {
+        didSet {
+            update()
+        }
+    }
+
+    /// The zooms whose maximum intensities tiles are scaled by; other zooms use the nearest
+    var minimumZoomIntensity = 5 {
+        didSet {
+            update()
+        }
+    }
+    var maximumZoomIntensity = 10 {
+        didSet {
+            update()
+        }
+    }
+
+    /// What tiles are rendered from, which tiles on other threads read under the lock
+    private let lock = NSLock()
+    private var renderedPyramid: HeatmapPyramid?
+    private var colors = [UInt32](repeating: 0, count: 256)
+    private var zoomIntensityRange = 5...10
+
+    override init() {
+        super.init()
+        update()
+    }
+
+    override func tileFor(x: UInt, y: UInt, zoom: UInt) -> UIImage? {
+        lock.lock()
+        let pyramid = renderedPyramid
+        let colors = self.colors
+        let zoomIntensityRange = self.zoomIntensityRange
+        lock.unlock()
+        guard let heatmap = pyramid else { return kGMSTileLayerNoTile }
+
+        let zoom = Int(zoom)
+        let intensityZoom = min(
+            max(zoom, zoomIntensityRange.lowerBound),
+            zoomIntensityRange.upperBound,
+            HeatmapPyramid.finestZoom
+        )
+        let maximumIntensity = heatmap.maximumIntensities[intensityZoom]
+        guard maximumIntensity > 0 else { return kGMSTileLayerNoTile }
+
+        // The grid covers the tile and a border of the radius, so cells just outside still blur
+        // into it; a tile past the finest zoom, which no map reaches, shares each cell's sum evenly
+        // between the pixels it covers
+        let radius = heatmap.radius
+        let gridSize = tileSize + 2 * radius
+        let level = min(zoom, HeatmapPyramid.finestZoom)
+        let scale = 1 << (zoom - level)
+        let originX = Int(x) * tileSize - radius
+        let originY = Int(y) * tileSize - radius
+        var grid = [Float](repeating: 0, count: gridSize * gridSize)
+        var binned = false
+        heatmap.forEachCell(
+            zoom: level,
+            minX: floorDivide(originX, scale),
+            minY: floorDivide(originY, scale),
+            maxX: floorDivide(originX + gridSize - 1, scale),
+            maxY: floorDivide(originY + gridSize - 1, scale)
+        ) { cellX, cellY, sum in
+            let left = max(cellX * scale - originX, 0)
+            let right = min(cellX * scale + scale - originX, gridSize)
+            let top = max(cellY * scale - originY, 0)
+            let bottom = min(cellY * scale + scale - originY, gridSize)
+            guard left < right && top < bottom else { return }
+            let share = sum / Float(scale * scale)
+            for row in top..<bottom {
+                for column in left..<right {
+                    grid[row * gridSize + column] += share
+                }
+            }
+            binned = true
+        }
+        guard binned else { return kGMSTileLayerNoTile }
+
+        // Matches GMUHeatmapTileLayer, whose kernel spreads a point over three standard deviations
+        let sigma = Float(radius) / 3
+        let kernel = (-radius...radius).map { exp(-Float($0 * $0) / (2 * sigma * sigma)) }
+
+        // Blurs each row of the grid into the tile's columns, then each column into its rows
+        var rowBlur = [Float](repeating: 0, count: gridSize * tileSize)
+        var blur = [Float](repeating: 0, count: tileSize * tileSize)
+        grid.withUnsafeBufferPointer { grid in
+            rowBlur.withUnsafeMutableBufferPointer { rowBlur in
+                for row in 0..<gridSize {
+                    vDSP_conv(
+                        grid.baseAddress! + row * gridSize, 1,
+                        kernel, 1,
+                        rowBlur.baseAddress! + row * tileSize, 1,
+                        vDSP_Length(tileSize),
+                        vDSP_Length(kernel.count)
+                    )
+                }
+            }
+        }
+        rowBlur.withUnsafeBufferPointer { rowBlur in
+            blur.withUnsafeMutableBufferPointer { blur in
+                for row in 0..<tileSize {
+                    let output = blur.baseAddress! + row * tileSize
+                    for (k, weight) in kernel.enumerated() {
+                        var weight = weight
+                        vDSP_vsma(
+                            rowBlur.baseAddress! + (row + k) * tileSize, 1,
+                            &weight,
+                            output, 1,
+                            output, 1,
+                            vDSP_Length(tileSize)
+                        )
+                    }
+                }
+            }
+        }
+
+        // Scales intensities to colour map entries in place, then looks each one up
+        let pixelCount = tileSize * tileSize
+        var scaleToEntries = Float(colors.count - 1) / maximumIntensity
+        var lowest: Float = 0
+        var highest = Float(colors.count - 1)
+        var entries = [UInt8](repeating: 0, count: pixelCount)
+        blur.withUnsafeMutableBufferPointer { blur in
+            let values = blur.baseAddress!
+            vDSP_vsmul(values, 1, &scaleToEntries, values, 1, vDSP_Length(pixelCount))
+            vDSP_vclip(values, 1, &lowest, &highest, values, 1, vDSP_Length(pixelCount))
+            vDSP_vfixu8(values, 1, &entries, 1, vDSP_Length(pixelCount))
+        }
+        let pixels = entries.map { colors[Int($0)] }
+
+        guard let provider = CGDataProvider(
+            data: pixels.withUnsafeBufferPointer { Data(buffer: $0) } as CFData
+        ), let image = CGImage(
+            width: tileSize,
+            height: tileSize,
+            bitsPerComponent: 8,
+            bitsPerPixel: 32,
+            bytesPerRow: tileSize * 4,
+            space: CGColorSpaceCreateDeviceRGB(),
+            bitmapInfo: CGBitmapInfo(
+                rawValue: CGImageAlphaInfo.premultipliedLast.rawValue
+                    | CGBitmapInfo.byteOrder32Big.rawValue
+            ),
+            provider: provider,
+            decode: nil,
+            shouldInterpolate: false,
+            intent: .defaultIntent
+        ) else {
+            return kGMSTileLayerNoTile
+        }
+        return UIImage(cgImage: image)
+    }
+
+    // MARK: Private
+
+    /// Rebuilds the colour table and hands the settings to the tiles, then redraws them
+    private func update() {
+        let colorMap = gradient.generateColorMap()
+        var colors = [UInt32](repeating: 0, count: 256)
+        // Entry 0 stays transparent, so pixels no point reaches are left clear
+        for index in 1..<colors.count where !colorMap.isEmpty {
+            var red: CGFloat = 0
+            var green: CGFloat = 0
+            var blue: CGFloat = 0
+            var alpha: CGFloat = 0
+            colorMap[index * (colorMap.count - 1) / (colors.count - 1)].getRed(
+                &red,
+                green: &green,
+                blue: &blue,
+                alpha: &alpha
+            )
+            // Bytes in memory are red, green, blue and alpha, premultiplied
+            let bytes = [red * alpha, green * alpha, blue * alpha, alpha].map {
+                UInt32(($0 * 255).rounded())
+            }
+            let color = bytes[0] | bytes[1] << 8 | bytes[2] << 16 | bytes[3] << 24
+            colors[index] = color.littleEndian
+        }
+        lock.lock()
+        renderedPyramid = pyramid
+        self.colors = colors
+        zoomIntensityRange = minimumZoomIntensity...max(minimumZoomIntensity, maximumZoomIntensity)
+        lock.unlock()
+        clearTileCache()
+    }
+}
@@ -0,0 +1,878 @@
+/* Copyright (c) 2026 Google Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+import Foundation
+import GoogleMaps
+import GoogleMapsUtils
+
+/// Projects a coordinate onto the unit Web Mercator square
+///
+/// - Parameter coordinate: The coordinate to project.
+/// - Returns: The projected point, with y growing southwards.
+private func project(_ coordinate: CLLocationCoordinate2D) -> (x: Double, y: Double) {
+    let maximumLatitude = 85.051128779806589
+    let latitude = min(max(coordinate.latitude, -maximumLatitude), maximumLatitude)
+    let sinLatitude = sin(latitude * .pi / 180)
+    return (
+        (coordinate.longitude + 180) / 360,
+        0.5 - log((1 + sinLatitude) / (1 - sinLatitude)) / (4 * .pi)
+    )
+}
+
+/// Returns the coordinate of a point on the unit Web Mercator square
+private func unproject(x: Double, y: Double) -> CLLocationCoordinate2D {
+    return CLLocationCoordinate2DMake(atan(sinh(.pi * (1 - 2 * y))) * 180 / .pi, x * 360 - 180)
+}
+
+/// A KD-tree over points on the unit Web Mercator square, kept in two flat arrays
+struct ClusterKDTree {
+
+    /// Ranges this small are scanned instead of split further
+    private static let nodeSize = 64
+
+    /// Each point's x and y, interleaved, in tree order
+    private(set) var coordinates: [Double]
+
+    /// The index reported for each point, in tree order
+    private(set) var indices: [Int]
+
+    /// Builds the tree; the middle point of each range splits it on alternating axes
+    ///
+    /// - Parameters:
+    ///   - coordinates: Each point's x and y, interleaved.
+    ///   - indices: The index to report for each point.
+    init(coordinates: [Double], indices: [Int]) {
+        self.coordinates = coordinates
+        self.indices = indices
+        build(left: 0, right: indices.count - 1, axis: 0)
+    }
+
+    /// Appends the tree positions of the points within a box to found
+    ///
+    /// - Parameters:
+    ///   - minX: The west edge of the box.
+    ///   - minY: The north edge of the box.
+    ///   - maxX: The east edge of the box.
+    ///   - maxY: The south edge of the box.
+    ///   - found: The tree positions found; existing contents are kept.
+    func search(minX: Double, minY: Double, maxX: Double, maxY: Double, into found: inout [Int]) {
+        guard !indices.isEmpty else { return }
+        var stack = [(left: 0, right: indices.count - 1, axis: 0)]
+        while let range = stack.popLast() {
+            if range.right - range.left <= ClusterKDTree.nodeSize {
+                for i in range.left...range.right {
+                    let x = coordinates[2 * i]
+                    let y = coordinates[2 * i + 1]
+                    if x >= minX && x <= maxX && y >= minY && y <= maxY {
+                        found.append(i)
+                    }
+                }
+                continue
+            }
+            let middle = (range.left + range.right) / 2
+            let x = coordinates[2 * middle]
+            let y = coordinates[2 * middle + 1]
+            if x >= minX && x <= maxX && y >= minY && y <= maxY {
+                found.append(middle)
+            }
+            let split = range.axis == 0 ? x : y
+            if (range.axis == 0 ? minX : minY) <= split {
+                stack.append((range.left, middle - 1, 1 - range.axis))
+            }
+            if (range.axis == 0 ? maxX : maxY) >= split {
+                stack.append((middle + 1, range.right, 1 - range.axis))
+            }
+        }
+    }
+
+    private mutating func build(left: Int, right: Int, axis: Int) {
+        guard right - left > ClusterKDTree.nodeSize else { return }
+        let middle = (left + right) / 2
+        select(middle, left: left, right: right, axis: axis)
+        build(left: left, right: middle - 1, axis: 1 - axis)
+        build(left: middle + 1, right: right, axis: 1 - axis)
+    }
+
+    /// Reorders a range so position k holds the value on axis a full sort would put there; this is
+    /// Floyd and Rivest's selection, which narrows large ranges around k by sampling first
+    private mutating func select(_ k: Int, left: Int, right: Int, axis: Int) {
+        var left = left
+        var right = right
+        while right > left {
+            if right - left > 600 {
+                let n = Double(right - left + 1)
+                let m = Double(k - left + 1)
+                let z = log(n)
+                let s = 0.5 * exp(2 * z / 3)
+                let sd = 0.5 * sqrt(z * s * (n - s) / n) * (m - n / 2 < 0 ? -1 : 1)
+                let sampleLeft = max(left, Int(floor(Double(k) - m * s / n + sd)))
+                let sampleRight = min(right, Int(floor(Double(k) + (n - m) * s / n + sd)))
+                select(k, left: sampleLeft, right: sampleRight, axis: axis)
+            }
+            let pivot = coordinates[2 * k + axis]
+            var i = left
+            var j = right
+            swapPoints(left, k)
+            if coordinates[2 * right + axis] > pivot {
+                swapPoints(left, right)
+            }
+            while i < j {
+                swapPoints(i, j)
+                i += 1
+                j -= 1
+                while coordinates[2 * i + axis] < pivot { i += 1 }
+                while coordinates[2 * j + axis] > pivot { j -= 1 }
+            }
+            if coordinates[2 * left + axis] == pivot {
+                swapPoints(left, j)
+            } else {
+                j += 1
+                swapPoints(j, right)
+            }
+            if j <= k { left = j + 1 }
+            if k <= j { right = j - 1 }
+        }
+    }
+
+    private mutating func swapPoints(_ i: Int, _ j: Int) {
+        indices.swapAt(i, j)
+        coordinates.swapAt(2 * i, 2 * j)
+        coordinates.swapAt(2 * i + 1, 2 * j + 1)
+    }
+}
+
+
+/// The clusters at one zoom level, which insertions and removals update in place; the level above
+/// the highest zoom holds the items themselves
+final class ClusterLevel {
+
+    /// Each cluster's position; a cluster with one child sits exactly on it
+    private(set) var positions = [CLLocationCoordinate2D]()
+
+    /// Each cluster's position on the unit Web Mercator square, x and y interleaved
+    private(set) var points = [Double]()
+
+    /// Each cluster's items' positions on the unit Web Mercator square, summed, x and y interleaved
+    var sums = [Double]()
+
+    /// The number of items in each cluster; removed clusters have none
+    var itemCounts = [Int]()
+
+    /// The clusters of the level above merged into each cluster; items have none
+    var children = [[Int]]()
+
+    /// The cluster of the level below that each cluster was merged into, or -1 if there is none
+    var parents = [Int]()
+
+    /// Whether each cluster is in the tree at its current position
+    private var inTree = [Bool]()
+
+    /// Clusters added or moved since the tree was last built, which are searched one by one
+    private var pending = [Int]()
+
+    private var tree = ClusterKDTree(coordinates: [], indices: [])
+
+    var count: Int {
+        return positions.count
+    }
+
+    /// Adds a cluster, which is searched one by one until the tree is next built
+    ///
+    /// - Returns: The index of the new cluster.
+    func append(
+        position: CLLocationCoordinate2D,
+        x: Double,
+        y: Double,
+        itemCount: Int,
+        sumX: Double,
+        sumY: Double,
+        children: [Int]
+    ) -> Int {
+        positions.append(position)
+        points.append(x)
+        points.append(y)
+        sums.append(sumX)
+        sums.append(sumY)
+        itemCounts.append(itemCount)
+        self.children.append(children)
+        parents.append(-1)
+        inTree.append(false)
+        pending.append(count - 1)
+        return count - 1
+    }
+
+    /// Moves a cluster, which is searched one by one until the tree is next built
+    func move(_ index: Int, to position: CLLocationCoordinate2D, x: Double, y: Double) {
+        positions[index] = position
+        guard points[2 * index] != x || points[2 * index + 1] != y else { return }
+        points[2 * index] = x
+        points[2 * index + 1] = y
+        if inTree[index] {
+            inTree[index] = false
+            pending.append(index)
+        }
+    }
+
+    /// Rebuilds the tree over the live clusters' current positions
+    func buildTree() {
+        var coordinates = [Double]()
+        var indices = [Int]()
+        for index in 0..<count where itemCounts[index] > 0 {
+            coordinates.append(points[2 * index])
+            coordinates.append(points[2 * index + 1])
+            indices.append(index)
+        }
+        inTree = itemCounts.map { $0 > 0 }
+        pending.removeAll()
+        tree = ClusterKDTree(coordinates: coordinates, indices: indices)
+    }
+
+    /// Rebuilds the tree once an eighth of the level is pending, which keeps searches close to
+    /// the cost of the tree alone while spreading the rebuild over the changes that caused it
+    func rebuildTreeIfNeeded() {
+        if pending.count > max(64, count / 8) {
+            buildTree()
+        }
+    }
+
+    /// Appends the live clusters whose positions lie within a box to found
+    ///
+    /// - Parameters:
+    ///   - minX: The west edge of the box.
+    ///   - minY: The north edge of the box.
+    ///   - maxX: The east edge of the box.
+    ///   - maxY: The south edge of the box.
+    ///   - found: The cluster indices found; existing contents are kept.
+    func search(minX: Double, minY: Double, maxX: Double, maxY: Double, into found: inout [Int]) {
+        var treePositions = [Int]()
+        tree.search(minX: minX, minY: minY, maxX: maxX, maxY: maxY, into: &treePositions)
+        for treePosition in treePositions {
+            let index = tree.indices[treePosition]
+            if inTree[index] && itemCounts[index] > 0 {
+                found.append(index)
+            }
+        }
+        for index in pending where itemCounts[index] > 0 {
+            let x = points[2 * index]
+            let y = points[2 * index + 1]
+            if x >= minX && x <= maxX && y >= minY && y <= maxY {
+                found.append(index)
+            }
+        }
+    }
+
+    /// Returns the live cluster nearest a point, if one lies within the radius
+    func nearestCluster(x: Double, y: Double, within radius: Double) -> Int? {
+        var found = [Int]()
+        search(minX: x - radius, minY: y - radius, maxX: x + radius, maxY: y + radius, into: &found)
+        var nearest: Int?
+        var nearestDistance = radius * radius
+        for index in found {
+            let dx = points[2 * index] - x
+            let dy = points[2 * index + 1] - y
+            if dx * dx + dy * dy <= nearestDistance {
+                nearest = index
+                nearestDistance = dx * dx + dy * dy
+            }
+        }
+        return nearest
+    }
+}
+
+/// Every zoom level's clusters over one set of items, kept up to date as items are inserted,
+/// removed and moved
+final class ClusterHierarchy {
+
+    /// The item at each index of the last level; removed items stay until the next full build
+    private(set) var items = [GMUClusterItem]()
+
+    /// Level z holds the clusters at zoom z; the last level holds the items
+    private(set) var levels = [ClusterLevel]()
+
+    /// The number of removed items the last level still holds
+    private(set) var removedItemCount = 0
+
+    /// The distance on the unit square within which clusters merge at each zoom
+    private let radii: [Double]
+
+    /// The index of each item in the last level, by item identity
+    private var itemIndices = [ObjectIdentifier: Int]()
+
+    /// The clusters changed at each level since they were last taken
+    private var changedClusters = [Set<Int>]()
+
+    /// Clusters each zoom level by merging the level above it, starting from the items
+    ///
+    /// - Parameters:
+    ///   - items: The items to cluster.
+    ///   - maximumZoom: The zoom level above which items are no longer clustered.
+    ///   - clusterDistance: The distance in screen points within which clusters merge.
+    init(items: [GMUClusterItem], maximumZoom: Int, clusterDistance: Double) {
+        // One screen point covers 1 / (256 * 2^zoom) of the unit square
+        radii = (0...maximumZoom).map { clusterDistance / (256 * pow(2, Double($0))) }
+        self.items = items
+        let itemLevel = ClusterLevel()
+        for item in items {
+            let point = project(item.position)
+            itemIndices[ObjectIdentifier(item)] = itemLevel.append(
+                position: item.position,
+                x: point.x,
+                y: point.y,
+                itemCount: 1,
+                sumX: point.x,
+                sumY: point.y,
+                children: []
+            )
+        }
+        itemLevel.buildTree()
+        levels = [itemLevel]
+        for zoom in stride(from: maximumZoom, through: 0, by: -1) {
+            levels.insert(ClusterHierarchy.merge(levels[0], radius: radii[zoom]), at: 0)
+        }
+        changedClusters = Array(repeating: [], count: levels.count)
+    }
+
+    /// The items that have not been removed
+    var liveItems: [GMUClusterItem] {
+        let itemCounts = levels[levels.count - 1].itemCounts
+        return items.indices.filter { itemCounts[$0] > 0 }.map { items[$0] }
+    }
+
+    /// Adds an item to the nearest cluster within reach at each zoom, starting new clusters at the
+    /// zooms where there is none
+    func insert(_ item: GMUClusterItem) {
+        let point = project(item.position)
+        let itemLevel = levels[levels.count - 1]
+        let index = itemLevel.append(
+            position: item.position,
+            x: point.x,
+            y: point.y,
+            itemCount: 1,
+            sumX: point.x,
+            sumY: point.y,
+            children: []
+        )
+        itemLevel.rebuildTreeIfNeeded()
+        items.append(item)
+        itemIndices[ObjectIdentifier(item)] = index
+        changedClusters[levels.count - 1].insert(index)
+        attach(index, x: point.x, y: point.y)
+    }
+
+    /// Takes an item out of every cluster it was merged into
+    ///
+    /// - Returns: Whether the item was in the hierarchy.
+    @discardableResult
+    func remove(_ item: GMUClusterItem) -> Bool {
+        guard let index = itemIndices.removeValue(forKey: ObjectIdentifier(item)) else {
+            return false
+        }
+        detach(index)
+        removedItemCount += 1
+        return true
+    }
+
+    /// Moves an item whose position has changed from its old clusters to those at its new position
+    ///
+    /// - Returns: Whether the item was in the hierarchy.
+    @discardableResult
+    func move(_ item: GMUClusterItem) -> Bool {
+        guard let index = itemIndices[ObjectIdentifier(item)] else {
+            return false
+        }
+        detach(index)
+        let point = project(item.position)
+        let itemLevel = levels[levels.count - 1]
+        itemLevel.itemCounts[index] = 1
+        itemLevel.sums[2 * index] = point.x
+        itemLevel.sums[2 * index + 1] = point.y
+        itemLevel.move(index, to: item.position, x: point.x, y: point.y)
+        itemLevel.rebuildTreeIfNeeded()
+        attach(index, x: point.x, y: point.y)
+        return true
+    }
+
+    /// Returns the clusters changed at each level since the last call
+    func takeChangedClusters() -> [Set<Int>] {
+        let changed = changedClusters
+        changedClusters = Array(repeating: [], count: levels.count)
+        return changed
+    }
+
+    /// Visits clusters in order; each one not yet merged absorbs every unmerged cluster within the
+    /// radius, and sits at the centroid of their items
+    private static func merge(_ level: ClusterLevel, radius: Double) -> ClusterLevel {
+        let parents = ClusterLevel()
+        var merged = [Bool](repeating: false, count: level.count)
+        var neighbours = [Int]()
+        for index in 0..<level.count {
+            if merged[index] {
+                continue
+            }
+            merged[index] = true
+            let x = level.points[2 * index]
+            let y = level.points[2 * index + 1]
+            var children = [index]
+            var total = level.itemCounts[index]
+            var sumX = level.sums[2 * index]
+            var sumY = level.sums[2 * index + 1]
+
+            neighbours.removeAll(keepingCapacity: true)
+            level.search(
+                minX: x - radius,
+                minY: y - radius,
+                maxX: x + radius,
+                maxY: y + radius,
+                into: &neighbours
+            )
+            for neighbour in neighbours {
+                let dx = level.points[2 * neighbour] - x
+                let dy = level.points[2 * neighbour + 1] - y
+                if merged[neighbour] || dx * dx + dy * dy > radius * radius {
+                    continue
+                }
+                merged[neighbour] = true
+                children.append(neighbour)
+                total += level.itemCounts[neighbour]
+                sumX += level.sums[2 * neighbour]
+                sumY += level.sums[2 * neighbour + 1]
+            }
+
+            // A cluster that merged with nothing keeps its exact position
+            let centroidX = children.count == 1 ? x : sumX / Double(total)
+            let centroidY = children.count == 1 ? y : sumY / Double(total)
+            let parent = parents.append(
+                position: children.count == 1
+                    ? level.positions[index] : unproject(x: centroidX, y: centroidY),
+                x: centroidX,
+                y: centroidY,
+                itemCount: total,
+                sumX: sumX,
+                sumY: sumY,
+                children: children
+            )
+            for child in children {
+                level.parents[child] = parent
+            }
+        }
+        parents.buildTree()
+        return parents
+    }
+
+    /// Joins an item to the nearest cluster within reach, from the highest zoom down, starting a
+    /// new cluster at each zoom where there is none; once it joins a cluster, that cluster and
+    /// every cluster below it gain the item
+    private func attach(_ item: Int, x: Double, y: Double) {
+        var child = item
+        for level in stride(from: levels.count - 2, through: 0, by: -1) {
+            let clusterLevel = levels[level]
+            if let parent = clusterLevel.nearestCluster(x: x, y: y, within: radii[level]) {
+                clusterLevel.children[parent].append(child)
+                levels[level + 1].parents[child] = parent
+                var ancestor = parent
+                var ancestorLevel = level
+                while ancestor >= 0 {
+                    let ancestors = levels[ancestorLevel]
+                    ancestors.itemCounts[ancestor] += 1
+                    ancestors.sums[2 * ancestor] += x
+                    ancestors.sums[2 * ancestor + 1] += y
+                    refresh(ancestor, in: ancestorLevel)
+                    ancestor = ancestors.parents[ancestor]
+                    ancestorLevel -= 1
+                }
+                return
+            }
+            let parent = clusterLevel.append(
+                position: levels[level + 1].positions[child],
+                x: x,
+                y: y,
+                itemCount: 1,
+                sumX: x,
+                sumY: y,
+                children: [child]
+            )
+            levels[level + 1].parents[child] = parent
+            changedClusters[level].insert(parent)
+            clusterLevel.rebuildTreeIfNeeded()
+            child = parent
+        }
+    }
+
+    /// Takes an item out of its clusters, from the highest zoom down; clusters left empty are
+    /// removed from the clusters they were merged into
+    private func detach(_ item: Int) {
+        var level = levels.count - 1
+        var index = item
+        let itemLevel = levels[level]
+        let x = itemLevel.points[2 * index]
+        let y = itemLevel.points[2 * index + 1]
+        itemLevel.itemCounts[index] = 0
+        itemLevel.sums[2 * index] = 0
+        itemLevel.sums[2 * index + 1] = 0
+        changedClusters[level].insert(index)
+        var emptied = true
+        while level > 0 {
+            let parent = levels[level].parents[index]
+            let parentLevel = levels[level - 1]
+            if emptied {
+                parentLevel.children[parent].removeAll { $0 == index }
+                levels[level].parents[index] = -1
+            }
+            parentLevel.itemCounts[parent] -= 1
+            parentLevel.sums[2 * parent] -= x
+            parentLevel.sums[2 * parent + 1] -= y
+            emptied = parentLevel.itemCounts[parent] == 0
+            refresh(parent, in: level - 1)
+            index = parent
+            level -= 1
+        }
+    }
+
+    /// Moves a cluster to the centroid of its items, or onto its child if it has only one
+    private func refresh(_ index: Int, in level: Int) {
+        let clusterLevel = levels[level]
+        changedClusters[level].insert(index)
+        let itemCount = clusterLevel.itemCounts[index]
+        guard itemCount > 0 else { return }
+        let children = clusterLevel.children[index]
+        if children.count == 1 {
+            let childLevel = levels[level + 1]
+            clusterLevel.move(
+                index,
+                to: childLevel.positions[children[0]],
+                x: childLevel.points[2 * children[0]],
+                y: childLevel.points[2 * children[0] + 1]
+            )
+        } else {
+            let x = clusterLevel.sums[2 * index] / Double(itemCount)
+            let y = clusterLevel.sums[2 * index + 1] / Double(itemCount)
+            clusterLevel.move(index, to: unproject(x: x, y: y), x: x, y: y)
+        }
+        clusterLevel.rebuildTreeIfNeeded()
+    }
+}
+
+/// A cluster in a ClusterHierarchy; its items are only gathered when asked for
+final class HierarchicalCluster: NSObject, GMUCluster {
+    let hierarchy: ClusterHierarchy
+    let level: Int
+    let index: Int
+    let position: CLLocationCoordinate2D
+    let count: UInt
+
+    /// Walks down to the items, replacing each cluster with its children one level at a time
+    lazy var items: [GMUClusterItem] = {
+        var clusters = [index]
+        for level in self.level..<(hierarchy.levels.count - 1) {
+            let children = hierarchy.levels[level].children
+            clusters = clusters.flatMap { children[$0] }
+        }
+        return clusters.map { hierarchy.items[$0] }
+    }()
+
+    init(hierarchy: ClusterHierarchy, level: Int, index: Int) {
+        self.hierarchy = hierarchy
+        self.level = level
+        self.index = index
+        position = hierarchy.levels[level].positions[index]
+        count = UInt(hierarchy.levels[level].itemCounts[index])
+    }
+}
+
+/// A cluster algorithm that clusters every zoom level once instead of starting over on each zoom;
+/// the first query builds the hierarchy, after which inserting, removing or moving an item only
+/// updates the clusters it belongs to at each zoom
+class HierarchicalClusterAlgorithm: NSObject, GMUClusterAlgorithm {
+
+    /// A change to the items, staged until the batch it was made in is applied
+    private enum Change {
+        case insert(GMUClusterItem)
+        case remove(GMUClusterItem)
+        case move(GMUClusterItem)
+    }
+
+    /// The zoom level above which items are no longer clustered
+    let maximumZoom: Int
+
+    /// The distance in screen points within which clusters merge
+    let clusterDistance: Double
+
+    /// The items, until the hierarchy is built and takes them over
+    private var items = [GMUClusterItem]()
+    private var hierarchy: ClusterHierarchy?
+
+    /// The live clusters of each level asked for so far, and where each cluster index sits in
+    /// them, or -1 if it is not there
+    private var clustersByLevel = [Int: [GMUCluster]]()
+    private var cachedPositions = [Int: [Int]]()
+
+    /// Changes made inside performBatchUpdates, which are applied when it returns
+    private var stagedChanges: [Change]?
+
+    /// The constructor; the defaults match GMUNonHierarchicalDistanceBasedAlgorithm
+    ///
+    /// - Parameters:
+    ///   - maximumZoom: The zoom level above which items are no longer clustered.
+    ///   - clusterDistance: The distance in screen points within which clusters merge.
+    init(maximumZoom: Int = 20, clusterDistance: Double = 100) {
+        self.maximumZoom = maximumZoom
+        self.clusterDistance = clusterDistance
+    }
+
+    // MARK: GMUClusterAlgorithm
+
+    func add(_ items: [GMUClusterItem]) {
+        performBatchUpdates {
+            items.forEach { stage(.insert($0)) }
+        }
+    }
+
+    func remove(_ item: GMUClusterItem) {
+        stage(.remove(item))
+    }
+
+    func clearItems() {
+        items.removeAll()
+        hierarchy = nil
+        clustersByLevel.removeAll()
+        cachedPositions.removeAll()
+    }
+
+    func clusters(atZoom zoom: Float) -> [GMUCluster] {
+        let level = levelForZoom(zoom)
+        if let clusters = clustersByLevel[level] {
+            return clusters
+        }
+        let hierarchy = builtHierarchy()
+        let clusterLevel = hierarchy.levels[level]
+        var clusters = [GMUCluster]()
+        var positions = [Int](repeating: -1, count: clusterLevel.count)
+        for index in 0..<clusterLevel.count where clusterLevel.itemCounts[index] > 0 {
+            positions[index] = clusters.count
+            clusters.append(HierarchicalCluster(hierarchy: hierarchy, level: level, index: index))
+        }
+        clustersByLevel[level] = clusters
+        cachedPositions[level] = positions
+        return clusters
+    }
+
+    // MARK: Incremental updates
+
+    /// Applies the insertions, removals and moves made in updates together, touching only the
+    /// clusters the changed items belong to; cluster the manager once afterwards to render them
+    ///
+    /// - Parameter updates: Makes the changes; batches made inside it join this one.
+    func performBatchUpdates(_ updates: () -> Void) {
+        if stagedChanges != nil {
+            updates()
+            return
+        }
+        stagedChanges = []
+        updates()
+        let changes = stagedChanges ?? []
+        stagedChanges = nil
+        commit(changes)
+    }
+
+    /// Adds an item
+    ///
+    /// - Parameter item: The item to add.
+    func insert(_ item: GMUClusterItem) {
+        stage(.insert(item))
+    }
+
+    /// Moves an item to the clusters around its new position, once its position has changed
+    ///
+    /// - Parameter item: An item added earlier.
+    func move(_ item: GMUClusterItem) {
+        stage(.move(item))
+    }
+
+    // MARK: Queries
+
+    /// Returns the clusters at a zoom whose positions lie within the bounds
+    ///
+    /// - Parameters:
+    ///   - bounds: The region to search, which may cross the antimeridian.
+    ///   - zoom: The zoom level of the clusters.
+    func clusters(in bounds: GMSCoordinateBounds, zoom: Float) -> [GMUCluster] {
+        let level = levelForZoom(zoom)
+        let hierarchy = builtHierarchy()
+        let clusterLevel = hierarchy.levels[level]
+        let northWest = project(
+            CLLocationCoordinate2DMake(bounds.northEast.latitude, bounds.southWest.longitude)
+        )
+        let southEast = project(
+            CLLocationCoordinate2DMake(bounds.southWest.latitude, bounds.northEast.longitude)
+        )
+
+        // Bounds crossing the antimeridian are searched as two boxes, one either side of it
+        var boxes = [(northWest.x, southEast.x)]
+        if northWest.x > southEast.x {
+            boxes = [(northWest.x, 1), (0, southEast.x)]
+        }
+        var found = [Int]()
+        for box in boxes {
+            clusterLevel.search(
+                minX: box.0,
+                minY: northWest.y,
+                maxX: box.1,
+                maxY: southEast.y,
+                into: &found
+            )
+        }
+        let cached = clustersByLevel[level]
+        let positions = cachedPositions[level]
+        return found.map { index -> GMUCluster in
+            if let cached = cached, let positions = positions, index < positions.count,
+                positions[index] >= 0 {
+                return cached[positions[index]]
+            }
+            return HierarchicalCluster(hierarchy: hierarchy, level: level, index: index)
+        }
+    }
+
+    /// Returns the clusters a cluster splits into as the map zooms in, skipping zoom levels at
+    /// which it stays whole; clusters from an earlier hierarchy, and single items, have none
+    ///
+    /// - Parameter cluster: A cluster returned by this algorithm.
+    func children(of cluster: GMUCluster) -> [GMUCluster] {
+        guard let parent = cluster as? HierarchicalCluster, parent.hierarchy === hierarchy else {
+            return []
+        }
+        let levels = parent.hierarchy.levels
+        var level = parent.level
+        var index = parent.index
+        while level + 1 < levels.count {
+            let children = levels[level].children[index]
+            if children.count > 1 {
+                return children.map {
+                    HierarchicalCluster(hierarchy: parent.hierarchy, level: level + 1, index: $0)
+                }
+            }
+            guard let child = children.first else { return [] }
+            index = child
+            level += 1
+        }
+        return []
+    }
+
+    // MARK: Private
+
+    private func levelForZoom(_ zoom: Float) -> Int {
+        return min(max(Int(floor(zoom)), 0), maximumZoom + 1)
+    }
+
+    private func builtHierarchy() -> ClusterHierarchy {
+        if let hierarchy = hierarchy {
+            return hierarchy
+        }
+        let built = ClusterHierarchy(
+            items: items,
+            maximumZoom: maximumZoom,
+            clusterDistance: clusterDistance
+        )
+        items.removeAll()
+        hierarchy = built
+        return built
+    }
+
+    private func stage(_ change: Change) {
+        if stagedChanges != nil {
+            stagedChanges?.append(change)
+        } else {
+            commit([change])
+        }
+    }
+
+    /// Applies changes to the hierarchy, or to the item list before there is one
+    private func commit(_ changes: [Change]) {
+        guard let hierarchy = hierarchy else {
+            for change in changes {
+                switch change {
+                case .insert(let item):
+                    items.append(item)
+                case .remove(let item):
+                    items.removeAll { $0 === item }
+                case .move:
+                    break
+                }
+            }
+            return
+        }
+        for change in changes {
+            switch change {
+            case .insert(let item):
+                hierarchy.insert(item)
+            case .remove(let item):
+                hierarchy.remove(item)
+            case .move(let item):
+                hierarchy.move(item)
+            }
+        }
+
+        // Removed items and their empty clusters are only dropped by a full build, so start
+        // over once they outnumber the live ones
+        if hierarchy.removedItemCount > hierarchy.items.count / 2 {
+            items = hierarchy.liveItems
+            self.hierarchy = nil
+            clustersByLevel.removeAll()
+            cachedPositions.removeAll()
+            return
+        }
+        updateCachedClusters(hierarchy, changed: hierarchy.takeChangedClusters())
+    }
+
+    /// Replaces, adds and drops the changed clusters in the levels asked for so far
+    private func updateCachedClusters(_ hierarchy: ClusterHierarchy, changed: [Set<Int>]) {
+        for level in Array(clustersByLevel.keys) {
+            guard var clusters = clustersByLevel.removeValue(forKey: level),
+                var positions = cachedPositions.removeValue(forKey: level) else { continue }
+            let clusterLevel = hierarchy.levels[level]
+            if positions.count < clusterLevel.count {
+                positions.append(
+                    contentsOf: repeatElement(-1, count: clusterLevel.count - positions.count)
+                )
+            }
+            for index in changed[level] {
+                let live = clusterLevel.itemCounts[index] > 0
+                let position = positions[index]
+                if live {
+                    let cluster = HierarchicalCluster(
+                        hierarchy: hierarchy,
+                        level: level,
+                        index: index
+                    )
+                    if position >= 0 {
+                        clusters[position] = cluster
+                    } else {
+                        positions[index] = clusters.count
+                        clusters.append(cluster)
+                    }
+                } else if position >= 0 {
+                    // Fill the gap with the last cluster
+                    let last = clusters.removeLast()
+                    if position < clusters.count {
+                        clusters[position] = last
+                        positions[(last as! HierarchicalCluster).index] = position
+                    }
+                    positions[index] = -1
+                }
+            }
+            clustersByLevel[level] = clusters
+            cachedPositions[level] = positions
+        }
+    }
+}
@@ -94,8 +94,9 @@ class GoogleDemoApplicationsMainViewController:
     private var locked = false
     
     /// The heat map,  its data set, and other color setup
-    private let heatMapLayer: GMUHeatmapTileLayer = GMUHeatmapTileLayer()
-    private var heatMapPoints = [GMUWeightedLatLng]()
+    private let heatMapLayer = HeatmapPyramidTileLayer()
+    private var heatMapPyramid: HeatmapPyramid?
+    private let heatMapRadius = 20
     private let gradientColors = [UIColor.green, UIColor.red]
     private let gradientStartheatMapPoints = [NSNumber(0.2), NSNumber(1.0)]
     
@@ -113,6 +114,11 @@ class GoogleDemoApplicationsMainViewController:
     
     /// The cluster manager for the nearby recommendations feature; clusters icons to reduce clutter
     private var clusterManager: GMUClusterManager!
+    private var clusterAlgorithm: HierarchicalClusterAlgorithm!
+    
+    /// The cluster items for the nearby recommendations, by place ID; kept between searches so only
+    /// the places that appear, disappear or move are reclustered
+    private var clusterItems = [String: POIItem]()
     
     /// Indepedent features indicator and properies; may change depending on the device
     private let independentIndicator = UIImageView(image: UIImage(systemName: "1.magnifyingglass"))
@@ -254,11 +260,11 @@ class GoogleDemoApplicationsMainViewController:
                 }
                 self.heatMapToggle = !heatMapTemp
                 if self.heatMapToggle {
-                    self.heatMapLayer.weightedData = self.heatMapPoints
+                    self.heatMapLayer.pyramid = self.heatMapPyramid
                     self.heatMapLayer.map = self.mapView
                     self.zoom = 2
                 } else {
-                    self.heatMapLayer.weightedData = []
+                    self.heatMapLayer.pyramid = nil
                     self.heatMapLayer.map = nil
                 }
                 self.refreshButtons()
@@ -310,25 +316,31 @@ class GoogleDemoApplicationsMainViewController:
     
     /// Setup the cluster manager for the nearby recommendations feature
     private func setUpCluster() {
-        let iconGenerator = GMUDefaultClusterIconGenerator()
-        let algorithm = GMUNonHierarchicalDistanceBasedAlgorithm()
+        let iconGenerator = ClusterIconAtlas()
+        clusterAlgorithm = HierarchicalClusterAlgorithm()
         let renderer = GMUDefaultClusterRenderer(
             mapView: mapView,
             clusterIconGenerator: iconGenerator
         )
-        clusterManager = GMUClusterManager(map: mapView, algorithm: algorithm, renderer: renderer)
+        clusterManager = GMUClusterManager(
+            map: mapView,
+            algorithm: clusterAlgorithm,
+            renderer: renderer
+        )
         clusterManager.setDelegate(self, mapDelegate: self)
         clusterManager.clearItems()
-        for m in nearbyLocationMarkers {
-            clusterManager.add(
-                POIItem(
-                    position: CLLocationCoordinate2DMake(m.position.latitude, m.position.longitude)
-                )
+        clusterItems.removeAll()
+        for (m, id) in zip(nearbyLocationMarkers, nearbyLocationIDs) {
+            let item = POIItem(
+                position: CLLocationCoordinate2DMake(m.position.latitude, m.position.longitude)
             )
+            clusterItems[id] = item
+            clusterManager.add(item)
         }
     }
     
-    /// Parses the dataset and then adds the data to the array; the array is the weighted data for the heatmap
+    /// Loads the heatmap pyramid cached for the dataset; if there is none, parses the dataset, builds
+    /// the pyramid from it, and caches it for the next launch
     private func executeHeatMap() {
         do {
             guard let path = Bundle.main.url(forResource: "dataset", withExtension: "json") else {
@@ -336,11 +348,21 @@ class GoogleDemoApplicationsMainViewController:
                 return
             }
             let data = try Data(contentsOf: path)
+            let sourceHash = HeatmapPyramid.sourceHash(of: data)
+            if let pyramid = HeatmapPyramid(
+                cacheNamed: "dataset",
+                sourceHash: sourceHash,
+                radius: heatMapRadius
+            ) {
+                heatMapPyramid = pyramid
+                return
+            }
             let json = try JSONSerialization.jsonObject(with: data, options: [])
             guard let object = json as? [[String: Any]] else {
                 print("Could not read the JSON file or file is empty")
                 return
             }
+            var heatMapPoints = [GMUWeightedLatLng]()
             for item in object {
                 // Given the way the code parses through the json file, the lat and long can be
                 // retrieved via item like a dictionary
@@ -355,6 +377,13 @@ class GoogleDemoApplicationsMainViewController:
                 )
                 heatMapPoints.append(coords)
             }
+            let pyramid = HeatmapPyramid(
+                points: heatMapPoints,
+                sourceHash: sourceHash,
+                radius: heatMapRadius
+            )
+            pyramid.writeCache(named: "dataset")
+            heatMapPyramid = pyramid
         } catch {
             print(error.localizedDescription)
         }
@@ -393,6 +422,7 @@ class GoogleDemoApplicationsMainViewController:
         nearbyLocationIDs.removeAll()
         overlayController.clear()
         clusterManager.clearItems()
+        clusterItems.removeAll()
         refreshButtons()
     }
     
@@ -402,7 +432,7 @@ class GoogleDemoApplicationsMainViewController:
         indoorToggle = false
         darkModeToggle = false
         heatMapToggle = false
-        heatMapLayer.weightedData = []
+        heatMapLayer.pyramid = nil
         heatMapLayer.map = nil
     }
         
@@ -442,24 +472,43 @@ class GoogleDemoApplicationsMainViewController:
                 self.nearbyLocationImages.append(false)
             }
             
-            // Adds the marker to the cluster manager
-            for locationMarker in self.nearbyLocationMarkers {
-                locationMarker.map = self.mapView
-                self.locationImageController.viewImage(
-                    placeId: self.nearbyLocationIDs[counter],
-                    localMarker: locationMarker,
-                    imageView: UIImageView(),
-                    tapped: false
-                )
-                counter += 1
-                self.clusterManager.add(POIItem(
-                    position: CLLocationCoordinate2DMake(
+            // Shows the markers and brings the cluster manager up to date with the places found;
+            // places still nearby keep their items, so only the ones that appeared, disappeared
+            // or moved are reclustered, and the clusters are rendered once at the end
+            var staleItems = self.clusterItems
+            self.clusterAlgorithm.performBatchUpdates {
+                for locationMarker in self.nearbyLocationMarkers {
+                    locationMarker.map = self.mapView
+                    let placeId = self.nearbyLocationIDs[counter]
+                    self.locationImageController.viewImage(
+                        placeId: placeId,
+                        localMarker: locationMarker,
+                        imageView: UIImageView(),
+                        tapped: false
+                    )
+                    counter += 1
+                    let position = CLLocationCoordinate2DMake(
                         locationMarker.position.latitude,
                         locationMarker.position.longitude
                     )
-                    )
-                )
+                    if let item = staleItems.removeValue(forKey: placeId) {
+                        if item.position.latitude != position.latitude
+                            || item.position.longitude != position.longitude {
+                            item.position = position
+                            self.clusterAlgorithm.move(item)
+                        }
+                    } else {
+                        let item = POIItem(position: position)
+                        self.clusterItems[placeId] = item
+                        self.clusterAlgorithm.insert(item)
+                    }
+                }
+                for (placeId, item) in staleItems {
+                    self.clusterItems[placeId] = nil
+                    self.clusterAlgorithm.remove(item)
+                }
             }
+            self.clusterManager.cluster()
             
             // Zooms in the current location
             self.placesClient.currentPlace(callback: { (placeLikelihoodList, error) -> Void in
@@ -0,0 +1,238 @@
+#!/usr/bin/env python3
+# Copyright 2026 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Checks map style JSON files and writes them out in a compact, canonical form.
+
+Usage: compile_map_styles.py [--output-dir DIR] STYLE.json...
+
+Every rule is checked against the feature types, element types and stylers of
+the map style reference, so that a misspelt selector fails the build instead of
+being ignored at run time. Problems are printed as "path:line: error: ..." for
+Xcode to show, with the line of the rule they are in. Without --output-dir the styles are only checked.
+
+The compiled style has its rules' selectors in a fixed order, leaves out
+selectors that are "all", gives each styler its own object, lowercases colours
+and has no whitespace, so the app reads as little as possible when it loads a
+style.
+"""
+
+import argparse
+import json
+import math
+import os
+import re
+import sys
+
+FEATURE_TYPES = {
+    "all",
+    "administrative",
+    "administrative.country",
+    "administrative.land_parcel",
+    "administrative.locality",
+    "administrative.neighborhood",
+    "administrative.province",
+    "landscape",
+    "landscape.man_made",
+    "landscape.natural",
+    "landscape.natural.landcover",
+    "landscape.natural.terrain",
+    "poi",
+    "poi.attraction",
+    "poi.business",
+    "poi.government",
+    "poi.medical",
+    "poi.park",
+    "poi.place_of_worship",
+    "poi.school",
+    "poi.sports_complex",
+    "road",
+    "road.arterial",
+    "road.highway",
+    "road.highway.controlled_access",
+    "road.local",
+    "transit",
+    "transit.line",
+    "transit.station",
+    "transit.station.airport",
+    "transit.station.bus",
+    "transit.station.rail",
+    "water",
+}
+
+ELEMENT_TYPES = {
+    "all",
+    "geometry",
+    "geometry.fill",
+    "geometry.stroke",
+    "labels",
+    "labels.icon",
+    "labels.text",
+    "labels.text.fill",
+    "labels.text.stroke",
+}
+
+COLOR = re.compile(r"^#[0-9A-Fa-f]{6}$")
+
+
+def is_number(value):
+    return (isinstance(value, (int, float)) and not isinstance(value, bool)
+            and math.isfinite(value))
+
+
+def number_between(low, high):
+    def check(value):
+        if not is_number(value) or not low <= value <= high:
+            raise ValueError("must be a number from %g to %g" % (low, high))
+        return int(value) if value == int(value) else value
+    return check
+
+
+def check_color(value):
+    if not isinstance(value, str) or not COLOR.match(value):
+        raise ValueError('must be a colour like "#rrggbb"')
+    return value.lower()
+
+
+def check_weight(value):
+    if not is_number(value) or value < 0:
+        raise ValueError("must be a number of at least 0")
+    return int(value) if value == int(value) else value
+
+
+def check_invert_lightness(value):
+    if not isinstance(value, bool):
+        raise ValueError("must be true or false")
+    return value
+
+
+def check_visibility(value):
+    if value not in ("on", "off", "simplified"):
+        raise ValueError('must be "on", "off" or "simplified"')
+    return value
+
+
+STYLERS = {
+    "hue": check_color,
+    "lightness": number_between(-100, 100),
+    "saturation": number_between(-100, 100),
+    "gamma": number_between(0.01, 10),
+    "invert_lightness": check_invert_lightness,
+    "visibility": check_visibility,
+    "color": check_color,
+    "weight": check_weight,
+}
+
+
+def compile_style(style, report):
+    """Returns the canonical form of the rules in |style|, calling |report| with each problem."""
+    if not isinstance(style, list):
+        report(None, "a style must be an array of rules")
+        return []
+    rules = []
+    for index, rule in enumerate(style):
+        if not isinstance(rule, dict):
+            report(index, "a rule must be an object")
+            continue
+        for key in rule:
+            if key not in ("featureType", "elementType", "stylers"):
+                report(index, 'unknown key "%s"' % key)
+        compiled = {}
+        feature_type = rule.get("featureType", "all")
+        if feature_type not in FEATURE_TYPES:
+            report(index, 'unknown featureType "%s"' % feature_type)
+        elif feature_type != "all":
+            compiled["featureType"] = feature_type
+        element_type = rule.get("elementType", "all")
+        if element_type not in ELEMENT_TYPES:
+            report(index, 'unknown elementType "%s"' % element_type)
+        elif element_type != "all":
+            compiled["elementType"] = element_type
+        stylers = rule.get("stylers")
+        if not isinstance(stylers, list) or not stylers:
+            report(index, "stylers must be a non-empty array")
+            continue
+        compiled["stylers"] = []
+        for styler in stylers:
+            if not isinstance(styler, dict) or not styler:
+                report(index, "a styler must be a non-empty object")
+                continue
+            for name, value in styler.items():
+                if name not in STYLERS:
+                    report(index, 'unknown styler "%s"' % name)
+                    continue
+                try:
+                    compiled["stylers"].append({name: STYLERS[name](value)})
+                except ValueError as error:
+                    report(index, "%s %s" % (name, error))
+        rules.append(compiled)
+    return rules
+
+
+def rule_lines(text):
+    """Returns the line each rule of the style array in |text| starts on."""
+    decoder = json.JSONDecoder()
+    whitespace = re.compile(r"[ \t\n\r]*")
+    position = whitespace.match(text).end()
+    if not text.startswith("[", position):
+        return []
+    lines = []
+    position = whitespace.match(text, position + 1).end()
+    while position < len(text) and text[position] != "]":
+        lines.append(text.count("\n", 0, position) + 1)
+        _, position = decoder.raw_decode(text, position)
+        position = whitespace.match(text, position).end()
+        if text.startswith(",", position):
+            position = whitespace.match(text, position + 1).end()
+    return lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--output-dir", help="where to write the compiled styles")
+    parser.add_argument("styles", nargs="+", metavar="STYLE.json")
+    args = parser.parse_args()
+
+    failed = False
+    for path in args.styles:
+        problems = []
+        lines = []
+
+        def report(index, message):
+            location = path if index is None else "%s:%d" % (path, lines[index])
+            problems.append("%s: error: %s" % (location, message))
+
+        try:
+            with open(path, encoding="utf-8") as file:
+                text = file.read()
+            style = json.loads(text)
+            lines = rule_lines(text)
+        except (OSError, ValueError) as error:
+            report(None, "cannot read the style: %s" % error)
+            style = None
+        rules = compile_style(style, report) if style is not None else []
+        if problems:
+            print("\n".join(problems), file=sys.stderr)
+            failed = True
+            continue
+        if args.output_dir:
+            os.makedirs(args.output_dir, exist_ok=True)
+            output = os.path.join(args.output_dir, os.path.basename(path))
+            with open(output, "w", encoding="utf-8") as file:
+                json.dump(rules, file, separators=(",", ":"), ensure_ascii=False)
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+@import GoogleMapsUtils;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A cluster icon generator that draws each bucket's icon once, instead of drawing a new image
+ * every time a cluster is shown.
+ *
+ * Like GMUDefaultClusterIconGenerator, clusters at least as large as a bucket show that bucket's
+ * label ("10+", "50+", ...), and smaller clusters show their exact count. Every bucket icon is
+ * drawn into one shared atlas on first use and handed out as a view into it. Exact-count icons are
+ * drawn on demand and kept in a small least-recently-used cache. Drawing uses an off-screen Core
+ * Graphics bitmap and Core Text, so it needs no UIKit graphics context and can run off the main
+ * thread. The icon caches are guarded by a lock, so icons can be asked for from several threads
+ * at once.
+ */
+@interface ClusterIconAtlas : NSObject <GMUClusterIconGenerator>
+
+/** Buckets 10, 50, 100, 200 and 1000, in GMUDefaultClusterIconGenerator's colours. */
+- (instancetype)init;
+
+/**
+ * |buckets| must be ascending and positive, with one colour in |backgroundColors| for each.
+ * Clusters smaller than the first bucket use the first colour.
+ */
+- (instancetype)initWithBuckets:(NSArray<NSNumber *> *)buckets
+               backgroundColors:(NSArray<UIColor *> *)backgroundColors
+                          scale:(CGFloat)scale NS_DESIGNATED_INITIALIZER;
+
+@end
+
+NS_ASSUME_NONNULL_END
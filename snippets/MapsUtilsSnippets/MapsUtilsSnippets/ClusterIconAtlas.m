@@ -0,0 +1,206 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "ClusterIconAtlas.h"
+
+@import CoreText;
+
+// Diameter of the smallest icon, in points; each bucket after the first adds kDiameterStep.
+static const CGFloat kBaseDiameter = 30;
+static const CGFloat kDiameterStep = 4;
+
+static const CGFloat kStrokeWidth = 2;
+
+// Font size as a fraction of an icon's diameter.
+static const CGFloat kFontScale = 0.4;
+
+// Exact-count icons kept before the least recently used is dropped.
+static const NSUInteger kExactIconCapacity = 64;
+
+/**
+ * Draws a filled circle with a white outline and a centred white label into |rect| of |context|,
+ * whose units are pixels.
+ */
+static void DrawIcon(CGContextRef context, CGRect rect, UIColor *color, NSString *label) {
+  CGFloat inset = kStrokeWidth * rect.size.width / kBaseDiameter / 2;
+  CGRect circle = CGRectInset(rect, inset, inset);
+  CGContextSetFillColorWithColor(context, color.CGColor);
+  CGContextFillEllipseInRect(context, circle);
+  CGContextSetStrokeColorWithColor(context, UIColor.whiteColor.CGColor);
+  CGContextSetLineWidth(context, 2 * inset);
+  CGContextStrokeEllipseInRect(context, circle);
+
+  CTFontRef font = CTFontCreateUIFontForLanguage(kCTFontUIFontEmphasizedSystem,
+                                                 rect.size.width * kFontScale, NULL);
+  NSDictionary *attributes = @{
+    (__bridge NSString *)kCTFontAttributeName : (__bridge id)font,
+    (__bridge NSString *)kCTForegroundColorAttributeName : (__bridge id)UIColor.whiteColor.CGColor,
+  };
+  NSAttributedString *text = [[NSAttributedString alloc] initWithString:label
+                                                             attributes:attributes];
+  CTLineRef line = CTLineCreateWithAttributedString((__bridge CFAttributedStringRef)text);
+  CGFloat ascent = 0;
+  CGFloat descent = 0;
+  double width = CTLineGetTypographicBounds(line, &ascent, &descent, NULL);
+  CGContextSetTextPosition(context, CGRectGetMidX(rect) - width / 2,
+                           CGRectGetMidY(rect) - (ascent - descent) / 2);
+  CTLineDraw(line, context);
+  CFRelease(line);
+  CFRelease(font);
+}
+
+/** Returns an empty bitmap context |width| by |height| pixels. */
+static CGContextRef CreateBitmapContext(size_t width, size_t height) {
+  CGColorSpaceRef colorSpace = CGColorSpaceCreateWithName(kCGColorSpaceSRGB);
+  CGContextRef context =
+      CGBitmapContextCreate(NULL, width, height, 8, 0, colorSpace,
+                            kCGImageAlphaPremultipliedLast | kCGBitmapByteOrder32Big);
+  CGColorSpaceRelease(colorSpace);
+  return context;
+}
+
+@implementation ClusterIconAtlas {
+  NSArray<NSNumber *> *_buckets;
+  NSArray<UIColor *> *_backgroundColors;
+  CGFloat _scale;
+
+  // The icons below are guarded by @synchronized(self), so icons can be asked for on any thread.
+
+  // Each bucket's icon, all views into one atlas image; nil until an icon is first asked for.
+  NSArray<UIImage *> *_bucketIcons;
+
+  // Exact-count icons by count, and their counts from least to most recently used.
+  NSMutableDictionary<NSNumber *, UIImage *> *_exactIcons;
+  NSMutableArray<NSNumber *> *_exactIconOrder;
+}
+
+- (instancetype)init {
+  NSArray<UIColor *> *colors = @[
+    [UIColor colorWithRed:0x00 / 255.f green:0x99 / 255.f blue:0xcc / 255.f alpha:1],
+    [UIColor colorWithRed:0x66 / 255.f green:0x99 / 255.f blue:0x00 / 255.f alpha:1],
+    [UIColor colorWithRed:0xff / 255.f green:0x88 / 255.f blue:0x00 / 255.f alpha:1],
+    [UIColor colorWithRed:0xcc / 255.f green:0x00 / 255.f blue:0x00 / 255.f alpha:1],
+    [UIColor colorWithRed:0x99 / 255.f green:0x33 / 255.f blue:0xcc / 255.f alpha:1],
+  ];
+  return [self initWithBuckets:@[ @10, @50, @100, @200, @1000 ]
+              backgroundColors:colors
+                         scale:UIScreen.mainScreen.scale];
+}
+
+- (instancetype)initWithBuckets:(NSArray<NSNumber *> *)buckets
+               backgroundColors:(NSArray<UIColor *> *)backgroundColors
+                          scale:(CGFloat)scale {
+  NSParameterAssert(buckets.count > 0 && buckets.count == backgroundColors.count);
+  if ((self = [super init])) {
+    _buckets = [buckets copy];
+    _backgroundColors = [backgroundColors copy];
+    _scale = scale;
+    _exactIcons = [NSMutableDictionary dictionary];
+    _exactIconOrder = [NSMutableArray array];
+  }
+  return self;
+}
+
+- (UIImage *)iconForSize:(NSUInteger)size {
+  NSUInteger bucket = _buckets.count;
+  while (bucket > 0 && size < _buckets[bucket - 1].unsignedIntegerValue) {
+    bucket--;
+  }
+  if (bucket > 0) {
+    @synchronized(self) {
+      if (!_bucketIcons) {
+        [self drawAtlas];
+      }
+      return _bucketIcons[bucket - 1];
+    }
+  }
+
+  NSNumber *key = @(size);
+  @synchronized(self) {
+    UIImage *icon = _exactIcons[key];
+    if (icon) {
+      [_exactIconOrder removeObject:key];
+      [_exactIconOrder addObject:key];
+      return icon;
+    }
+  }
+  // Drawn outside the lock, so that other icons are not held up by it.
+  size_t pixels = (size_t)ceil(kBaseDiameter * _scale);
+  CGContextRef context = CreateBitmapContext(pixels, pixels);
+  DrawIcon(context, CGRectMake(0, 0, pixels, pixels), _backgroundColors[0],
+           [NSString stringWithFormat:@"%lu", (unsigned long)size]);
+  CGImageRef image = CGBitmapContextCreateImage(context);
+  UIImage *icon = [UIImage imageWithCGImage:image scale:_scale orientation:UIImageOrientationUp];
+  CGImageRelease(image);
+  CGContextRelease(context);
+
+  @synchronized(self) {
+    // Another thread may have drawn the same icon meanwhile; keep the one already cached.
+    UIImage *cached = _exactIcons[key];
+    if (cached) {
+      return cached;
+    }
+    if (_exactIconOrder.count == kExactIconCapacity) {
+      [_exactIcons removeObjectForKey:_exactIconOrder.firstObject];
+      [_exactIconOrder removeObjectAtIndex:0];
+    }
+    _exactIcons[key] = icon;
+    [_exactIconOrder addObject:key];
+  }
+  return icon;
+}
+
+#pragma mark - Private
+
+/**
+ * Draws every bucket's icon side by side into one image, then cuts out a view of each. Called
+ * with the lock held.
+ */
+- (void)drawAtlas {
+  NSUInteger count = _buckets.count;
+  NSMutableArray<NSValue *> *frames = [NSMutableArray arrayWithCapacity:count];
+  CGFloat atlasWidth = 0;
+  CGFloat atlasHeight = 0;
+  for (NSUInteger i = 0; i < count; i++) {
+    CGFloat pixels = ceil((kBaseDiameter + i * kDiameterStep) * _scale);
+    [frames addObject:[NSValue valueWithCGRect:CGRectMake(atlasWidth, 0, pixels, pixels)]];
+    atlasWidth += pixels;
+    atlasHeight = MAX(atlasHeight, pixels);
+  }
+
+  CGContextRef context = CreateBitmapContext((size_t)atlasWidth, (size_t)atlasHeight);
+  for (NSUInteger i = 0; i < count; i++) {
+    DrawIcon(context, frames[i].CGRectValue, _backgroundColors[i],
+             [NSString stringWithFormat:@"%lu+", _buckets[i].unsignedLongValue]);
+  }
+  CGImageRef atlas = CGBitmapContextCreateImage(context);
+  CGContextRelease(context);
+
+  // The bitmap's origin is at the bottom left and the image's at the top left, which only matters
+  // for icons shorter than the atlas.
+  NSMutableArray<UIImage *> *icons = [NSMutableArray arrayWithCapacity:count];
+  for (NSValue *frame in frames) {
+    CGRect rect = frame.CGRectValue;
+    rect.origin.y = atlasHeight - CGRectGetMaxY(rect);
+    CGImageRef image = CGImageCreateWithImageInRect(atlas, rect);
+    [icons addObject:[UIImage imageWithCGImage:image
+                                         scale:_scale
+                                   orientation:UIImageOrientationUp]];
+    CGImageRelease(image);
+  }
+  CGImageRelease(atlas);
+  _bucketIcons = icons;
+}
+
+@end
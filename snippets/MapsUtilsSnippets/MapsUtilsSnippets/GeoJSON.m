@@ -16,9 +16,21 @@
 #import "GeoJSON.h"
 // [START maps_ios_geojson]
 @import GoogleMapsUtils;
+// [START_EXCLUDE]
+@import GoogleMaps;
+#import "GeoJSONStreamReader.h"
+#import "VectorTileIndex.h"
+#import "VectorTileRenderer.h"
+
+@interface GeoJSON () <GMSMapViewDelegate>
+@end
+// [END_EXCLUDE]
 
 @implementation GeoJSON {
   GMSMapView *_mapView;
+  // [START_EXCLUDE]
+  VectorTileRenderer *_tileRenderer;
+  // [END_EXCLUDE]
 }
 
 - (void)renderGeoJSON {
@@ -31,5 +43,93 @@
   [renderer render];
 }
 
+// [START_EXCLUDE]
+// [START maps_ios_geojson_streaming]
+/// Function demonstrating how to draw a large GeoJSON file one feature at a time
+- (void)renderGeoJSONStreaming {
+  NSString *path = [[NSBundle mainBundle] pathForResource:@"GeoJSON_sample" ofType:@"json"];
+  GeoJSONStreamReader *reader =
+      [[GeoJSONStreamReader alloc] initWithURL:[NSURL fileURLWithPath:path]];
+  GMSMapView *mapView = _mapView;
+  GeoJSONFeatureHandler handler = ^(const GeoJSONFeature *feature,
+                                    NSDictionary<NSString *, id> *properties, BOOL *stop) {
+    NSUInteger group = 0;
+    NSUInteger pathIndex = 0;
+    for (NSUInteger i = 0; i < feature->geometryCount; i++) {
+      GeoJSONGeometry geometry = feature->geometries[i];
+      for (; group < geometry.groupEnd; group++) {
+        // Each group is a point, a line, a set of lines or points, or a polygon and its holes.
+        NSMutableArray<GMSPath *> *paths = [NSMutableArray array];
+        for (; pathIndex < feature->groupEnds[group]; pathIndex++) {
+          NSUInteger start = pathIndex > 0 ? feature->pathEnds[pathIndex - 1] : 0;
+          GMSMutablePath *mutablePath = [GMSMutablePath path];
+          for (NSUInteger j = start; j < feature->pathEnds[pathIndex]; j++) {
+            [mutablePath addCoordinate:feature->coordinates[j]];
+          }
+          [paths addObject:mutablePath];
+        }
+        switch (geometry.type) {
+          case GeoJSONGeometryTypePoint:
+          case GeoJSONGeometryTypeMultiPoint:
+            for (GMSPath *points in paths) {
+              for (NSUInteger j = 0; j < points.count; j++) {
+                [GMSMarker markerWithPosition:[points coordinateAtIndex:j]].map = mapView;
+              }
+            }
+            break;
+          case GeoJSONGeometryTypeLineString:
+          case GeoJSONGeometryTypeMultiLineString:
+            for (GMSPath *line in paths) {
+              [GMSPolyline polylineWithPath:line].map = mapView;
+            }
+            break;
+          case GeoJSONGeometryTypePolygon:
+          case GeoJSONGeometryTypeMultiPolygon:
+            if (paths.count > 0) {
+              GMSPolygon *polygon = [GMSPolygon polygonWithPath:paths.firstObject];
+              polygon.holes = [paths subarrayWithRange:NSMakeRange(1, paths.count - 1)];
+              polygon.map = mapView;
+            }
+            break;
+        }
+      }
+    }
+  };
+  NSError *error;
+  if (![reader readFeaturesWithHandler:handler error:&error]) {
+    NSLog(@"Could not read the GeoJSON: %@", error.localizedDescription);
+  }
+}
+// [END maps_ios_geojson_streaming]
+
+// [START maps_ios_geojson_vector_tiles]
+/// Function demonstrating how to draw only the features of a large GeoJSON file that are in view
+- (void)renderGeoJSONVectorTiles {
+  NSString *path = [[NSBundle mainBundle] pathForResource:@"GeoJSON_sample" ofType:@"json"];
+  GeoJSONStreamReader *reader =
+      [[GeoJSONStreamReader alloc] initWithURL:[NSURL fileURLWithPath:path]];
+  reader.readsProperties = NO;
+  VectorTileIndex *tileIndex = [[VectorTileIndex alloc] init];
+  GeoJSONFeatureHandler handler = ^(const GeoJSONFeature *feature,
+                                    NSDictionary<NSString *, id> *properties, BOOL *stop) {
+    [tileIndex addFeature:feature];
+  };
+  NSError *error;
+  if (![reader readFeaturesWithHandler:handler error:&error]) {
+    NSLog(@"Could not read the GeoJSON: %@", error.localizedDescription);
+    return;
+  }
+  _tileRenderer = [[VectorTileRenderer alloc] initWithMapView:_mapView tileIndex:tileIndex];
+  _mapView.delegate = self;
+  [_tileRenderer update];
+}
+
+- (void)mapView:(GMSMapView *)mapView idleAtCameraPosition:(GMSCameraPosition *)position {
+  // Draw the tiles that have come into view, and remove those that have left it.
+  [_tileRenderer update];
+}
+// [END maps_ios_geojson_vector_tiles]
+// [END_EXCLUDE]
+
 @end
 // [END maps_ios_geojson]
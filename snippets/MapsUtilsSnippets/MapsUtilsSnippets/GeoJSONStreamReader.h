@@ -0,0 +1,115 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import <CoreLocation/CoreLocation.h>
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+FOUNDATION_EXTERN NSErrorDomain const GeoJSONStreamReaderErrorDomain;
+
+typedef NS_ERROR_ENUM(GeoJSONStreamReaderErrorDomain, GeoJSONStreamReaderError) {
+  /** The stream could not be opened or read. */
+  GeoJSONStreamReaderErrorUnreadable = 1,
+  /** The stream is not valid JSON. */
+  GeoJSONStreamReaderErrorInvalidJSON = 2,
+  /** The JSON is not a GeoJSON feature or feature collection. */
+  GeoJSONStreamReaderErrorInvalidGeoJSON = 3,
+};
+
+typedef NS_ENUM(NSInteger, GeoJSONGeometryType) {
+  GeoJSONGeometryTypePoint,
+  GeoJSONGeometryTypeMultiPoint,
+  GeoJSONGeometryTypeLineString,
+  GeoJSONGeometryTypeMultiLineString,
+  GeoJSONGeometryTypePolygon,
+  GeoJSONGeometryTypeMultiPolygon,
+};
+
+/**
+ * One geometry of a feature. Its coordinates are split into paths, and its paths into groups: a
+ * polygon's rings form one group and a multipolygon has a group per polygon. Every other type has
+ * one group, whose paths are its lines, or a single path holding all of its points.
+ */
+typedef struct {
+  GeoJSONGeometryType type;
+  /** Index one past the geometry's last group. */
+  NSUInteger groupEnd;
+} GeoJSONGeometry;
+
+/**
+ * A feature's geometry, flattened into arrays that are reused from one feature to the next. Each
+ * list of ends gives the index one past the last item of each entry in the next list down, so
+ * entry |i| runs from the end of entry |i - 1|, or 0, to its own end.
+ */
+typedef struct {
+  /** The geometries; a geometry collection's members, or none for a null geometry. */
+  const GeoJSONGeometry *geometries;
+  NSUInteger geometryCount;
+  /** Index one past each group's last path. */
+  const NSUInteger *groupEnds;
+  /** Index one past each path's last coordinate. */
+  const NSUInteger *pathEnds;
+  const CLLocationCoordinate2D *coordinates;
+  NSUInteger coordinateCount;
+} GeoJSONFeature;
+
+/**
+ * Called with each feature as soon as it has been read. |feature| and its arrays are only valid
+ * during the call. Set |stop| to YES to stop reading.
+ */
+typedef void (^GeoJSONFeatureHandler)(const GeoJSONFeature *feature,
+                                      NSDictionary<NSString *, id> *_Nullable properties,
+                                      BOOL *stop);
+
+/**
+ * Reads a GeoJSON feature collection one feature at a time, instead of parsing the whole file into
+ * objects first as GMUGeoJSONParser does.
+ *
+ * The stream is tokenised a buffer at a time, and each feature's coordinates are written into
+ * arrays that are reused for the next feature, so memory stays bounded by the largest feature
+ * however large the file is.
+ */
+@interface GeoJSONStreamReader : NSObject
+
+/**
+ * Whether to parse each feature's "properties" into a dictionary for the handler. Defaults to NO,
+ * which skips them without building any objects.
+ */
+@property(nonatomic) BOOL readsProperties;
+
+/** Reads the GeoJSON file at |url|. */
+- (nullable instancetype)initWithURL:(NSURL *)url;
+
+/** Reads from |stream|, which must not have been opened yet. */
+- (instancetype)initWithInputStream:(NSInputStream *)stream NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Reads the stream, calling |handler| with each feature in order on the calling thread. A reader
+ * can only read its stream once.
+ *
+ * @return NO with |error| set if the stream cannot be read or is not GeoJSON. Features before the
+ *     problem will have been handled.
+ */
+- (BOOL)readFeaturesWithHandler:(NS_NOESCAPE GeoJSONFeatureHandler)handler
+                          error:(NSError **)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
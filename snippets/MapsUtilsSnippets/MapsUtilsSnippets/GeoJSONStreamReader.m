@@ -0,0 +1,791 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "GeoJSONStreamReader.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+NSErrorDomain const GeoJSONStreamReaderErrorDomain = @"GeoJSONStreamReaderErrorDomain";
+
+// Bytes read from the stream at a time. The buffer only grows past this for a longer token, or
+// for a feature's properties when they are kept.
+static const NSUInteger kBufferSize = 64 * 1024;
+
+// Longest key or type name that is compared; longer strings match nothing.
+static const NSUInteger kNameCapacity = 32;
+
+// Longest number, in characters.
+static const NSUInteger kNumberCapacity = 64;
+
+// Deepest that geometry collections may nest.
+static const NSUInteger kMaxCollectionDepth = 8;
+
+// Deepest that coordinates nest, in a multipolygon: polygons, rings, then positions.
+static const NSInteger kMaxCoordinateLevel = 3;
+
+/** Reads up to |length| bytes, returning how many it read, 0 at the end or -1 on failure. */
+typedef NSInteger (*ReadFunction)(void *context, uint8_t *bytes, NSUInteger length);
+
+/**
+ * A window onto the stream. Bytes before |position| are dropped when the buffer is refilled,
+ * except from |pinned| on, which lets a value be copied out once it has been skipped.
+ */
+typedef struct {
+  ReadFunction read;
+  void *context;
+  uint8_t *bytes;
+  NSUInteger capacity;
+  NSUInteger length;
+  NSUInteger position;
+  NSUInteger pinned;
+  // Bytes dropped so far, to report where errors are.
+  NSUInteger dropped;
+  BOOL ended;
+  BOOL stopped;
+  GeoJSONStreamReaderError errorCode;
+  const char *errorMessage;
+  NSUInteger errorOffset;
+} Tokenizer;
+
+/** The current feature, in arrays that grow as needed and are reused for every feature. */
+typedef struct {
+  GeoJSONGeometry *geometries;
+  NSUInteger geometryCount;
+  NSUInteger geometryCapacity;
+  NSUInteger *groupEnds;
+  NSUInteger groupCount;
+  NSUInteger groupCapacity;
+  NSUInteger *pathEnds;
+  NSUInteger pathCount;
+  NSUInteger pathCapacity;
+  CLLocationCoordinate2D *coordinates;
+  NSUInteger coordinateCount;
+  NSUInteger coordinateCapacity;
+  // The raw JSON of the properties, when they are kept.
+  BOOL keepsProperties;
+  uint8_t *properties;
+  NSUInteger propertiesLength;
+  NSUInteger propertiesCapacity;
+} FeatureBuffers;
+
+/** Called with each feature once it is complete; returns NO to stop reading. */
+typedef BOOL (*EmitFunction)(void *context, const FeatureBuffers *buffers);
+
+typedef struct {
+  EmitFunction emit;
+  void *context;
+} Emitter;
+
+static BOOL Fail(Tokenizer *tokenizer, GeoJSONStreamReaderError code, const char *message) {
+  if (!tokenizer->errorMessage) {
+    tokenizer->errorCode = code;
+    tokenizer->errorMessage = message;
+    tokenizer->errorOffset = tokenizer->dropped + tokenizer->position;
+  }
+  return NO;
+}
+
+/** Makes room in |*array| for at least |count| elements, doubling its capacity as it grows. */
+static BOOL Reserve(void **array, NSUInteger *capacity, NSUInteger count, size_t elementSize) {
+  if (count <= *capacity) {
+    return YES;
+  }
+  NSUInteger newCapacity = MAX(*capacity * 2, MAX(count, 16));
+  void *grown = realloc(*array, newCapacity * elementSize);
+  if (!grown) {
+    return NO;
+  }
+  *array = grown;
+  *capacity = newCapacity;
+  return YES;
+}
+
+#pragma mark - Tokenizing
+
+/**
+ * Reads more of the stream into the buffer, first dropping the bytes already consumed and growing
+ * the buffer if none can be dropped.
+ *
+ * @return NO at the end of the stream or if it fails.
+ */
+static BOOL Refill(Tokenizer *tokenizer) {
+  if (tokenizer->ended) {
+    return NO;
+  }
+  NSUInteger keep = MIN(tokenizer->position, tokenizer->pinned);
+  if (keep > 0) {
+    memmove(tokenizer->bytes, tokenizer->bytes + keep, tokenizer->length - keep);
+    tokenizer->length -= keep;
+    tokenizer->position -= keep;
+    if (tokenizer->pinned != NSNotFound) {
+      tokenizer->pinned -= keep;
+    }
+    tokenizer->dropped += keep;
+  }
+  if (tokenizer->length == tokenizer->capacity &&
+      !Reserve((void **)&tokenizer->bytes, &tokenizer->capacity, tokenizer->capacity * 2, 1)) {
+    return Fail(tokenizer, GeoJSONStreamReaderErrorUnreadable, "Out of memory");
+  }
+  NSInteger count = tokenizer->read(tokenizer->context, tokenizer->bytes + tokenizer->length,
+                                    tokenizer->capacity - tokenizer->length);
+  if (count < 0) {
+    tokenizer->ended = YES;
+    return Fail(tokenizer, GeoJSONStreamReaderErrorUnreadable, "The stream could not be read");
+  }
+  if (count == 0) {
+    tokenizer->ended = YES;
+    return NO;
+  }
+  tokenizer->length += count;
+  return YES;
+}
+
+/** Returns the next byte without consuming it, or -1 at the end of the stream. */
+static inline int Peek(Tokenizer *tokenizer) {
+  while (tokenizer->position == tokenizer->length) {
+    if (!Refill(tokenizer)) {
+      return -1;
+    }
+  }
+  return tokenizer->bytes[tokenizer->position];
+}
+
+/** Skips whitespace and returns the next byte, or -1 at the end of the stream. */
+static int SkipWhitespace(Tokenizer *tokenizer) {
+  for (;;) {
+    int c = Peek(tokenizer);
+    if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+      return c;
+    }
+    tokenizer->position++;
+  }
+}
+
+static BOOL Expect(Tokenizer *tokenizer, int expected, const char *message) {
+  if (SkipWhitespace(tokenizer) != expected) {
+    return Fail(tokenizer, GeoJSONStreamReaderErrorInvalidJSON, message);
+  }
+  tokenizer->position++;
+  return YES;
+}
+
+/**
+ * Consumes a string. If |name| is not NULL, the string is copied there as a C string, or left
+ * empty if it is too long to be any name that is looked for.
+ */
+static BOOL ReadString(Tokenizer *tokenizer, char *name) {
+  if (!Expect(tokenizer, '"', "Expected a string")) {
+    return NO;
+  }
+  NSUInteger length = 0;
+  BOOL fits = YES;
+  for (;;) {
+    int c = Peek(tokenizer);
+    if (c < 0) {
+      return Fail(tokenizer, GeoJSONStreamReaderErrorInvalidJSON, "Unterminated string");
+    }
+    tokenizer->position++;
+    if (c == '"') {
+      break;
+    }
+    if (c == '\\') {
+      c = Peek(tokenizer);
+      if (c < 0) {
+        return Fail(tokenizer, GeoJSONStreamReaderErrorInvalidJSON, "Unterminated string");
+      }
+      tokenizer->position++;
+      // Names are plain ASCII, so a \u escape rules the string out.
+      if (c == 'u') {
+        fits = NO;
+      }
+    }
+    if (name && fits) {
+      if (length + 1 < kNameCapacity) {
+        name[length++] = (char)c;
+      } else {
+        fits = NO;
+      }
+    }
+  }
+  if (name) {
+    name[fits ? length : 0] = '\0';
+  }
+  return YES;
+}
+
+static inline BOOL IsNumberCharacter(int c) {
+  return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+/**
+ * Parses a plain decimal of at most 15 significant digits, which covers coordinates to well under
+ * a millimetre. Such a mantissa and its power of ten are both exact doubles, so one division
+ * rounds correctly, as strtod would.
+ *
+ * @return NO if the number needs strtod.
+ */
+static BOOL ParseShortDecimal(const char *characters, NSUInteger length, double *value) {
+  static const double kPowersOfTen[] = {1e0, 1e1, 1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                        1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+  NSUInteger i = characters[0] == '-' ? 1 : 0;
+  uint64_t mantissa = 0;
+  NSUInteger digits = 0;
+  NSUInteger fractionDigits = 0;
+  BOOL inFraction = NO;
+  for (; i < length; i++) {
+    char c = characters[i];
+    if (c >= '0' && c <= '9') {
+      mantissa = mantissa * 10 + (uint64_t)(c - '0');
+      digits++;
+      fractionDigits += inFraction;
+    } else if (c == '.' && !inFraction) {
+      inFraction = YES;
+    } else {
+      return NO;
+    }
+  }
+  if (digits == 0 || digits > 15) {
+    return NO;
+  }
+  double magnitude = (double)mantissa / kPowersOfTen[fractionDigits];
+  *value = characters[0] == '-' ? -magnitude : magnitude;
+  return YES;
+}
+
+static BOOL ReadNumber(Tokenizer *tokenizer, double *value) {
+  char characters[kNumberCapacity];
+  NSUInteger length = 0;
+  SkipWhitespace(tokenizer);
+  for (int c = Peek(tokenizer); IsNumberCharacter(c); c = Peek(tokenizer)) {
+    if (length + 1 == kNumberCapacity) {
+      return Fail(tokenizer, GeoJSONStreamReaderErrorInvalidJSON, "Number too long");
+    }
+    characters[length++] = (char)c;
+    tokenizer->position++;
+  }
+  if (length > 0 && ParseShortDecimal(characters, length, value)) {
+    return YES;
+  }
+  characters[length] = '\0';
+  char *end;
+  *value = strtod(characters, &end);
+  if (length == 0 || end != characters + length) {
+    return Fail(tokenizer, GeoJSONStreamReaderErrorInvalidJSON, "Expected a number");
+  }
+  return YES;
+}
+
+/** Consumes any value without looking inside it. */
+static BOOL SkipValue(Tokenizer *tokenizer) {
+  NSUInteger depth = 0;
+  do {
+    int c = SkipWhitespace(tokenizer);
+    if (c < 0) {
+      return Fail(tokenizer, GeoJSONStreamReaderErrorInvalidJSON, "Unexpected end of the stream");
+    }
+    if (c == '"') {
+      if (!ReadString(tokenizer, NULL)) {
+        return NO;
+      }
+    } else if (c == '{' || c == '[') {
+      depth++;
+      tokenizer->position++;
+    } else if ((c == '}' || c == ']') && depth > 0) {
+      depth--;
+      tokenizer->position++;
+    } else if ((c == ',' || c == ':') && depth > 0) {
+      tokenizer->position++;
+    } else {
+      // A number or a literal.
+      NSUInteger start = tokenizer->position + tokenizer->dropped;
+      for (c = Peek(tokenizer); IsNumberCharacter(c) || (c >= 'a' && c <= 'z');
+           c = Peek(tokenizer)) {
+        tokenizer->position++;
+      }
+      if (tokenizer->position + tokenizer->dropped == start) {
+        return Fail(tokenizer, GeoJSONStreamReaderErrorInvalidJSON, "Unexpected character");
+      }
+    }
+  } while (depth > 0);
+  return YES;
+}
+
+/**
+ * Steps through the members of an object whose "{" has been consumed: returns YES with the next
+ * key in |name| and its ":" consumed, or NO with |*done| set once the object is closed.
+ */
+static BOOL NextKey(Tokenizer *tokenizer, BOOL *first, char *name, BOOL *done) {
+  *done = NO;
+  int c = SkipWhitespace(tokenizer);
+  if (c == '}') {
+    tokenizer->position++;
+    *done = YES;
+    return NO;
+  }
+  if (!*first && !Expect(tokenizer, ',', "Expected \",\" or \"}\"")) {
+    return NO;
+  }
+  *first = NO;
+  return ReadString(tokenizer, name) && Expect(tokenizer, ':', "Expected \":\"");
+}
+
+/**
+ * Steps through the elements of an array whose "[" has been consumed: returns YES before each
+ * element, or NO with |*done| set once the array is closed.
+ */
+static BOOL NextElement(Tokenizer *tokenizer, BOOL *first, BOOL *done) {
+  *done = NO;
+  int c = SkipWhitespace(tokenizer);
+  if (c == ']') {
+    tokenizer->position++;
+    *done = YES;
+    return NO;
+  }
+  if (!*first && !Expect(tokenizer, ',', "Expected \",\" or \"]\"")) {
+    return NO;
+  }
+  *first = NO;
+  return YES;
+}
+
+#pragma mark - Parsing
+
+/** Returns how deeply the type's coordinates nest, with a position at level 0, or -1. */
+static NSInteger CoordinateLevel(const char *type, GeoJSONGeometryType *geometryType) {
+  static const struct {
+    const char *name;
+    GeoJSONGeometryType type;
+    NSInteger level;
+  } kTypes[] = {
+      {"Point", GeoJSONGeometryTypePoint, 0},
+      {"MultiPoint", GeoJSONGeometryTypeMultiPoint, 1},
+      {"LineString", GeoJSONGeometryTypeLineString, 1},
+      {"MultiLineString", GeoJSONGeometryTypeMultiLineString, 2},
+      {"Polygon", GeoJSONGeometryTypePolygon, 2},
+      {"MultiPolygon", GeoJSONGeometryTypeMultiPolygon, 3},
+  };
+  for (NSUInteger i = 0; i < sizeof(kTypes) / sizeof(kTypes[0]); i++) {
+    if (strcmp(type, kTypes[i].name) == 0) {
+      *geometryType = kTypes[i].type;
+      return kTypes[i].level;
+    }
+  }
+  return -1;
+}
+
+static BOOL AppendEnd(Tokenizer *tokenizer, NSUInteger **ends, NSUInteger *count,
+                      NSUInteger *capacity, NSUInteger end) {
+  if (!Reserve((void **)ends, capacity, *count + 1, sizeof(NSUInteger))) {
+    return Fail(tokenizer, GeoJSONStreamReaderErrorUnreadable, "Out of memory");
+  }
+  (*ends)[(*count)++] = end;
+  return YES;
+}
+
+/**
+ * Reads a non-empty coordinate array whose "[" has been consumed, appending its positions and
+ * ending a path or group as each array of them closes.
+ *
+ * @param level The array's expected level, with a position at 0, or -1 if it is not yet known.
+ * @param maxLevel The highest level the array may be.
+ * @param foundLevel Set to the array's level.
+ */
+static BOOL ReadCoordinates(Tokenizer *tokenizer, FeatureBuffers *buffers, NSInteger level,
+                            NSInteger maxLevel, NSInteger *foundLevel) {
+  int c = SkipWhitespace(tokenizer);
+  if (c != '[') {
+    // A position: longitude, latitude and any further values, which are ignored.
+    if (level > 0) {
+      return Fail(tokenizer, GeoJSONStreamReaderErrorInvalidGeoJSON, "Expected an array");
+    }
+    double longitude, latitude, ignored;
+    if (!ReadNumber(tokenizer, &longitude) || !Expect(tokenizer, ',', "Expected a latitude") ||
+        !ReadNumber(tokenizer, &latitude)) {
+      return NO;
+    }
+    BOOL first = NO;
+    BOOL done;
+    while (NextElement(tokenizer, &first, &done)) {
+      if (!ReadNumber(tokenizer, &ignored)) {
+        return NO;
+      }
+    }
+    if (!done) {
+      return NO;
+    }
+    if (!Reserve((void **)&buffers->coordinates, &buffers->coordinateCapacity,
+                 buffers->coordinateCount + 1, sizeof(CLLocationCoordinate2D))) {
+      return Fail(tokenizer, GeoJSONStreamReaderErrorUnreadable, "Out of memory");
+    }
+    buffers->coordinates[buffers->coordinateCount++] =
+        CLLocationCoordinate2DMake(latitude, longitude);
+    *foundLevel = 0;
+    return YES;
+  }
+  if (level == 0) {
+    return Fail(tokenizer, GeoJSONStreamReaderErrorInvalidGeoJSON, "Expected a position");
+  }
+  if (maxLevel == 0) {
+    return Fail(tokenizer, GeoJSONStreamReaderErrorInvalidGeoJSON, "Coordinates nest too deeply");
+  }
+
+  // The first element fixes the level of the rest. An empty array is taken to be an empty path
+  // when its level is not known.
+  NSInteger elementLevel = level > 0 ? level - 1 : -1;
+  BOOL first = YES;
+  BOOL done;
+  while (NextElement(tokenizer, &first, &done)) {
+    NSInteger found;
+    if (!Expect(tokenizer, '[', "Expected an array")) {
+      return NO;
+    }
+    if (SkipWhitespace(tokenizer) == ']') {
+      tokenizer->position++;
+      found = elementLevel >= 0 ? elementLevel : 1;
+      if (found == 0) {
+        return Fail(tokenizer, GeoJSONStreamReaderErrorInvalidGeoJSON, "Empty position");
+      }
+      if (found == 1 && !AppendEnd(tokenizer, &buffers->pathEnds, &buffers->pathCount,
+                                   &buffers->pathCapacity, buffers->coordinateCount)) {
+        return NO;
+      }
+      if (found == 2 && !AppendEnd(tokenizer, &buffers->groupEnds, &buffers->groupCount,
+                                   &buffers->groupCapacity, buffers->pathCount)) {
+        return NO;
+      }
+    } else if (!ReadCoordinates(tokenizer, buffers, elementLevel, maxLevel - 1, &found)) {
+      return NO;
+    }
+    if (elementLevel >= 0 && found != elementLevel) {
+      return Fail(tokenizer, GeoJSONStreamReaderErrorInvalidGeoJSON, "Coordinates nest unevenly");
+    }
+    elementLevel = found;
+  }
+  if (!done) {
+    return NO;
+  }
+  *foundLevel = elementLevel + 1;
+  if (*foundLevel == 1) {
+    return AppendEnd(tokenizer, &buffers->pathEnds, &buffers->pathCount, &buffers->pathCapacity,
+                     buffers->coordinateCount);
+  }
+  if (*foundLevel == 2) {
+    return AppendEnd(tokenizer, &buffers->groupEnds, &buffers->groupCount,
+                     &buffers->groupCapacity, buffers->pathCount);
+  }
+  return YES;
+}
+
+/** Reads a geometry object whose "{" has been consumed, flattening any geometry collection. */
+static BOOL ReadGeometry(Tokenizer *tokenizer, FeatureBuffers *buffers, NSUInteger depth) {
+  char type[kNameCapacity];
+  char name[kNameCapacity];
+  type[0] = '\0';
+  GeoJSONGeometryType geometryType = GeoJSONGeometryTypePoint;
+  NSInteger expectedLevel = -1;
+  BOOL hasCoordinates = NO;
+  BOOL emptyCoordinates = NO;
+  NSInteger level = -1;
+  BOOL first = YES;
+  BOOL done;
+  while (NextKey(tokenizer, &first, name, &done)) {
+    if (strcmp(name, "type") == 0) {
+      if (!ReadString(tokenizer, type)) {
+        return NO;
+      }
+      expectedLevel = CoordinateLevel(type, &geometryType);
+    } else if (strcmp(name, "coordinates") == 0) {
+      hasCoordinates = YES;
+      if (!Expect(tokenizer, '[', "Expected coordinates")) {
+        return NO;
+      }
+      if (SkipWhitespace(tokenizer) == ']') {
+        tokenizer->position++;
+        emptyCoordinates = YES;
+      } else if (!ReadCoordinates(tokenizer, buffers, expectedLevel, kMaxCoordinateLevel,
+                                  &level)) {
+        return NO;
+      }
+    } else if (strcmp(name, "geometries") == 0) {
+      if (depth == kMaxCollectionDepth) {
+        return Fail(tokenizer, GeoJSONStreamReaderErrorInvalidGeoJSON,
+                    "Geometry collections nest too deeply");
+      }
+      if (!Expect(tokenizer, '[', "Expected geometries")) {
+        return NO;
+      }
+      BOOL firstGeometry = YES;
+      BOOL geometriesDone;
+      while (NextElement(tokenizer, &firstGeometry, &geometriesDone)) {
+        if (!Expect(tokenizer, '{', "Expected a geometry") ||
+            !ReadGeometry(tokenizer, buffers, depth + 1)) {
+          return NO;
+        }
+      }
+      if (!geometriesDone) {
+        return NO;
+      }
+    } else if (!SkipValue(tokenizer)) {
+      return NO;
+    }
+  }
+  if (!done) {
+    return NO;
+  }
+
+  if (strcmp(type, "GeometryCollection") == 0) {
+    return YES;
+  }
+  if (CoordinateLevel(type, &geometryType) < 0) {
+    return Fail(tokenizer, GeoJSONStreamReaderErrorInvalidGeoJSON, "Unknown geometry type");
+  }
+  if (!hasCoordinates) {
+    return Fail(tokenizer, GeoJSONStreamReaderErrorInvalidGeoJSON, "Geometry has no coordinates");
+  }
+  // Empty coordinates make an empty geometry.
+  if (!emptyCoordinates) {
+    if (level != CoordinateLevel(type, &geometryType)) {
+      return Fail(tokenizer, GeoJSONStreamReaderErrorInvalidGeoJSON,
+                  "Coordinates do not match the geometry type");
+    }
+    if (level == 0 && !AppendEnd(tokenizer, &buffers->pathEnds, &buffers->pathCount,
+                                 &buffers->pathCapacity, buffers->coordinateCount)) {
+      return NO;
+    }
+    if (level <= 1 && !AppendEnd(tokenizer, &buffers->groupEnds, &buffers->groupCount,
+                                 &buffers->groupCapacity, buffers->pathCount)) {
+      return NO;
+    }
+  }
+  if (!Reserve((void **)&buffers->geometries, &buffers->geometryCapacity,
+               buffers->geometryCount + 1, sizeof(GeoJSONGeometry))) {
+    return Fail(tokenizer, GeoJSONStreamReaderErrorUnreadable, "Out of memory");
+  }
+  buffers->geometries[buffers->geometryCount++] =
+      (GeoJSONGeometry){geometryType, buffers->groupCount};
+  return YES;
+}
+
+/** Copies the properties object from the input into |buffers|, if they are kept. */
+static BOOL ReadProperties(Tokenizer *tokenizer, FeatureBuffers *buffers) {
+  if (!buffers->keepsProperties) {
+    return SkipValue(tokenizer);
+  }
+  SkipWhitespace(tokenizer);
+  tokenizer->pinned = tokenizer->position;
+  if (!SkipValue(tokenizer)) {
+    return NO;
+  }
+  NSUInteger length = tokenizer->position - tokenizer->pinned;
+  if (!Reserve((void **)&buffers->properties, &buffers->propertiesCapacity, length, 1)) {
+    return Fail(tokenizer, GeoJSONStreamReaderErrorUnreadable, "Out of memory");
+  }
+  memcpy(buffers->properties, tokenizer->bytes + tokenizer->pinned, length);
+  buffers->propertiesLength = length;
+  tokenizer->pinned = NSNotFound;
+  return YES;
+}
+
+/**
+ * Reads a feature object whose "{" has been consumed, or the top-level object, whose features
+ * are read and emitted one by one. The object's "type" is copied to |type|.
+ */
+static BOOL ReadFeature(Tokenizer *tokenizer, FeatureBuffers *buffers, const Emitter *emitter,
+                        BOOL topLevel, char *type);
+
+static void ResetFeature(FeatureBuffers *buffers) {
+  buffers->geometryCount = 0;
+  buffers->groupCount = 0;
+  buffers->pathCount = 0;
+  buffers->coordinateCount = 0;
+  buffers->propertiesLength = 0;
+}
+
+static BOOL ReadFeatures(Tokenizer *tokenizer, FeatureBuffers *buffers, const Emitter *emitter) {
+  if (!Expect(tokenizer, '[', "Expected an array of features")) {
+    return NO;
+  }
+  char type[kNameCapacity];
+  BOOL first = YES;
+  BOOL done;
+  while (NextElement(tokenizer, &first, &done)) {
+    ResetFeature(buffers);
+    if (!Expect(tokenizer, '{', "Expected a feature") ||
+        !ReadFeature(tokenizer, buffers, emitter, NO, type)) {
+      return NO;
+    }
+    if (strcmp(type, "Feature") != 0) {
+      return Fail(tokenizer, GeoJSONStreamReaderErrorInvalidGeoJSON, "Expected a feature");
+    }
+    if (!emitter->emit(emitter->context, buffers)) {
+      tokenizer->stopped = YES;
+      return NO;
+    }
+  }
+  return done;
+}
+
+static BOOL ReadFeature(Tokenizer *tokenizer, FeatureBuffers *buffers, const Emitter *emitter,
+                        BOOL topLevel, char *type) {
+  char name[kNameCapacity];
+  type[0] = '\0';
+  BOOL first = YES;
+  BOOL done;
+  while (NextKey(tokenizer, &first, name, &done)) {
+    BOOL read;
+    if (strcmp(name, "type") == 0) {
+      read = ReadString(tokenizer, type);
+    } else if (strcmp(name, "geometry") == 0) {
+      if (SkipWhitespace(tokenizer) == 'n') {
+        read = SkipValue(tokenizer);
+      } else {
+        read = Expect(tokenizer, '{', "Expected a geometry") && ReadGeometry(tokenizer, buffers, 0);
+      }
+    } else if (strcmp(name, "properties") == 0) {
+      read = ReadProperties(tokenizer, buffers);
+    } else if (topLevel && strcmp(name, "features") == 0) {
+      read = ReadFeatures(tokenizer, buffers, emitter);
+    } else {
+      read = SkipValue(tokenizer);
+    }
+    if (!read) {
+      return NO;
+    }
+  }
+  return done;
+}
+
+/** Reads a feature collection or a single feature, emitting each feature as it is read. */
+static BOOL ReadDocument(Tokenizer *tokenizer, FeatureBuffers *buffers, const Emitter *emitter) {
+  char type[kNameCapacity];
+  ResetFeature(buffers);
+  if (!Expect(tokenizer, '{', "Expected an object") ||
+      !ReadFeature(tokenizer, buffers, emitter, YES, type)) {
+    return NO;
+  }
+  if (strcmp(type, "Feature") == 0) {
+    if (!emitter->emit(emitter->context, buffers)) {
+      tokenizer->stopped = YES;
+      return NO;
+    }
+  } else if (strcmp(type, "FeatureCollection") != 0) {
+    return Fail(tokenizer, GeoJSONStreamReaderErrorInvalidGeoJSON,
+                "Expected a feature or feature collection");
+  }
+  if (SkipWhitespace(tokenizer) >= 0) {
+    return Fail(tokenizer, GeoJSONStreamReaderErrorInvalidJSON, "Unexpected data after the end");
+  }
+  return tokenizer->errorMessage == NULL;
+}
+
+#pragma mark - Reader
+
+/** What the emit function passes each feature on to. */
+typedef struct {
+  __unsafe_unretained GeoJSONFeatureHandler handler;
+} HandlerContext;
+
+static NSInteger ReadInputStream(void *context, uint8_t *bytes, NSUInteger length) {
+  NSInputStream *stream = (__bridge NSInputStream *)context;
+  return [stream read:bytes maxLength:length];
+}
+
+static BOOL EmitFeature(void *context, const FeatureBuffers *buffers) {
+  HandlerContext *handlerContext = context;
+  BOOL stop = NO;
+  // Drain each feature's objects as it goes, so they never pile up.
+  @autoreleasepool {
+    NSDictionary<NSString *, id> *properties = nil;
+    if (buffers->keepsProperties && buffers->propertiesLength > 0) {
+      NSData *data = [NSData dataWithBytesNoCopy:buffers->properties
+                                          length:buffers->propertiesLength
+                                    freeWhenDone:NO];
+      id object = [NSJSONSerialization JSONObjectWithData:data options:0 error:nil];
+      properties = [object isKindOfClass:[NSDictionary class]] ? object : nil;
+    }
+    GeoJSONFeature feature = {
+        .geometries = buffers->geometries,
+        .geometryCount = buffers->geometryCount,
+        .groupEnds = buffers->groupEnds,
+        .pathEnds = buffers->pathEnds,
+        .coordinates = buffers->coordinates,
+        .coordinateCount = buffers->coordinateCount,
+    };
+    handlerContext->handler(&feature, properties, &stop);
+  }
+  return !stop;
+}
+
+@implementation GeoJSONStreamReader {
+  NSInputStream *_stream;
+}
+
+- (nullable instancetype)initWithURL:(NSURL *)url {
+  NSInputStream *stream = [NSInputStream inputStreamWithURL:url];
+  if (!stream) {
+    return nil;
+  }
+  return [self initWithInputStream:stream];
+}
+
+- (instancetype)initWithInputStream:(NSInputStream *)stream {
+  self = [super init];
+  if (self) {
+    _stream = stream;
+  }
+  return self;
+}
+
+- (BOOL)readFeaturesWithHandler:(NS_NOESCAPE GeoJSONFeatureHandler)handler
+                          error:(NSError **)error {
+  [_stream open];
+  Tokenizer tokenizer = {
+      .read = ReadInputStream,
+      .context = (__bridge void *)_stream,
+      .bytes = malloc(kBufferSize),
+      .capacity = kBufferSize,
+      .pinned = NSNotFound,
+  };
+  FeatureBuffers buffers = {.keepsProperties = _readsProperties};
+  HandlerContext handlerContext = {handler};
+  Emitter emitter = {EmitFeature, &handlerContext};
+  if (_stream.streamStatus == NSStreamStatusError || !tokenizer.bytes) {
+    Fail(&tokenizer, GeoJSONStreamReaderErrorUnreadable, "The stream could not be opened");
+  } else {
+    ReadDocument(&tokenizer, &buffers, &emitter);
+  }
+  [_stream close];
+  free(tokenizer.bytes);
+  free(buffers.geometries);
+  free(buffers.groupEnds);
+  free(buffers.pathEnds);
+  free(buffers.coordinates);
+  free(buffers.properties);
+
+  if (tokenizer.errorMessage && !tokenizer.stopped) {
+    if (error) {
+      NSString *description =
+          [NSString stringWithFormat:@"%s at byte %lu.", tokenizer.errorMessage,
+                                     (unsigned long)tokenizer.errorOffset];
+      *error = [NSError errorWithDomain:GeoJSONStreamReaderErrorDomain
+                                   code:tokenizer.errorCode
+                               userInfo:@{NSLocalizedDescriptionKey : description}];
+    }
+    return NO;
+  }
+  return YES;
+}
+
+@end
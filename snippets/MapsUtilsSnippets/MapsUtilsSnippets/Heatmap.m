@@ -16,6 +16,9 @@
 #import "Heatmap.h"
 @import GoogleMapsUtils;
 
+#import "HeatmapTileLayer.h"
+#import "PointDataset.h"
+
 // [START maps_ios_heatmap_simple]
 @implementation Heatmap {
   GMSMapView *_mapView;
@@ -46,6 +49,54 @@
   _heatmapLayer.map = nil;
   // [END maps_ios_heatmap_remove]
 }
+
+// [START maps_ios_heatmap_rasterized]
+- (void)addRasterizedHeatmap:(NSArray<GMUWeightedLatLng *> *)weightedData {
+  // HeatmapTileLayer takes the same settings as GMUHeatmapTileLayer, but blurs each tile as a
+  // whole, so tiles stay fast with millions of points.
+  HeatmapTileLayer *heatmapLayer = [[HeatmapTileLayer alloc] init];
+  heatmapLayer.radius = 20;
+  heatmapLayer.opacity = 0.7;
+  heatmapLayer.weightedData = weightedData;
+  heatmapLayer.map = _mapView;
+}
+// [END maps_ios_heatmap_rasterized]
+
+// [START maps_ios_heatmap_binary_dataset]
+- (void)addHeatmapFromBinaryDataset {
+  // Convert the JSON once; later launches map the binary file into memory without parsing it.
+  NSURL *jsonURL = [NSBundle.mainBundle URLForResource:@"police_stations" withExtension:@"json"];
+  NSURL *cachesURL = [NSFileManager.defaultManager URLsForDirectory:NSCachesDirectory
+                                                          inDomains:NSUserDomainMask]
+                         .firstObject;
+  NSURL *datasetURL = [cachesURL URLByAppendingPathComponent:@"police_stations.points"];
+  PointDataset *dataset = [[PointDataset alloc] initWithContentsOfURL:datasetURL error:nil];
+  if (!dataset) {
+    [PointDataset convertJSONAtURL:jsonURL toURL:datasetURL quantized:NO error:nil];
+    dataset = [[PointDataset alloc] initWithContentsOfURL:datasetURL error:nil];
+  }
+
+  // The columns can be read directly, without creating an object per point.
+  double totalWeight = 0;
+  for (NSUInteger i = 0; i < dataset.count; i++) {
+    totalWeight += dataset.weights[i];
+  }
+  NSLog(@"%lu points, total weight %lf", (unsigned long)dataset.count, totalWeight);
+
+  _heatmapLayer.weightedData = [dataset weightedData];
+}
+// [END maps_ios_heatmap_binary_dataset]
+
+// [START maps_ios_heatmap_aggregated]
+- (void)addAggregatedHeatmap:(PointDataset *)dataset {
+  // Sum the points within each 100 m cell. Up to zoom 10, no point moves by more than a pixel.
+  PointDataset *aggregated = [dataset datasetByAggregatingToCellSize:100];
+  NSLog(@"Aggregated %lu points into %lu, a compression ratio of %.1f",
+        (unsigned long)dataset.count, (unsigned long)aggregated.count,
+        (double)dataset.count / MAX(aggregated.count, 1));
+  _heatmapLayer.weightedData = [aggregated weightedData];
+}
+// [END maps_ios_heatmap_aggregated]
 // [END_EXCLUDE]
 
 - (void) addHeatmap {
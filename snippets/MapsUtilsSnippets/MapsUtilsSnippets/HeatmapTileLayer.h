@@ -0,0 +1,61 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+@import GoogleMaps;
+@import GoogleMapsUtils;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A heatmap tile layer that renders each tile as a whole, instead of stamping a kernel around
+ * every point the tile covers.
+ *
+ * The points are indexed once in a PointQuadTree on the unit Web Mercator square. A tile gathers
+ * the points within its bounds plus the blur radius and adds their intensities into a grid of
+ * pixels. It then blurs the grid with a Gaussian one axis at a time, and maps the result through a
+ * 256-entry table built from the gradient. Both the blur and the mapping run as Accelerate vector
+ * operations, so a tile costs the same however many points fall in it.
+ *
+ * The properties match GMUHeatmapTileLayer's, and like it, intensities are scaled by the largest
+ * sum of intensities within a cell twice the radius wide, taken at each zoom from
+ * |minimumZoomIntensity| to |maximumZoomIntensity|.
+ *
+ * Setting a property only marks the layer out of date and clears its tile cache. The points are
+ * indexed again when the next tile is requested, so setting several properties in a row costs one
+ * rebuild, and that rebuild runs on a tile thread rather than on the caller's.
+ */
+@interface HeatmapTileLayer : GMSSyncTileLayer
+
+/** The points to render. */
+@property(nonatomic, copy) NSArray<GMUWeightedLatLng *> *weightedData;
+
+/** The blur radius in pixels, from 10 to 50. Defaults to 20. */
+@property(nonatomic) NSUInteger radius;
+
+/** The gradient intensities are coloured with. Defaults to green through red. */
+@property(nonatomic) GMUGradient *gradient;
+
+/** The lowest zoom the maximum intensity is taken at; lower zooms share it. Defaults to 5. */
+@property(nonatomic) NSUInteger minimumZoomIntensity;
+
+/** The highest zoom the maximum intensity is taken at; higher zooms share it. Defaults to 10. */
+@property(nonatomic) NSUInteger maximumZoomIntensity;
+
+@end
+
+NS_ASSUME_NONNULL_END
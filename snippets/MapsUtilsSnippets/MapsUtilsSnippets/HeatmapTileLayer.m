@@ -0,0 +1,371 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "HeatmapTileLayer.h"
+
+@import Accelerate;
+
+#include <math.h>
+
+#import "MapGeometry.h"
+#import "PointQuadTree.h"
+
+// Width of a tile, in pixels.
+static const NSUInteger kTileSize = 256;
+
+static const NSUInteger kDefaultRadius = 20;
+static const NSUInteger kMinimumRadius = 10;
+static const NSUInteger kMaximumRadius = 50;
+
+static const NSUInteger kDefaultMinimumZoomIntensity = 5;
+static const NSUInteger kDefaultMaximumZoomIntensity = 10;
+
+// Entries in the table intensities are coloured through.
+static const NSUInteger kColorMapSize = 256;
+
+// Points a tile gathers before its buffer grows.
+static const NSUInteger kInitialPointCapacity = 4096;
+
+static const uint64_t kEmptyCell = UINT64_MAX;
+
+/**
+ * Returns the largest sum of intensities within one cell of a grid |cellsPerSide| cells wide over
+ * the unit square. The sums are kept in an open-addressing table of |capacity| cells, a power of
+ * two at least twice |count|, so this takes one pass over the points.
+ */
+static float MaximumCellIntensity(const GQTPoint *points, const float *intensities,
+                                  NSUInteger count, double cellsPerSide, uint64_t *cells,
+                                  float *sums, NSUInteger capacity) {
+  for (NSUInteger i = 0; i < capacity; i++) {
+    cells[i] = kEmptyCell;
+  }
+  uint64_t side = (uint64_t)cellsPerSide;
+  float maximum = 0;
+  for (NSUInteger i = 0; i < count; i++) {
+    uint64_t column = MIN((uint64_t)(points[i].x * cellsPerSide), side - 1);
+    uint64_t row = MIN((uint64_t)(points[i].y * cellsPerSide), side - 1);
+    uint64_t cell = row * side + column;
+    NSUInteger slot = (NSUInteger)((cell * 0x9E3779B97F4A7C15ull) >> 32) & (capacity - 1);
+    while (cells[slot] != kEmptyCell && cells[slot] != cell) {
+      slot = (slot + 1) & (capacity - 1);
+    }
+    if (cells[slot] == kEmptyCell) {
+      cells[slot] = cell;
+      sums[slot] = 0;
+    }
+    sums[slot] += intensities[i];
+    maximum = MAX(maximum, sums[slot]);
+  }
+  return maximum;
+}
+
+/**
+ * Everything a tile is rendered from, which is replaced rather than changed, so tiles rendering on
+ * other threads keep a consistent view.
+ */
+@interface HeatmapTileSource : NSObject
+
+- (instancetype)initWithWeightedData:(NSArray<GMUWeightedLatLng *> *)weightedData
+                              radius:(NSUInteger)radius
+                            gradient:(GMUGradient *)gradient
+                minimumZoomIntensity:(NSUInteger)minimumZoomIntensity
+                maximumZoomIntensity:(NSUInteger)maximumZoomIntensity;
+
+/** Returns the tile's image, or nil if no point is close enough to colour it. */
+- (nullable UIImage *)tileForX:(NSUInteger)x y:(NSUInteger)y zoom:(NSUInteger)zoom;
+
+@end
+
+@implementation HeatmapTileSource {
+  NSUInteger _radius;
+  NSUInteger _minimumZoomIntensity;
+  NSUInteger _maximumZoomIntensity;
+  PointQuadTree *_tree;
+
+  // Each point's position on the unit Web Mercator square and intensity, by tree index.
+  NSMutableData *_points;
+  NSMutableData *_intensities;
+
+  // The Gaussian's weights from -radius to radius, peaking at 1.
+  NSMutableData *_kernel;
+
+  // RGBA bytes, premultiplied, for each colour map entry; entry 0 is transparent.
+  NSMutableData *_colors;
+
+  // The maximum intensity at each zoom from |_minimumZoomIntensity| to |_maximumZoomIntensity|.
+  NSMutableData *_maximumIntensities;
+}
+
+- (instancetype)initWithWeightedData:(NSArray<GMUWeightedLatLng *> *)weightedData
+                              radius:(NSUInteger)radius
+                            gradient:(GMUGradient *)gradient
+                minimumZoomIntensity:(NSUInteger)minimumZoomIntensity
+                maximumZoomIntensity:(NSUInteger)maximumZoomIntensity {
+  if ((self = [super init])) {
+    _radius = radius;
+    _minimumZoomIntensity = minimumZoomIntensity;
+    _maximumZoomIntensity = MAX(maximumZoomIntensity, minimumZoomIntensity);
+
+    NSUInteger count = weightedData.count;
+    _points = [NSMutableData dataWithLength:count * sizeof(GQTPoint)];
+    _intensities = [NSMutableData dataWithLength:count * sizeof(float)];
+    GQTPoint *points = _points.mutableBytes;
+    float *intensities = _intensities.mutableBytes;
+    [weightedData enumerateObjectsUsingBlock:^(GMUWeightedLatLng *weightedLatLng, NSUInteger idx,
+                                               BOOL *stop) {
+      GQTPoint point = weightedLatLng.point;
+      ProjectCoordinate(GMSUnproject((GMSMapPoint){point.x, point.y}), &points[idx].x,
+                        &points[idx].y);
+      intensities[idx] = weightedLatLng.intensity;
+    }];
+    _tree = [[PointQuadTree alloc] initWithBounds:(GQTBounds){0, 0, 1, 1}
+                                           points:points
+                                            count:count];
+
+    // Matches GMUHeatmapTileLayer, whose kernel spreads a point over three standard deviations.
+    double sigma = radius / 3.0;
+    _kernel = [NSMutableData dataWithLength:(2 * radius + 1) * sizeof(float)];
+    float *kernel = _kernel.mutableBytes;
+    for (NSInteger i = -(NSInteger)radius; i <= (NSInteger)radius; i++) {
+      kernel[i + radius] = (float)exp(-i * i / (2 * sigma * sigma));
+    }
+
+    NSArray<UIColor *> *colorMap = [gradient generateColorMap];
+    _colors = [NSMutableData dataWithLength:kColorMapSize * 4];
+    uint8_t *colors = _colors.mutableBytes;
+    for (NSUInteger i = 1; i < kColorMapSize && colorMap.count > 0; i++) {
+      UIColor *color = colorMap[i * (colorMap.count - 1) / (kColorMapSize - 1)];
+      CGFloat red = 0, green = 0, blue = 0, alpha = 0;
+      [color getRed:&red green:&green blue:&blue alpha:&alpha];
+      colors[4 * i] = (uint8_t)lround(red * alpha * 255);
+      colors[4 * i + 1] = (uint8_t)lround(green * alpha * 255);
+      colors[4 * i + 2] = (uint8_t)lround(blue * alpha * 255);
+      colors[4 * i + 3] = (uint8_t)lround(alpha * 255);
+    }
+
+    NSUInteger zoomCount = _maximumZoomIntensity - _minimumZoomIntensity + 1;
+    _maximumIntensities = [NSMutableData dataWithLength:zoomCount * sizeof(float)];
+    float *maximumIntensities = _maximumIntensities.mutableBytes;
+    NSUInteger capacity = 1;
+    while (capacity < 2 * count) {
+      capacity *= 2;
+    }
+    NSMutableData *cells = [NSMutableData dataWithLength:capacity * sizeof(uint64_t)];
+    NSMutableData *sums = [NSMutableData dataWithLength:capacity * sizeof(float)];
+    for (NSUInteger i = 0; i < zoomCount; i++) {
+      double cellsPerSide = ceil(ldexp(kTileSize, (int)(_minimumZoomIntensity + i)) / (2 * radius));
+      maximumIntensities[i] = MaximumCellIntensity(points, intensities, count, cellsPerSide,
+                                                   cells.mutableBytes, sums.mutableBytes, capacity);
+    }
+  }
+  return self;
+}
+
+- (nullable UIImage *)tileForX:(NSUInteger)x y:(NSUInteger)y zoom:(NSUInteger)zoom {
+  NSUInteger zoomIndex =
+      MIN(MAX(zoom, _minimumZoomIntensity), _maximumZoomIntensity) - _minimumZoomIntensity;
+  float maximumIntensity = ((const float *)_maximumIntensities.bytes)[zoomIndex];
+  if (maximumIntensity <= 0) {
+    return nil;
+  }
+
+  // The grid covers the tile and a border of |_radius| pixels, so points just outside still blur
+  // into it.
+  NSUInteger radius = _radius;
+  NSUInteger gridSize = kTileSize + 2 * radius;
+  double pixelsPerUnit = ldexp(kTileSize, (int)zoom);
+  double originX = (double)x * kTileSize - radius;
+  double originY = (double)y * kTileSize - radius;
+  GQTBounds bounds = {originX / pixelsPerUnit, originY / pixelsPerUnit,
+                      (originX + gridSize) / pixelsPerUnit, (originY + gridSize) / pixelsPerUnit};
+  NSMutableData *gridData = [NSMutableData dataWithLength:gridSize * gridSize * sizeof(float)];
+  float *grid = gridData.mutableBytes;
+  const GQTPoint *points = _points.bytes;
+  const float *intensities = _intensities.bytes;
+
+  // Borders that reach past the antimeridian also take the points a world away on the other side.
+  NSUInteger capacity = kInitialPointCapacity;
+  NSMutableData *indexData = [NSMutableData dataWithLength:capacity * sizeof(uint32_t)];
+  NSUInteger binned = 0;
+  for (NSInteger shift = -1; shift <= 1; shift++) {
+    GQTBounds searchBounds = {bounds.minX + shift, bounds.minY, bounds.maxX + shift, bounds.maxY};
+    if (searchBounds.maxX < 0 || searchBounds.minX > 1) {
+      continue;
+    }
+    NSUInteger count = [_tree searchWithBounds:searchBounds
+                                       indices:indexData.mutableBytes
+                                      capacity:capacity];
+    if (count > capacity) {
+      capacity = count;
+      indexData.length = capacity * sizeof(uint32_t);
+      count = [_tree searchWithBounds:searchBounds
+                              indices:indexData.mutableBytes
+                             capacity:capacity];
+    }
+    const uint32_t *indices = indexData.bytes;
+    for (NSUInteger i = 0; i < count; i++) {
+      GQTPoint point = points[indices[i]];
+      double column = (point.x - shift) * pixelsPerUnit - originX;
+      double row = point.y * pixelsPerUnit - originY;
+      NSUInteger gridColumn = MIN((NSUInteger)fmax(column, 0), gridSize - 1);
+      NSUInteger gridRow = MIN((NSUInteger)fmax(row, 0), gridSize - 1);
+      grid[gridRow * gridSize + gridColumn] += intensities[indices[i]];
+    }
+    binned += count;
+  }
+  if (binned == 0) {
+    return nil;
+  }
+
+  // Blur each row of the grid into the tile's columns, then each column into the tile's rows.
+  const float *kernel = _kernel.bytes;
+  NSUInteger kernelSize = 2 * radius + 1;
+  NSMutableData *rowBlurData = [NSMutableData dataWithLength:gridSize * kTileSize * sizeof(float)];
+  float *rowBlur = rowBlurData.mutableBytes;
+  for (NSUInteger row = 0; row < gridSize; row++) {
+    vDSP_conv(grid + row * gridSize, 1, kernel, 1, rowBlur + row * kTileSize, 1, kTileSize,
+              kernelSize);
+  }
+  NSMutableData *blurData = [NSMutableData dataWithLength:kTileSize * kTileSize * sizeof(float)];
+  float *blur = blurData.mutableBytes;
+  for (NSUInteger row = 0; row < kTileSize; row++) {
+    float *output = blur + row * kTileSize;
+    for (NSUInteger k = 0; k < kernelSize; k++) {
+      vDSP_vsma(rowBlur + (row + k) * kTileSize, 1, kernel + k, output, 1, output, 1, kTileSize);
+    }
+  }
+
+  // Scale intensities to colour map entries in place, then look each one up.
+  NSUInteger pixelCount = kTileSize * kTileSize;
+  float largest = 0;
+  vDSP_maxv(blur, 1, &largest, pixelCount);
+  if (largest <= 0) {
+    return nil;
+  }
+  float scale = (kColorMapSize - 1) / maximumIntensity;
+  float lowest = 0;
+  float highest = kColorMapSize - 1;
+  vDSP_vsmul(blur, 1, &scale, blur, 1, pixelCount);
+  vDSP_vclip(blur, 1, &lowest, &highest, blur, 1, pixelCount);
+  NSMutableData *entryData = [NSMutableData dataWithLength:pixelCount];
+  uint8_t *entries = entryData.mutableBytes;
+  vDSP_vfixu8(blur, 1, entries, 1, pixelCount);
+  NSMutableData *pixelData = [NSMutableData dataWithLength:pixelCount * sizeof(uint32_t)];
+  uint32_t *pixels = pixelData.mutableBytes;
+  const uint32_t *colors = _colors.bytes;
+  for (NSUInteger i = 0; i < pixelCount; i++) {
+    pixels[i] = colors[entries[i]];
+  }
+
+  CGDataProviderRef provider = CGDataProviderCreateWithCFData((__bridge CFDataRef)pixelData);
+  CGColorSpaceRef colorSpace = CGColorSpaceCreateWithName(kCGColorSpaceSRGB);
+  CGImageRef image = CGImageCreate(kTileSize, kTileSize, 8, 32, kTileSize * 4, colorSpace,
+                                   kCGImageAlphaPremultipliedLast | kCGBitmapByteOrder32Big,
+                                   provider, NULL, NO, kCGRenderingIntentDefault);
+  UIImage *tile = [UIImage imageWithCGImage:image];
+  CGImageRelease(image);
+  CGColorSpaceRelease(colorSpace);
+  CGDataProviderRelease(provider);
+  return tile;
+}
+
+@end
+
+@implementation HeatmapTileLayer {
+  // Built from the properties by the first tile request after they change, and nil until then.
+  // Guarded by @synchronized(self), along with the properties it is built from.
+  HeatmapTileSource *_source;
+}
+
+- (instancetype)init {
+  if ((self = [super init])) {
+    _weightedData = @[];
+    _radius = kDefaultRadius;
+    _gradient = [[GMUGradient alloc]
+          initWithColors:@[
+            [UIColor colorWithRed:102.f / 255.f green:225.f / 255.f blue:0 alpha:1],
+            [UIColor colorWithRed:1 green:0 blue:0 alpha:1]
+          ]
+             startPoints:@[ @0.2f, @1.0f ]
+            colorMapSize:kColorMapSize];
+    _minimumZoomIntensity = kDefaultMinimumZoomIntensity;
+    _maximumZoomIntensity = kDefaultMaximumZoomIntensity;
+  }
+  return self;
+}
+
+- (void)setWeightedData:(NSArray<GMUWeightedLatLng *> *)weightedData {
+  @synchronized(self) {
+    _weightedData = [weightedData copy];
+    _source = nil;
+  }
+  [self clearTileCache];
+}
+
+- (void)setRadius:(NSUInteger)radius {
+  @synchronized(self) {
+    _radius = MIN(MAX(radius, kMinimumRadius), kMaximumRadius);
+    _source = nil;
+  }
+  [self clearTileCache];
+}
+
+- (void)setGradient:(GMUGradient *)gradient {
+  @synchronized(self) {
+    _gradient = gradient;
+    _source = nil;
+  }
+  [self clearTileCache];
+}
+
+- (void)setMinimumZoomIntensity:(NSUInteger)minimumZoomIntensity {
+  @synchronized(self) {
+    _minimumZoomIntensity = minimumZoomIntensity;
+    _source = nil;
+  }
+  [self clearTileCache];
+}
+
+- (void)setMaximumZoomIntensity:(NSUInteger)maximumZoomIntensity {
+  @synchronized(self) {
+    _maximumZoomIntensity = maximumZoomIntensity;
+    _source = nil;
+  }
+  [self clearTileCache];
+}
+
+- (UIImage *)tileForX:(NSUInteger)x y:(NSUInteger)y zoom:(NSUInteger)zoom {
+  return [[self currentSource] tileForX:x y:y zoom:zoom] ?: kGMSTileLayerNoTile;
+}
+
+#pragma mark - Private
+
+/**
+ * Returns the source tiles are rendered from, building it first if a property has changed since
+ * the last tile. Tiles requested meanwhile on other threads wait for the one build.
+ */
+- (HeatmapTileSource *)currentSource {
+  @synchronized(self) {
+    if (!_source) {
+      _source = [[HeatmapTileSource alloc] initWithWeightedData:_weightedData
+                                                         radius:_radius
+                                                       gradient:_gradient
+                                           minimumZoomIntensity:_minimumZoomIntensity
+                                           maximumZoomIntensity:_maximumZoomIntensity];
+    }
+    return _source;
+  }
+}
+
+@end
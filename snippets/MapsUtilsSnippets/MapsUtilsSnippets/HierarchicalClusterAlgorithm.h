@@ -0,0 +1,66 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+@import GoogleMaps;
+@import GoogleMapsUtils;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A cluster algorithm that clusters every zoom level once, instead of starting over whenever the
+ * zoom changes.
+ *
+ * The first query after items change builds the whole hierarchy. Each zoom level, from
+ * |maximumZoom| down to 0, is made by greedily merging clusters of the level above that lie within
+ * |clusterDistance| of each other, found through a KD-tree over that level. Every cluster keeps
+ * the clusters it was merged from. After that, the clusters at a zoom are only created the first
+ * time that zoom is asked for, a viewport query costs only the clusters it finds, and expanding a
+ * cluster costs only its children.
+ *
+ * Unlike the Swift HierarchicalClusterAlgorithm in MapsAndPlacesDemo, which updates only the
+ * clusters an inserted, removed or moved item belongs to, this snippet is not incremental: adding,
+ * removing or clearing items drops the hierarchy, and the next query rebuilds all of it. It suits
+ * item sets that are loaded once and then only queried.
+ */
+@interface HierarchicalClusterAlgorithm : NSObject <GMUClusterAlgorithm>
+
+/** Zoom level above which items are no longer clustered. */
+@property(nonatomic, readonly) NSUInteger maximumZoom;
+
+/** Distance in screen points within which clusters merge. */
+@property(nonatomic, readonly) CGFloat clusterDistance;
+
+/** Clusters up to zoom level 20, merging within 100 points like the non-hierarchical algorithm. */
+- (instancetype)init;
+
+- (instancetype)initWithMaximumZoom:(NSUInteger)maximumZoom
+                    clusterDistance:(CGFloat)clusterDistance NS_DESIGNATED_INITIALIZER;
+
+/** Returns the clusters at |zoom| whose positions lie within |bounds|. */
+- (NSArray<id<GMUCluster>> *)clustersInBounds:(GMSCoordinateBounds *)bounds zoom:(float)zoom;
+
+/**
+ * Returns the clusters |cluster| splits into as the map zooms in, skipping any zoom levels at
+ * which it stays whole. |cluster| must have come from this algorithm since its items last
+ * changed; an empty array is returned for any other cluster, and for single items.
+ */
+- (NSArray<id<GMUCluster>> *)childrenOfCluster:(id<GMUCluster>)cluster;
+
+@end
+
+NS_ASSUME_NONNULL_END
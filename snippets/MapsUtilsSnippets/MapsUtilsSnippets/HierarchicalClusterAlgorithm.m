@@ -0,0 +1,594 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "HierarchicalClusterAlgorithm.h"
+
+#include <math.h>
+
+#import "MapGeometry.h"
+
+// Width of the whole world, in points, at zoom level 0.
+static const double kWorldSize = 256;
+
+static const NSUInteger kDefaultMaximumZoom = 20;
+
+// The distance GMUNonHierarchicalDistanceBasedAlgorithm clusters within.
+static const CGFloat kDefaultClusterDistance = 100;
+
+// KD-tree ranges this small are scanned instead of split further.
+static const NSInteger kNodeSize = 64;
+
+// Ranges a KD-tree search keeps pending. Each step replaces one range with at most two halves, so
+// this only needs to exceed the tree's depth.
+static const NSUInteger kSearchStackCapacity = 64;
+
+// Neighbours a merge collects before its buffer grows.
+static const NSUInteger kInitialNeighbourCapacity = 256;
+
+typedef struct {
+  NSInteger left;
+  NSInteger right;
+  NSUInteger axis;
+} KDRange;
+
+/** Swaps entries |i| and |j| of a KD-tree. */
+static void SwapEntries(uint32_t *indices, double *coordinates, NSInteger i, NSInteger j) {
+  uint32_t index = indices[i];
+  indices[i] = indices[j];
+  indices[j] = index;
+  double x = coordinates[2 * i];
+  double y = coordinates[2 * i + 1];
+  coordinates[2 * i] = coordinates[2 * j];
+  coordinates[2 * i + 1] = coordinates[2 * j + 1];
+  coordinates[2 * j] = x;
+  coordinates[2 * j + 1] = y;
+}
+
+/**
+ * Reorders entries |left| to |right| so that entry |k| holds the value on |axis| a full sort would
+ * put there, with no larger value before it and no smaller one after it. This is Floyd and Rivest's
+ * selection, which samples a narrower range around |k| first when the range is large.
+ */
+static void SelectEntry(uint32_t *indices, double *coordinates, NSInteger k, NSInteger left,
+                        NSInteger right, NSUInteger axis) {
+  while (right > left) {
+    if (right - left > 600) {
+      double n = right - left + 1;
+      double m = k - left + 1;
+      double z = log(n);
+      double s = 0.5 * exp(2 * z / 3);
+      double sd = 0.5 * sqrt(z * s * (n - s) / n) * (m - n / 2 < 0 ? -1 : 1);
+      NSInteger sampleLeft = MAX(left, (NSInteger)floor(k - m * s / n + sd));
+      NSInteger sampleRight = MIN(right, (NSInteger)floor(k + (n - m) * s / n + sd));
+      SelectEntry(indices, coordinates, k, sampleLeft, sampleRight, axis);
+    }
+    double pivot = coordinates[2 * k + axis];
+    NSInteger i = left;
+    NSInteger j = right;
+    SwapEntries(indices, coordinates, left, k);
+    if (coordinates[2 * right + axis] > pivot) {
+      SwapEntries(indices, coordinates, left, right);
+    }
+    while (i < j) {
+      SwapEntries(indices, coordinates, i, j);
+      i++;
+      j--;
+      while (coordinates[2 * i + axis] < pivot) {
+        i++;
+      }
+      while (coordinates[2 * j + axis] > pivot) {
+        j--;
+      }
+    }
+    if (coordinates[2 * left + axis] == pivot) {
+      SwapEntries(indices, coordinates, left, j);
+    } else {
+      j++;
+      SwapEntries(indices, coordinates, j, right);
+    }
+    if (j <= k) {
+      left = j + 1;
+    }
+    if (k <= j) {
+      right = j - 1;
+    }
+  }
+}
+
+/**
+ * Arranges entries |left| to |right| into a KD-tree: the middle entry splits the range on |axis|,
+ * and each half is split the same way on the other axis, until ranges are down to kNodeSize.
+ */
+static void BuildKDTree(uint32_t *indices, double *coordinates, NSInteger left, NSInteger right,
+                        NSUInteger axis) {
+  if (right - left <= kNodeSize) {
+    return;
+  }
+  NSInteger middle = (left + right) / 2;
+  SelectEntry(indices, coordinates, middle, left, right, axis);
+  BuildKDTree(indices, coordinates, left, middle - 1, 1 - axis);
+  BuildKDTree(indices, coordinates, middle + 1, right, 1 - axis);
+}
+
+/**
+ * Finds the KD-tree entries within the box from |minX|, |minY| to |maxX|, |maxY|, writing up to
+ * |capacity| of their positions in the tree to |found|.
+ *
+ * @return The number of entries found, which may exceed |capacity|.
+ */
+static NSUInteger SearchKDTree(const double *coordinates, NSUInteger count, double minX,
+                               double minY, double maxX, double maxY, uint32_t *found,
+                               NSUInteger capacity) {
+  if (count == 0) {
+    return 0;
+  }
+  KDRange stack[kSearchStackCapacity];
+  NSUInteger depth = 0;
+  stack[depth++] = (KDRange){0, (NSInteger)count - 1, 0};
+  NSUInteger foundCount = 0;
+  while (depth > 0) {
+    KDRange range = stack[--depth];
+    if (range.right - range.left <= kNodeSize) {
+      for (NSInteger i = range.left; i <= range.right; i++) {
+        double x = coordinates[2 * i];
+        double y = coordinates[2 * i + 1];
+        if (x >= minX && x <= maxX && y >= minY && y <= maxY) {
+          if (foundCount < capacity) {
+            found[foundCount] = (uint32_t)i;
+          }
+          foundCount++;
+        }
+      }
+      continue;
+    }
+    NSInteger middle = (range.left + range.right) / 2;
+    double x = coordinates[2 * middle];
+    double y = coordinates[2 * middle + 1];
+    if (x >= minX && x <= maxX && y >= minY && y <= maxY) {
+      if (foundCount < capacity) {
+        found[foundCount] = (uint32_t)middle;
+      }
+      foundCount++;
+    }
+    double split = range.axis == 0 ? x : y;
+    if ((range.axis == 0 ? minX : minY) <= split) {
+      stack[depth++] = (KDRange){range.left, middle - 1, 1 - range.axis};
+    }
+    if ((range.axis == 0 ? maxX : maxY) >= split) {
+      stack[depth++] = (KDRange){middle + 1, range.right, 1 - range.axis};
+    }
+  }
+  return foundCount;
+}
+
+/**
+ * The clusters at one zoom level. Cluster |i| merges clusters |children[childOffsets[i]]| up to
+ * |children[childOffsets[i + 1]]| of the level above; the level above the highest zoom holds the
+ * items themselves, and has no children.
+ */
+@interface ClusterLevel : NSObject
+
+@property(nonatomic, readonly) NSUInteger count;
+@property(nonatomic, readonly) NSMutableData *latitudes;
+@property(nonatomic, readonly) NSMutableData *longitudes;
+// Number of items in each cluster.
+@property(nonatomic, readonly) NSMutableData *itemCounts;
+@property(nonatomic, readonly) NSMutableData *childOffsets;
+@property(nonatomic, readonly) NSMutableData *children;
+// The clusters' Web Mercator coordinates as a KD-tree, with the cluster at each position.
+@property(nonatomic, readonly) NSMutableData *treeCoordinates;
+@property(nonatomic, readonly) NSMutableData *treeIndices;
+
+- (instancetype)initWithCount:(NSUInteger)count;
+
+@end
+
+@implementation ClusterLevel
+
+- (instancetype)initWithCount:(NSUInteger)count {
+  if ((self = [super init])) {
+    _count = count;
+    _latitudes = [NSMutableData dataWithLength:count * sizeof(double)];
+    _longitudes = [NSMutableData dataWithLength:count * sizeof(double)];
+    _itemCounts = [NSMutableData dataWithLength:count * sizeof(uint32_t)];
+    _childOffsets = [NSMutableData dataWithLength:(count + 1) * sizeof(uint32_t)];
+    _children = [NSMutableData data];
+    _treeCoordinates = [NSMutableData dataWithLength:2 * count * sizeof(double)];
+    _treeIndices = [NSMutableData dataWithLength:count * sizeof(uint32_t)];
+  }
+  return self;
+}
+
+/** Builds the KD-tree once |treeCoordinates| holds every cluster's coordinates in order. */
+- (void)buildTree {
+  uint32_t *indices = _treeIndices.mutableBytes;
+  for (NSUInteger i = 0; i < _count; i++) {
+    indices[i] = (uint32_t)i;
+  }
+  BuildKDTree(indices, _treeCoordinates.mutableBytes, 0, (NSInteger)_count - 1, 0);
+}
+
+@end
+
+/** Every zoom level's clusters over one set of items. Level |maximumZoom + 1| is the items. */
+@interface ClusterHierarchy : NSObject
+
+@property(nonatomic, readonly) NSArray<id<GMUClusterItem>> *items;
+@property(nonatomic, readonly) NSArray<ClusterLevel *> *levels;
+
+- (instancetype)initWithItems:(NSArray<id<GMUClusterItem>> *)items
+                  maximumZoom:(NSUInteger)maximumZoom
+              clusterDistance:(CGFloat)clusterDistance;
+
+@end
+
+@implementation ClusterHierarchy
+
+- (instancetype)initWithItems:(NSArray<id<GMUClusterItem>> *)items
+                  maximumZoom:(NSUInteger)maximumZoom
+              clusterDistance:(CGFloat)clusterDistance {
+  if ((self = [super init])) {
+    _items = [items copy];
+    NSMutableArray<ClusterLevel *> *levels = [NSMutableArray array];
+    ClusterLevel *itemLevel = [[ClusterLevel alloc] initWithCount:_items.count];
+    double *latitudes = itemLevel.latitudes.mutableBytes;
+    double *longitudes = itemLevel.longitudes.mutableBytes;
+    uint32_t *itemCounts = itemLevel.itemCounts.mutableBytes;
+    double *coordinates = itemLevel.treeCoordinates.mutableBytes;
+    for (NSUInteger i = 0; i < _items.count; i++) {
+      CLLocationCoordinate2D position = _items[i].position;
+      latitudes[i] = position.latitude;
+      longitudes[i] = position.longitude;
+      itemCounts[i] = 1;
+      ProjectCoordinate(position, &coordinates[2 * i], &coordinates[2 * i + 1]);
+    }
+    [itemLevel buildTree];
+    [levels addObject:itemLevel];
+    for (NSUInteger zoom = maximumZoom + 1; zoom-- > 0;) {
+      // One screen point covers 1 / (kWorldSize * 2^zoom) of the unit square.
+      double radius = clusterDistance / ldexp(kWorldSize, (int)zoom);
+      [levels insertObject:[ClusterHierarchy levelByMergingLevel:levels.firstObject radius:radius]
+                   atIndex:0];
+    }
+    _levels = levels;
+  }
+  return self;
+}
+
+/**
+ * Merges the clusters of |level| within |radius| of each other. Clusters are visited in KD-tree
+ * order, and each one not yet merged absorbs every unmerged cluster within |radius| of it,
+ * positioned at their centroid weighted by item count.
+ */
++ (ClusterLevel *)levelByMergingLevel:(ClusterLevel *)level radius:(double)radius {
+  NSUInteger count = level.count;
+  const double *coordinates = level.treeCoordinates.bytes;
+  const uint32_t *indices = level.treeIndices.bytes;
+  const double *latitudes = level.latitudes.bytes;
+  const double *longitudes = level.longitudes.bytes;
+  const uint32_t *itemCounts = level.itemCounts.bytes;
+  NSMutableData *mergedData = [NSMutableData dataWithLength:count];
+  uint8_t *merged = mergedData.mutableBytes;
+  NSMutableData *neighbourData =
+      [NSMutableData dataWithLength:kInitialNeighbourCapacity * sizeof(uint32_t)];
+
+  // Parents are gathered in order of appearance, at most one per cluster.
+  NSMutableData *parentLatitudes = [NSMutableData dataWithLength:count * sizeof(double)];
+  NSMutableData *parentLongitudes = [NSMutableData dataWithLength:count * sizeof(double)];
+  NSMutableData *parentItemCounts = [NSMutableData dataWithLength:count * sizeof(uint32_t)];
+  NSMutableData *parentOffsets = [NSMutableData dataWithLength:(count + 1) * sizeof(uint32_t)];
+  NSMutableData *parentCoordinates = [NSMutableData dataWithLength:2 * count * sizeof(double)];
+  NSMutableData *children = [NSMutableData dataWithLength:count * sizeof(uint32_t)];
+  double *outLatitudes = parentLatitudes.mutableBytes;
+  double *outLongitudes = parentLongitudes.mutableBytes;
+  uint32_t *outItemCounts = parentItemCounts.mutableBytes;
+  uint32_t *outOffsets = parentOffsets.mutableBytes;
+  double *outCoordinates = parentCoordinates.mutableBytes;
+  uint32_t *outChildren = children.mutableBytes;
+  NSUInteger parentCount = 0;
+  NSUInteger childCount = 0;
+  for (NSUInteger position = 0; position < count; position++) {
+    uint32_t index = indices[position];
+    if (merged[index]) {
+      continue;
+    }
+    merged[index] = 1;
+    double x = coordinates[2 * position];
+    double y = coordinates[2 * position + 1];
+    double weight = itemCounts[index];
+    double sumX = x * weight;
+    double sumY = y * weight;
+    uint32_t total = itemCounts[index];
+    outOffsets[parentCount] = (uint32_t)childCount;
+    outChildren[childCount++] = index;
+
+    NSUInteger capacity = neighbourData.length / sizeof(uint32_t);
+    NSUInteger found = SearchKDTree(coordinates, count, x - radius, y - radius, x + radius,
+                                    y + radius, neighbourData.mutableBytes, capacity);
+    if (found > capacity) {
+      neighbourData.length = found * sizeof(uint32_t);
+      SearchKDTree(coordinates, count, x - radius, y - radius, x + radius, y + radius,
+                   neighbourData.mutableBytes, found);
+    }
+    const uint32_t *neighbours = neighbourData.bytes;
+    for (NSUInteger i = 0; i < found; i++) {
+      uint32_t neighbour = neighbours[i];
+      uint32_t neighbourIndex = indices[neighbour];
+      double dx = coordinates[2 * neighbour] - x;
+      double dy = coordinates[2 * neighbour + 1] - y;
+      if (merged[neighbourIndex] || dx * dx + dy * dy > radius * radius) {
+        continue;
+      }
+      merged[neighbourIndex] = 1;
+      double neighbourWeight = itemCounts[neighbourIndex];
+      sumX += coordinates[2 * neighbour] * neighbourWeight;
+      sumY += coordinates[2 * neighbour + 1] * neighbourWeight;
+      total += itemCounts[neighbourIndex];
+      outChildren[childCount++] = neighbourIndex;
+    }
+
+    outItemCounts[parentCount] = total;
+    if (childCount - outOffsets[parentCount] == 1) {
+      // A cluster that merged with nothing keeps its exact position.
+      outLatitudes[parentCount] = latitudes[index];
+      outLongitudes[parentCount] = longitudes[index];
+      outCoordinates[2 * parentCount] = x;
+      outCoordinates[2 * parentCount + 1] = y;
+    } else {
+      double centroidX = sumX / total;
+      double centroidY = sumY / total;
+      CLLocationCoordinate2D centroid = UnprojectPoint(centroidX, centroidY);
+      outLatitudes[parentCount] = centroid.latitude;
+      outLongitudes[parentCount] = centroid.longitude;
+      outCoordinates[2 * parentCount] = centroidX;
+      outCoordinates[2 * parentCount + 1] = centroidY;
+    }
+    parentCount++;
+  }
+  outOffsets[parentCount] = (uint32_t)childCount;
+
+  ClusterLevel *parents = [[ClusterLevel alloc] initWithCount:parentCount];
+  memcpy(parents.latitudes.mutableBytes, outLatitudes, parentCount * sizeof(double));
+  memcpy(parents.longitudes.mutableBytes, outLongitudes, parentCount * sizeof(double));
+  memcpy(parents.itemCounts.mutableBytes, outItemCounts, parentCount * sizeof(uint32_t));
+  memcpy(parents.childOffsets.mutableBytes, outOffsets, (parentCount + 1) * sizeof(uint32_t));
+  memcpy(parents.treeCoordinates.mutableBytes, outCoordinates, 2 * parentCount * sizeof(double));
+  [parents.children setData:children];
+  [parents buildTree];
+  return parents;
+}
+
+@end
+
+/** A cluster of a ClusterHierarchy, which gathers its items only when they are asked for. */
+@interface HierarchicalCluster : NSObject <GMUCluster>
+
+@property(nonatomic, readonly) ClusterHierarchy *hierarchy;
+@property(nonatomic, readonly) NSUInteger level;
+@property(nonatomic, readonly) NSUInteger index;
+
+- (instancetype)initWithHierarchy:(ClusterHierarchy *)hierarchy
+                            level:(NSUInteger)level
+                            index:(NSUInteger)index;
+
+@end
+
+@implementation HierarchicalCluster {
+  NSArray<id<GMUClusterItem>> *_items;
+}
+
+@synthesize position = _position;
+@synthesize count = _count;
+
+- (instancetype)initWithHierarchy:(ClusterHierarchy *)hierarchy
+                            level:(NSUInteger)level
+                            index:(NSUInteger)index {
+  if ((self = [super init])) {
+    _hierarchy = hierarchy;
+    _level = level;
+    _index = index;
+    ClusterLevel *clusterLevel = hierarchy.levels[level];
+    _position = CLLocationCoordinate2DMake(((const double *)clusterLevel.latitudes.bytes)[index],
+                                           ((const double *)clusterLevel.longitudes.bytes)[index]);
+    _count = ((const uint32_t *)clusterLevel.itemCounts.bytes)[index];
+  }
+  return self;
+}
+
+- (NSArray<id<GMUClusterItem>> *)items {
+  if (_items) {
+    return _items;
+  }
+  NSArray<ClusterLevel *> *levels = _hierarchy.levels;
+  NSUInteger itemLevel = levels.count - 1;
+  NSMutableArray<id<GMUClusterItem>> *items = [NSMutableArray arrayWithCapacity:_count];
+  // Walk down to the items, replacing each cluster with its children one level at a time.
+  NSMutableData *current = [NSMutableData dataWithBytes:&_index length:sizeof(NSUInteger)];
+  for (NSUInteger level = _level; level < itemLevel; level++) {
+    const uint32_t *offsets = levels[level].childOffsets.bytes;
+    const uint32_t *children = levels[level].children.bytes;
+    const NSUInteger *clusters = current.bytes;
+    NSMutableData *next = [NSMutableData data];
+    for (NSUInteger i = 0; i < current.length / sizeof(NSUInteger); i++) {
+      for (uint32_t child = offsets[clusters[i]]; child < offsets[clusters[i] + 1]; child++) {
+        NSUInteger childIndex = children[child];
+        [next appendBytes:&childIndex length:sizeof(childIndex)];
+      }
+    }
+    current = next;
+  }
+  const NSUInteger *itemIndices = current.bytes;
+  for (NSUInteger i = 0; i < current.length / sizeof(NSUInteger); i++) {
+    [items addObject:_hierarchy.items[itemIndices[i]]];
+  }
+  _items = items;
+  return _items;
+}
+
+@end
+
+@implementation HierarchicalClusterAlgorithm {
+  NSMutableArray<id<GMUClusterItem>> *_items;
+  // Built on the first query after the items change.
+  ClusterHierarchy *_hierarchy;
+  NSMutableDictionary<NSNumber *, NSArray<id<GMUCluster>> *> *_clustersByLevel;
+}
+
+- (instancetype)init {
+  return [self initWithMaximumZoom:kDefaultMaximumZoom clusterDistance:kDefaultClusterDistance];
+}
+
+- (instancetype)initWithMaximumZoom:(NSUInteger)maximumZoom
+                    clusterDistance:(CGFloat)clusterDistance {
+  if ((self = [super init])) {
+    _maximumZoom = maximumZoom;
+    _clusterDistance = clusterDistance;
+    _items = [NSMutableArray array];
+    _clustersByLevel = [NSMutableDictionary dictionary];
+  }
+  return self;
+}
+
+#pragma mark - GMUClusterAlgorithm
+
+- (void)addItems:(NSArray<id<GMUClusterItem>> *)items {
+  [_items addObjectsFromArray:items];
+  [self invalidate];
+}
+
+- (void)removeItem:(id<GMUClusterItem>)item {
+  [_items removeObject:item];
+  [self invalidate];
+}
+
+- (void)clearItems {
+  [_items removeAllObjects];
+  [self invalidate];
+}
+
+- (NSArray<id<GMUCluster>> *)clustersAtZoom:(float)zoom {
+  NSUInteger level = [self levelForZoom:zoom];
+  NSArray<id<GMUCluster>> *clusters = _clustersByLevel[@(level)];
+  if (clusters) {
+    return clusters;
+  }
+  ClusterHierarchy *hierarchy = [self hierarchy];
+  NSUInteger count = hierarchy.levels[level].count;
+  NSMutableArray<id<GMUCluster>> *levelClusters = [NSMutableArray arrayWithCapacity:count];
+  for (NSUInteger i = 0; i < count; i++) {
+    [levelClusters addObject:[[HierarchicalCluster alloc] initWithHierarchy:hierarchy
+                                                                      level:level
+                                                                      index:i]];
+  }
+  _clustersByLevel[@(level)] = levelClusters;
+  return levelClusters;
+}
+
+#pragma mark - Queries
+
+- (NSArray<id<GMUCluster>> *)clustersInBounds:(GMSCoordinateBounds *)bounds zoom:(float)zoom {
+  NSUInteger level = [self levelForZoom:zoom];
+  ClusterHierarchy *hierarchy = [self hierarchy];
+  ClusterLevel *clusterLevel = hierarchy.levels[level];
+  double minX, minY, maxX, maxY;
+  ProjectCoordinate(CLLocationCoordinate2DMake(bounds.northEast.latitude,
+                                               bounds.southWest.longitude),
+                    &minX, &minY);
+  ProjectCoordinate(CLLocationCoordinate2DMake(bounds.southWest.latitude,
+                                               bounds.northEast.longitude),
+                    &maxX, &maxY);
+
+  // Bounds crossing the antimeridian are searched as two boxes, one either side of it.
+  double boxes[2][2] = {{minX, maxX}, {0, 0}};
+  NSUInteger boxCount = 1;
+  if (minX > maxX) {
+    boxes[0][1] = 1;
+    boxes[1][0] = 0;
+    boxes[1][1] = maxX;
+    boxCount = 2;
+  }
+  const double *coordinates = clusterLevel.treeCoordinates.bytes;
+  const uint32_t *indices = clusterLevel.treeIndices.bytes;
+  NSArray<id<GMUCluster>> *cached = _clustersByLevel[@(level)];
+  NSMutableArray<id<GMUCluster>> *clusters = [NSMutableArray array];
+  NSMutableData *found = [NSMutableData data];
+  for (NSUInteger box = 0; box < boxCount; box++) {
+    NSUInteger foundCount = SearchKDTree(coordinates, clusterLevel.count, boxes[box][0], minY,
+                                         boxes[box][1], maxY, NULL, 0);
+    found.length = foundCount * sizeof(uint32_t);
+    SearchKDTree(coordinates, clusterLevel.count, boxes[box][0], minY, boxes[box][1], maxY,
+                 found.mutableBytes, foundCount);
+    const uint32_t *positions = found.bytes;
+    for (NSUInteger i = 0; i < foundCount; i++) {
+      uint32_t index = indices[positions[i]];
+      [clusters addObject:cached ? cached[index]
+                                 : [[HierarchicalCluster alloc] initWithHierarchy:hierarchy
+                                                                            level:level
+                                                                            index:index]];
+    }
+  }
+  return clusters;
+}
+
+- (NSArray<id<GMUCluster>> *)childrenOfCluster:(id<GMUCluster>)cluster {
+  if (![cluster isKindOfClass:[HierarchicalCluster class]]) {
+    return @[];
+  }
+  HierarchicalCluster *parent = (HierarchicalCluster *)cluster;
+  ClusterHierarchy *hierarchy = parent.hierarchy;
+  if (hierarchy != _hierarchy) {
+    return @[];
+  }
+  NSArray<ClusterLevel *> *levels = hierarchy.levels;
+  NSUInteger level = parent.level;
+  NSUInteger index = parent.index;
+  while (level + 1 < levels.count) {
+    const uint32_t *offsets = levels[level].childOffsets.bytes;
+    const uint32_t *children = levels[level].children.bytes;
+    if (offsets[index + 1] - offsets[index] > 1) {
+      NSMutableArray<id<GMUCluster>> *clusters = [NSMutableArray array];
+      for (uint32_t child = offsets[index]; child < offsets[index + 1]; child++) {
+        [clusters addObject:[[HierarchicalCluster alloc] initWithHierarchy:hierarchy
+                                                                     level:level + 1
+                                                                     index:children[child]]];
+      }
+      return clusters;
+    }
+    index = children[offsets[index]];
+    level++;
+  }
+  return @[];
+}
+
+#pragma mark - Private
+
+- (NSUInteger)levelForZoom:(float)zoom {
+  return (NSUInteger)fmin(fmax(floor(zoom), 0), _maximumZoom + 1);
+}
+
+- (ClusterHierarchy *)hierarchy {
+  if (!_hierarchy) {
+    _hierarchy = [[ClusterHierarchy alloc] initWithItems:_items
+                                             maximumZoom:_maximumZoom
+                                         clusterDistance:_clusterDistance];
+  }
+  return _hierarchy;
+}
+
+- (void)invalidate {
+  _hierarchy = nil;
+  [_clustersByLevel removeAllObjects];
+}
+
+@end
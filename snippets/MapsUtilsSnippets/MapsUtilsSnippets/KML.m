@@ -15,9 +15,19 @@
 #import "KML.h"
 // [START maps_ios_kml]
 @import GoogleMapsUtils;
+// [START_EXCLUDE]
+#import "KMLStreamReader.h"
+#import "MergedGeometryRenderer.h"
+
+@interface KML () <GMSMapViewDelegate>
+@end
+// [END_EXCLUDE]
 
 @implementation KML {
   GMSMapView *_mapView;
+  // [START_EXCLUDE]
+  MergedGeometryRenderer *_mergedRenderer;
+  // [END_EXCLUDE]
 }
 
 - (void)renderKml {
@@ -31,5 +41,77 @@
   [renderer render];
 }
 
+// [START_EXCLUDE]
+// [START maps_ios_kml_streaming]
+/// Function demonstrating how to start drawing a large KML file before it has all been read
+- (void)renderKmlStreaming {
+  NSString *path = [[NSBundle mainBundle] pathForResource:@"KML_Sample" ofType:@"kml"];
+  KMLStreamReader *reader = [[KMLStreamReader alloc] initWithURL:[NSURL fileURLWithPath:path]];
+  GMSMapView *mapView = _mapView;
+  CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+  dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+    __block BOOL first = YES;
+    KMLPlacemarksHandler handler = ^(NSArray<KMLStreamPlacemark *> *placemarks, BOOL *stop) {
+      if (first) {
+        NSLog(@"First placemarks after %.0f ms", (CFAbsoluteTimeGetCurrent() - start) * 1000);
+        first = NO;
+      }
+      // Look the styles up while reading, which is when the reader allows it. Placemarks that
+      // share a style share one GMUStyle.
+      NSMutableArray<GMUPlacemark *> *geometries = [NSMutableArray array];
+      for (KMLStreamPlacemark *placemark in placemarks) {
+        if (!placemark.geometry) {
+          continue;
+        }
+        GMUStyle *style = placemark.styleIndex != NSNotFound
+                              ? [reader styleAtIndex:placemark.styleIndex]
+                              : nil;
+        [geometries addObject:[[GMUPlacemark alloc] initWithGeometry:placemark.geometry
+                                                               title:placemark.title
+                                                             snippet:placemark.snippet
+                                                               style:style
+                                                            styleUrl:nil]];
+      }
+      dispatch_async(dispatch_get_main_queue(), ^{
+        GMUGeometryRenderer *renderer = [[GMUGeometryRenderer alloc] initWithMap:mapView
+                                                                      geometries:geometries];
+        [renderer render];
+      });
+    };
+    NSError *error;
+    if (![reader readPlacemarksWithHandler:handler error:&error]) {
+      NSLog(@"Could not read the KML: %@", error.localizedDescription);
+    }
+  });
+}
+// [END maps_ios_kml_streaming]
+
+// [START maps_ios_kml_merged]
+/// Function demonstrating how to draw lines that share a style as one overlay
+- (void)renderKmlMerged {
+  NSString *path = [[NSBundle mainBundle] pathForResource:@"KML_Sample" ofType:@"kml"];
+  GMUKMLParser *parser = [[GMUKMLParser alloc] initWithURL:[NSURL fileURLWithPath:path]];
+  [parser parse];
+  _mergedRenderer = [[MergedGeometryRenderer alloc] initWithMap:_mapView
+                                                     geometries:parser.placemarks
+                                                         styles:parser.styles
+                                                      styleMaps:parser.styleMaps];
+  [_mergedRenderer render];
+  NSLog(@"Drew %lu overlays instead of %lu", (unsigned long)_mergedRenderer.overlayCount,
+        (unsigned long)_mergedRenderer.unmergedOverlayCount);
+  _mapView.delegate = self;
+}
+
+- (void)mapView:(GMSMapView *)mapView didTapAtCoordinate:(CLLocationCoordinate2D)coordinate {
+  // Merged lines are one overlay per style, so find the placemark that was tapped by position.
+  id<GMUGeometryContainer> container = [_mergedRenderer lineContainerAtCoordinate:coordinate
+                                                                toleranceInPoints:10];
+  if ([container isKindOfClass:[GMUPlacemark class]]) {
+    NSLog(@"Tapped %@", ((GMUPlacemark *)container).title);
+  }
+}
+// [END maps_ios_kml_merged]
+// [END_EXCLUDE]
+
 @end
 // [END maps_ios_kml]
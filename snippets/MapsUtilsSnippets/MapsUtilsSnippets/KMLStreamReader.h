@@ -0,0 +1,100 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+@import GoogleMapsUtils;
+
+NS_ASSUME_NONNULL_BEGIN
+
+FOUNDATION_EXTERN NSErrorDomain const KMLStreamReaderErrorDomain;
+
+typedef NS_ERROR_ENUM(KMLStreamReaderErrorDomain, KMLStreamReaderError) {
+  /** The stream could not be opened or read. */
+  KMLStreamReaderErrorUnreadable = 1,
+  /** The stream is not well-formed XML. */
+  KMLStreamReaderErrorInvalidXML = 2,
+};
+
+/** A placemark as the stream reader hands it out, with its style as an index. */
+@interface KMLStreamPlacemark : NSObject
+
+/** The geometry, or nil if the placemark has none. */
+@property(nonatomic, readonly, nullable) id<GMUGeometry> geometry;
+
+@property(nonatomic, readonly, nullable) NSString *title;
+
+/** The description. */
+@property(nonatomic, readonly, nullable) NSString *snippet;
+
+/**
+ * The index of the placemark's style in the reader, for -[KMLStreamReader styleAtIndex:], or
+ * NSNotFound if it has none.
+ */
+@property(nonatomic, readonly) NSUInteger styleIndex;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+/**
+ * Called with each chunk of placemarks as soon as it has been read. Set |stop| to YES to stop
+ * reading.
+ */
+typedef void (^KMLPlacemarksHandler)(NSArray<KMLStreamPlacemark *> *placemarks, BOOL *stop);
+
+/**
+ * Reads KML one chunk of placemarks at a time, instead of parsing the whole file before anything
+ * can be drawn as GMUKMLParser does.
+ *
+ * The stream is pulled through an XML tokenizer a buffer at a time, and only the current chunk of
+ * placemarks is held. Each <Style> and <StyleMap> is kept once, under an index that placemarks
+ * refer to, however many placemarks share it. A style may be defined after the placemarks that
+ * use it, so look styles up once their index is needed rather than up front.
+ */
+@interface KMLStreamReader : NSObject
+
+/** The number of placemarks in each chunk but the last. Defaults to 256. */
+@property(nonatomic) NSUInteger chunkSize;
+
+/** Reads the KML file at |url|. */
+- (nullable instancetype)initWithURL:(NSURL *)url;
+
+/** Reads from |stream|, which must not have been opened yet. */
+- (instancetype)initWithInputStream:(NSInputStream *)stream NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Reads the stream, calling |handler| with each chunk of placemarks in document order on the
+ * calling thread. A reader can only read its stream once.
+ *
+ * @return NO with |error| set if the stream cannot be read or is not well-formed. Placemarks
+ *     before the problem will have been handled.
+ */
+- (BOOL)readPlacemarksWithHandler:(NS_NOESCAPE KMLPlacemarksHandler)handler
+                            error:(NSError **)error;
+
+/**
+ * Returns the style at |index|, following a style map to its normal style, or nil if nothing has
+ * been defined under it yet. Styles are added as the stream is read, so call this from the
+ * handler or once reading has finished.
+ */
+- (nullable GMUStyle *)styleAtIndex:(NSUInteger)index;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,1013 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "KMLStreamReader.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+@import GoogleMaps;
+
+NSErrorDomain const KMLStreamReaderErrorDomain = @"KMLStreamReaderErrorDomain";
+
+// Bytes read from the stream at a time.
+static const NSUInteger kBufferSize = 64 * 1024;
+
+enum {
+  // Longest element or attribute name that is compared; longer names match nothing.
+  kNameCapacity = 32,
+  // Longest entity name, such as "quot" or "#x1F600".
+  kEntityCapacity = 10,
+};
+
+// Deepest that multi-geometries may nest.
+static const NSUInteger kMaxGeometryDepth = 8;
+
+// Style maps followed to reach a style; more means a cycle.
+static const NSUInteger kMaxStyleMapHops = 8;
+
+static const NSUInteger kDefaultChunkSize = 256;
+
+/** Reads up to |length| bytes, returning how many it read, 0 at the end or -1 on failure. */
+typedef NSInteger (*ReadFunction)(void *context, uint8_t *bytes, NSUInteger length);
+
+typedef NS_ENUM(NSInteger, XMLToken) {
+  XMLTokenFailed,
+  XMLTokenEndOfStream,
+  XMLTokenStartElement,
+  XMLTokenEndElement,
+  XMLTokenText,
+};
+
+/** A string that grows as needed and is kept NUL-terminated. */
+typedef struct {
+  char *bytes;
+  NSUInteger length;
+  NSUInteger capacity;
+} TextBuffer;
+
+/**
+ * A pull tokenizer over a window onto the stream. Bytes before |position| are dropped when the
+ * buffer is refilled.
+ */
+typedef struct {
+  ReadFunction read;
+  void *context;
+  uint8_t *bytes;
+  NSUInteger capacity;
+  NSUInteger length;
+  NSUInteger position;
+  // Bytes dropped so far, to report where errors are.
+  NSUInteger dropped;
+  BOOL ended;
+  // The local name of the current element, without any namespace prefix.
+  char name[kNameCapacity];
+  // The "id" attribute of the current start element.
+  TextBuffer identifier;
+  // The current text token, with entities decoded.
+  TextBuffer text;
+  // The text of the last element read with ReadElementText.
+  TextBuffer value;
+  // Whether the current start element closed itself, so its end comes next.
+  BOOL pendingEnd;
+  KMLStreamReaderError errorCode;
+  const char *errorMessage;
+  NSUInteger errorOffset;
+} Tokenizer;
+
+static BOOL Fail(Tokenizer *tokenizer, KMLStreamReaderError code, const char *message) {
+  if (!tokenizer->errorMessage) {
+    tokenizer->errorCode = code;
+    tokenizer->errorMessage = message;
+    tokenizer->errorOffset = tokenizer->dropped + tokenizer->position;
+  }
+  return NO;
+}
+
+static BOOL Append(Tokenizer *tokenizer, TextBuffer *buffer, const char *bytes, NSUInteger length) {
+  if (buffer->length + length + 1 > buffer->capacity) {
+    NSUInteger capacity = MAX(buffer->capacity * 2, MAX(buffer->length + length + 1, 64));
+    char *grown = realloc(buffer->bytes, capacity);
+    if (!grown) {
+      return Fail(tokenizer, KMLStreamReaderErrorUnreadable, "Out of memory");
+    }
+    buffer->bytes = grown;
+    buffer->capacity = capacity;
+  }
+  memcpy(buffer->bytes + buffer->length, bytes, length);
+  buffer->length += length;
+  buffer->bytes[buffer->length] = '\0';
+  return YES;
+}
+
+static inline BOOL AppendByte(Tokenizer *tokenizer, TextBuffer *buffer, char c) {
+  if (buffer->length + 2 <= buffer->capacity) {
+    buffer->bytes[buffer->length++] = c;
+    buffer->bytes[buffer->length] = '\0';
+    return YES;
+  }
+  return Append(tokenizer, buffer, &c, 1);
+}
+
+static void ClearText(TextBuffer *buffer) {
+  buffer->length = 0;
+  if (buffer->bytes) {
+    buffer->bytes[0] = '\0';
+  }
+}
+
+#pragma mark - Tokenizing
+
+/**
+ * Reads more of the stream into the buffer, first dropping the bytes already consumed.
+ *
+ * @return NO at the end of the stream or if it fails.
+ */
+static BOOL Refill(Tokenizer *tokenizer) {
+  if (tokenizer->ended) {
+    return NO;
+  }
+  if (tokenizer->position > 0) {
+    memmove(tokenizer->bytes, tokenizer->bytes + tokenizer->position,
+            tokenizer->length - tokenizer->position);
+    tokenizer->length -= tokenizer->position;
+    tokenizer->dropped += tokenizer->position;
+    tokenizer->position = 0;
+  }
+  NSInteger count = tokenizer->read(tokenizer->context, tokenizer->bytes + tokenizer->length,
+                                    tokenizer->capacity - tokenizer->length);
+  if (count < 0) {
+    tokenizer->ended = YES;
+    return Fail(tokenizer, KMLStreamReaderErrorUnreadable, "The stream could not be read");
+  }
+  if (count == 0) {
+    tokenizer->ended = YES;
+    return NO;
+  }
+  tokenizer->length += count;
+  return YES;
+}
+
+/** Returns the next byte without consuming it, or -1 at the end of the stream. */
+static inline int Peek(Tokenizer *tokenizer) {
+  while (tokenizer->position == tokenizer->length) {
+    if (!Refill(tokenizer)) {
+      return -1;
+    }
+  }
+  return tokenizer->bytes[tokenizer->position];
+}
+
+static inline BOOL IsSpace(int c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+static int SkipWhitespace(Tokenizer *tokenizer) {
+  int c = Peek(tokenizer);
+  while (IsSpace(c)) {
+    tokenizer->position++;
+    c = Peek(tokenizer);
+  }
+  return c;
+}
+
+static BOOL Expect(Tokenizer *tokenizer, int expected) {
+  if (Peek(tokenizer) != expected) {
+    return Fail(tokenizer, KMLStreamReaderErrorInvalidXML, "Malformed markup");
+  }
+  tokenizer->position++;
+  return YES;
+}
+
+/**
+ * Reads a name into |name|, keeping only the part after any namespace prefix, or leaving it empty
+ * if it is too long to be any name that is looked for.
+ */
+static BOOL ReadName(Tokenizer *tokenizer, char *name) {
+  NSUInteger length = 0;
+  BOOL fits = YES;
+  for (int c = Peek(tokenizer); c >= 0 && !IsSpace(c) && c != '/' && c != '>' && c != '=';
+       c = Peek(tokenizer)) {
+    tokenizer->position++;
+    if (c == ':') {
+      length = 0;
+      fits = YES;
+    } else if (length + 1 < kNameCapacity) {
+      name[length++] = (char)c;
+    } else {
+      fits = NO;
+    }
+  }
+  name[fits ? length : 0] = '\0';
+  if (length == 0 && fits) {
+    return Fail(tokenizer, KMLStreamReaderErrorInvalidXML, "Expected a name");
+  }
+  return YES;
+}
+
+/** Consumes an entity reference after its "&", appending the character it stands for. */
+static BOOL ReadEntity(Tokenizer *tokenizer, TextBuffer *buffer) {
+  char entity[kEntityCapacity + 1];
+  NSUInteger length = 0;
+  int c = Peek(tokenizer);
+  while (c >= 0 && c != ';' && c != '<' && c != '&' && length < kEntityCapacity) {
+    entity[length++] = (char)c;
+    tokenizer->position++;
+    c = Peek(tokenizer);
+  }
+  entity[length] = '\0';
+  if (c != ';') {
+    // Not a reference after all, so keep it as it is.
+    return AppendByte(tokenizer, buffer, '&') && Append(tokenizer, buffer, entity, length);
+  }
+  tokenizer->position++;
+
+  static const struct {
+    const char *name;
+    char character;
+  } kEntities[] = {{"lt", '<'}, {"gt", '>'}, {"amp", '&'}, {"quot", '"'}, {"apos", '\''}};
+  for (NSUInteger i = 0; i < sizeof(kEntities) / sizeof(kEntities[0]); i++) {
+    if (strcmp(entity, kEntities[i].name) == 0) {
+      return AppendByte(tokenizer, buffer, kEntities[i].character);
+    }
+  }
+  if (entity[0] == '#') {
+    char *end;
+    BOOL hex = entity[1] == 'x';
+    unsigned long code = strtoul(entity + (hex ? 2 : 1), &end, hex ? 16 : 10);
+    if (*end == '\0' && end != entity + (hex ? 2 : 1) && code > 0 && code <= 0x10FFFF) {
+      // Encode the code point as UTF-8.
+      char utf8[4];
+      NSUInteger utf8Length;
+      if (code < 0x80) {
+        utf8[0] = (char)code;
+        utf8Length = 1;
+      } else if (code < 0x800) {
+        utf8[0] = (char)(0xC0 | (code >> 6));
+        utf8[1] = (char)(0x80 | (code & 0x3F));
+        utf8Length = 2;
+      } else if (code < 0x10000) {
+        utf8[0] = (char)(0xE0 | (code >> 12));
+        utf8[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+        utf8[2] = (char)(0x80 | (code & 0x3F));
+        utf8Length = 3;
+      } else {
+        utf8[0] = (char)(0xF0 | (code >> 18));
+        utf8[1] = (char)(0x80 | ((code >> 12) & 0x3F));
+        utf8[2] = (char)(0x80 | ((code >> 6) & 0x3F));
+        utf8[3] = (char)(0x80 | (code & 0x3F));
+        utf8Length = 4;
+      }
+      return Append(tokenizer, buffer, utf8, utf8Length);
+    }
+  }
+  return AppendByte(tokenizer, buffer, '&') && Append(tokenizer, buffer, entity, length) &&
+         AppendByte(tokenizer, buffer, ';');
+}
+
+/**
+ * Consumes everything up to and including |count| or more |repeated| characters followed by ">",
+ * which ends comments ("-->"), processing instructions ("?>") and CDATA sections ("]]>"). What
+ * comes before the terminator is appended to |buffer| unless it is NULL.
+ */
+static BOOL ReadUntilTerminator(Tokenizer *tokenizer, char repeated, NSUInteger count,
+                                TextBuffer *buffer) {
+  NSUInteger run = 0;
+  for (;;) {
+    int c = Peek(tokenizer);
+    if (c < 0) {
+      return Fail(tokenizer, KMLStreamReaderErrorInvalidXML, "Unterminated markup");
+    }
+    tokenizer->position++;
+    if (c == '>' && run >= count) {
+      for (; buffer && run > count; run--) {
+        if (!AppendByte(tokenizer, buffer, repeated)) {
+          return NO;
+        }
+      }
+      return YES;
+    }
+    if (c == repeated) {
+      run++;
+      continue;
+    }
+    if (buffer) {
+      for (; run > 0; run--) {
+        if (!AppendByte(tokenizer, buffer, repeated)) {
+          return NO;
+        }
+      }
+      if (!AppendByte(tokenizer, buffer, (char)c)) {
+        return NO;
+      }
+    }
+    run = 0;
+  }
+}
+
+/** Consumes a document type declaration after its "<!", including any internal subset. */
+static BOOL SkipDeclaration(Tokenizer *tokenizer) {
+  NSUInteger depth = 0;
+  for (;;) {
+    int c = Peek(tokenizer);
+    if (c < 0) {
+      return Fail(tokenizer, KMLStreamReaderErrorInvalidXML, "Unterminated declaration");
+    }
+    tokenizer->position++;
+    if (c == '[') {
+      depth++;
+    } else if (c == ']' && depth > 0) {
+      depth--;
+    } else if (c == '>' && depth == 0) {
+      return YES;
+    }
+  }
+}
+
+/** Consumes a start tag's attributes, keeping the value of "id". */
+static BOOL ReadAttributes(Tokenizer *tokenizer) {
+  ClearText(&tokenizer->identifier);
+  for (;;) {
+    int c = SkipWhitespace(tokenizer);
+    if (c == '>') {
+      tokenizer->position++;
+      return YES;
+    }
+    if (c == '/') {
+      tokenizer->position++;
+      tokenizer->pendingEnd = YES;
+      return Expect(tokenizer, '>');
+    }
+    char name[kNameCapacity];
+    if (!ReadName(tokenizer, name)) {
+      return NO;
+    }
+    SkipWhitespace(tokenizer);
+    if (!Expect(tokenizer, '=')) {
+      return NO;
+    }
+    int quote = SkipWhitespace(tokenizer);
+    if (quote != '"' && quote != '\'') {
+      return Fail(tokenizer, KMLStreamReaderErrorInvalidXML, "Expected a quoted value");
+    }
+    tokenizer->position++;
+    BOOL keep = strcmp(name, "id") == 0;
+    for (c = Peek(tokenizer); c != quote; c = Peek(tokenizer)) {
+      if (c < 0) {
+        return Fail(tokenizer, KMLStreamReaderErrorInvalidXML, "Unterminated value");
+      }
+      tokenizer->position++;
+      BOOL appended = !keep || (c == '&' ? ReadEntity(tokenizer, &tokenizer->identifier)
+                                         : AppendByte(tokenizer, &tokenizer->identifier, (char)c));
+      if (!appended) {
+        return NO;
+      }
+    }
+    tokenizer->position++;
+  }
+}
+
+/**
+ * Reads the next start tag, end tag or run of text, skipping comments, processing instructions
+ * and declarations. A CDATA section is read as text.
+ */
+static XMLToken NextToken(Tokenizer *tokenizer) {
+  if (tokenizer->errorMessage) {
+    return XMLTokenFailed;
+  }
+  if (tokenizer->pendingEnd) {
+    tokenizer->pendingEnd = NO;
+    return XMLTokenEndElement;
+  }
+  for (;;) {
+    int c = Peek(tokenizer);
+    if (c < 0) {
+      return tokenizer->errorMessage ? XMLTokenFailed : XMLTokenEndOfStream;
+    }
+    if (c != '<') {
+      ClearText(&tokenizer->text);
+      for (; c >= 0 && c != '<'; c = Peek(tokenizer)) {
+        tokenizer->position++;
+        BOOL appended = c == '&' ? ReadEntity(tokenizer, &tokenizer->text)
+                                 : AppendByte(tokenizer, &tokenizer->text, (char)c);
+        if (!appended) {
+          return XMLTokenFailed;
+        }
+      }
+      return XMLTokenText;
+    }
+    tokenizer->position++;
+    c = Peek(tokenizer);
+    if (c == '/') {
+      tokenizer->position++;
+      if (!ReadName(tokenizer, tokenizer->name)) {
+        return XMLTokenFailed;
+      }
+      SkipWhitespace(tokenizer);
+      return Expect(tokenizer, '>') ? XMLTokenEndElement : XMLTokenFailed;
+    }
+    if (c == '?') {
+      tokenizer->position++;
+      if (!ReadUntilTerminator(tokenizer, '?', 1, NULL)) {
+        return XMLTokenFailed;
+      }
+      continue;
+    }
+    if (c == '!') {
+      tokenizer->position++;
+      c = Peek(tokenizer);
+      if (c == '-') {
+        tokenizer->position++;
+        if (!Expect(tokenizer, '-') || !ReadUntilTerminator(tokenizer, '-', 2, NULL)) {
+          return XMLTokenFailed;
+        }
+        continue;
+      }
+      if (c == '[') {
+        for (const char *expected = "[CDATA["; *expected; expected++) {
+          if (!Expect(tokenizer, *expected)) {
+            return XMLTokenFailed;
+          }
+        }
+        ClearText(&tokenizer->text);
+        return ReadUntilTerminator(tokenizer, ']', 2, &tokenizer->text) ? XMLTokenText
+                                                                         : XMLTokenFailed;
+      }
+      if (!SkipDeclaration(tokenizer)) {
+        return XMLTokenFailed;
+      }
+      continue;
+    }
+    if (!ReadName(tokenizer, tokenizer->name) || !ReadAttributes(tokenizer)) {
+      return XMLTokenFailed;
+    }
+    return XMLTokenStartElement;
+  }
+}
+
+/** Consumes the rest of the current element, which has just started. */
+static BOOL SkipElement(Tokenizer *tokenizer) {
+  NSUInteger depth = 1;
+  while (depth > 0) {
+    switch (NextToken(tokenizer)) {
+      case XMLTokenStartElement:
+        depth++;
+        break;
+      case XMLTokenEndElement:
+        depth--;
+        break;
+      case XMLTokenText:
+        break;
+      case XMLTokenEndOfStream:
+        return Fail(tokenizer, KMLStreamReaderErrorInvalidXML, "Unexpected end of the stream");
+      case XMLTokenFailed:
+        return NO;
+    }
+  }
+  return YES;
+}
+
+/**
+ * Steps through the children of the current element: returns YES when the next child starts, or
+ * NO with |*done| set once the element ends.
+ */
+static BOOL NextChild(Tokenizer *tokenizer, BOOL *done) {
+  *done = NO;
+  for (;;) {
+    switch (NextToken(tokenizer)) {
+      case XMLTokenStartElement:
+        return YES;
+      case XMLTokenEndElement:
+        *done = YES;
+        return NO;
+      case XMLTokenText:
+        break;
+      case XMLTokenEndOfStream:
+        return Fail(tokenizer, KMLStreamReaderErrorInvalidXML, "Unexpected end of the stream");
+      case XMLTokenFailed:
+        return NO;
+    }
+  }
+}
+
+/** Reads the text of the current element into |value|, skipping any child elements. */
+static BOOL ReadElementText(Tokenizer *tokenizer) {
+  ClearText(&tokenizer->value);
+  for (;;) {
+    switch (NextToken(tokenizer)) {
+      case XMLTokenText:
+        if (!Append(tokenizer, &tokenizer->value, tokenizer->text.bytes, tokenizer->text.length)) {
+          return NO;
+        }
+        break;
+      case XMLTokenStartElement:
+        if (!SkipElement(tokenizer)) {
+          return NO;
+        }
+        break;
+      case XMLTokenEndElement:
+        // Keep the value a valid C string even when it is empty.
+        return Append(tokenizer, &tokenizer->value, "", 0);
+      case XMLTokenEndOfStream:
+        return Fail(tokenizer, KMLStreamReaderErrorInvalidXML, "Unexpected end of the stream");
+      case XMLTokenFailed:
+        return NO;
+    }
+  }
+}
+
+#pragma mark - Values
+
+static NSString *TrimmedString(const char *bytes) {
+  NSString *string = [NSString stringWithUTF8String:bytes] ?: @"";
+  return [string stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+}
+
+/** Parses a KML colour, which is hexadecimal alpha, blue, green and red. */
+static UIColor *_Nullable ColorFromText(const char *bytes) {
+  char *end;
+  unsigned long abgr = strtoul(bytes, &end, 16);
+  if (end == bytes) {
+    return nil;
+  }
+  return [UIColor colorWithRed:(abgr & 0xFF) / 255.0
+                         green:((abgr >> 8) & 0xFF) / 255.0
+                          blue:((abgr >> 16) & 0xFF) / 255.0
+                         alpha:((abgr >> 24) & 0xFF) / 255.0];
+}
+
+/** Parses whitespace-separated "longitude,latitude[,altitude]" tuples. */
+static GMSMutablePath *PathFromText(const char *bytes) {
+  GMSMutablePath *path = [GMSMutablePath path];
+  const char *position = bytes;
+  for (;;) {
+    while (IsSpace(*position)) {
+      position++;
+    }
+    char *end;
+    double longitude = strtod(position, &end);
+    if (end == position || *end != ',') {
+      break;
+    }
+    position = end + 1;
+    double latitude = strtod(position, &end);
+    if (end == position) {
+      break;
+    }
+    position = end;
+    while (*position == ',') {
+      strtod(position + 1, &end);
+      position = end > position + 1 ? end : position + 1;
+    }
+    [path addCoordinate:CLLocationCoordinate2DMake(latitude, longitude)];
+  }
+  return path;
+}
+
+static BOOL IsGeometryName(const char *name) {
+  return strcmp(name, "Point") == 0 || strcmp(name, "LineString") == 0 ||
+         strcmp(name, "LinearRing") == 0 || strcmp(name, "Polygon") == 0 ||
+         strcmp(name, "MultiGeometry") == 0;
+}
+
+static NSInteger ReadInputStream(void *context, uint8_t *bytes, NSUInteger length) {
+  NSInputStream *stream = (__bridge NSInputStream *)context;
+  return [stream read:bytes maxLength:length];
+}
+
+#pragma mark - Reader
+
+@interface KMLStreamPlacemark ()
+
+- (instancetype)initWithGeometry:(nullable id<GMUGeometry>)geometry
+                           title:(nullable NSString *)title
+                         snippet:(nullable NSString *)snippet
+                      styleIndex:(NSUInteger)styleIndex NS_DESIGNATED_INITIALIZER;
+
+@end
+
+@implementation KMLStreamPlacemark
+
+- (instancetype)initWithGeometry:(nullable id<GMUGeometry>)geometry
+                           title:(nullable NSString *)title
+                         snippet:(nullable NSString *)snippet
+                      styleIndex:(NSUInteger)styleIndex {
+  self = [super init];
+  if (self) {
+    _geometry = geometry;
+    _title = [title copy];
+    _snippet = [snippet copy];
+    _styleIndex = styleIndex;
+  }
+  return self;
+}
+
+@end
+
+@implementation KMLStreamReader {
+  NSInputStream *_stream;
+
+  // Styles by index, with NSNull for ids that have been referred to but not yet defined.
+  NSMutableArray *_styles;
+
+  // Index of each style id.
+  NSMutableDictionary<NSString *, NSNumber *> *_styleIndices;
+
+  // For each index, the index a style map's normal pair points at, or NSNotFound.
+  NSMutableData *_styleMapTargets;
+}
+
+- (nullable instancetype)initWithURL:(NSURL *)url {
+  NSInputStream *stream = [NSInputStream inputStreamWithURL:url];
+  if (!stream) {
+    return nil;
+  }
+  return [self initWithInputStream:stream];
+}
+
+- (instancetype)initWithInputStream:(NSInputStream *)stream {
+  self = [super init];
+  if (self) {
+    _stream = stream;
+    _chunkSize = kDefaultChunkSize;
+    _styles = [NSMutableArray array];
+    _styleIndices = [NSMutableDictionary dictionary];
+    _styleMapTargets = [NSMutableData data];
+  }
+  return self;
+}
+
+- (BOOL)readPlacemarksWithHandler:(NS_NOESCAPE KMLPlacemarksHandler)handler
+                            error:(NSError **)error {
+  [_stream open];
+  Tokenizer tokenizer = {
+      .read = ReadInputStream,
+      .context = (__bridge void *)_stream,
+      .bytes = malloc(kBufferSize),
+      .capacity = kBufferSize,
+  };
+  if (_stream.streamStatus == NSStreamStatusError || !tokenizer.bytes) {
+    Fail(&tokenizer, KMLStreamReaderErrorUnreadable, "The stream could not be opened");
+  }
+
+  // Containers such as <Document> and <Folder> are stepped into rather than read, so everything
+  // but placemarks and shared styles passes straight through.
+  NSUInteger chunkSize = MAX(_chunkSize, 1);
+  NSMutableArray<KMLStreamPlacemark *> *chunk = [NSMutableArray arrayWithCapacity:chunkSize];
+  BOOL stop = NO;
+  while (!stop && !tokenizer.errorMessage) {
+    @autoreleasepool {
+      XMLToken token = NextToken(&tokenizer);
+      if (token == XMLTokenEndOfStream || token == XMLTokenFailed) {
+        break;
+      }
+      if (token != XMLTokenStartElement) {
+        continue;
+      }
+      if (strcmp(tokenizer.name, "Placemark") == 0) {
+        KMLStreamPlacemark *placemark = [self readPlacemarkWithTokenizer:&tokenizer];
+        if (placemark) {
+          [chunk addObject:placemark];
+        }
+        if (chunk.count == chunkSize) {
+          handler(chunk, &stop);
+          chunk = [NSMutableArray arrayWithCapacity:chunkSize];
+        }
+      } else if (strcmp(tokenizer.name, "Style") == 0) {
+        NSString *styleID = TrimmedString(tokenizer.identifier.bytes ?: "");
+        GMUStyle *style = [self readStyleWithTokenizer:&tokenizer styleID:styleID];
+        if (style) {
+          [self setStyle:style atIndex:[self indexForStyleID:styleID]];
+        }
+      } else if (strcmp(tokenizer.name, "StyleMap") == 0) {
+        NSString *styleID = TrimmedString(tokenizer.identifier.bytes ?: "");
+        [self readStyleMapWithTokenizer:&tokenizer index:[self indexForStyleID:styleID]];
+      }
+    }
+  }
+  if (!stop && chunk.count > 0) {
+    @autoreleasepool {
+      handler(chunk, &stop);
+    }
+  }
+
+  [_stream close];
+  free(tokenizer.bytes);
+  free(tokenizer.identifier.bytes);
+  free(tokenizer.text.bytes);
+  free(tokenizer.value.bytes);
+
+  if (tokenizer.errorMessage) {
+    if (error) {
+      NSString *description =
+          [NSString stringWithFormat:@"%s at byte %lu.", tokenizer.errorMessage,
+                                     (unsigned long)tokenizer.errorOffset];
+      *error = [NSError errorWithDomain:KMLStreamReaderErrorDomain
+                                   code:tokenizer.errorCode
+                               userInfo:@{NSLocalizedDescriptionKey : description}];
+    }
+    return NO;
+  }
+  return YES;
+}
+
+- (nullable GMUStyle *)styleAtIndex:(NSUInteger)index {
+  const NSUInteger *targets = _styleMapTargets.bytes;
+  for (NSUInteger hop = 0; hop < kMaxStyleMapHops && index < _styles.count; hop++) {
+    if (targets[index] == NSNotFound) {
+      id style = _styles[index];
+      return style == [NSNull null] ? nil : style;
+    }
+    index = targets[index];
+  }
+  return nil;
+}
+
+#pragma mark - Private
+
+/** Returns the index for |styleID|, giving it the next one if it has not been seen before. */
+- (NSUInteger)indexForStyleID:(NSString *)styleID {
+  NSNumber *index = styleID.length > 0 ? _styleIndices[styleID] : nil;
+  if (index) {
+    return index.unsignedIntegerValue;
+  }
+  NSUInteger newIndex = _styles.count;
+  NSUInteger none = NSNotFound;
+  [_styles addObject:[NSNull null]];
+  [_styleMapTargets appendBytes:&none length:sizeof(none)];
+  if (styleID.length > 0) {
+    _styleIndices[styleID] = @(newIndex);
+  }
+  return newIndex;
+}
+
+/** Returns the index for a <styleUrl>, which refers to a style by "#" and its id. */
+- (NSUInteger)indexForStyleURL:(NSString *)styleURL {
+  NSRange hash = [styleURL rangeOfString:@"#" options:NSBackwardsSearch];
+  NSString *styleID = hash.location == NSNotFound ? styleURL
+                                                  : [styleURL substringFromIndex:NSMaxRange(hash)];
+  return [self indexForStyleID:styleID];
+}
+
+- (void)setStyle:(GMUStyle *)style atIndex:(NSUInteger)index {
+  _styles[index] = style;
+}
+
+/** Reads the current <Style>, or returns nil on an error. */
+- (nullable GMUStyle *)readStyleWithTokenizer:(Tokenizer *)tokenizer styleID:(NSString *)styleID {
+  UIColor *strokeColor = nil;
+  UIColor *fillColor = nil;
+  CGFloat width = 1;
+  CGFloat scale = 1;
+  CGFloat heading = 0;
+  NSString *iconUrl = nil;
+  BOOL hasFill = YES;
+  BOOL hasStroke = YES;
+  BOOL done;
+  while (NextChild(tokenizer, &done)) {
+    if (strcmp(tokenizer->name, "LineStyle") == 0) {
+      BOOL lineDone;
+      while (NextChild(tokenizer, &lineDone)) {
+        if (strcmp(tokenizer->name, "color") == 0 && ReadElementText(tokenizer)) {
+          strokeColor = ColorFromText(tokenizer->value.bytes);
+        } else if (strcmp(tokenizer->name, "width") == 0 && ReadElementText(tokenizer)) {
+          width = strtod(tokenizer->value.bytes, NULL);
+        } else if (!tokenizer->errorMessage) {
+          SkipElement(tokenizer);
+        }
+      }
+    } else if (strcmp(tokenizer->name, "PolyStyle") == 0) {
+      BOOL polyDone;
+      while (NextChild(tokenizer, &polyDone)) {
+        if (strcmp(tokenizer->name, "color") == 0 && ReadElementText(tokenizer)) {
+          fillColor = ColorFromText(tokenizer->value.bytes);
+        } else if (strcmp(tokenizer->name, "fill") == 0 && ReadElementText(tokenizer)) {
+          hasFill = strtol(tokenizer->value.bytes, NULL, 10) != 0;
+        } else if (strcmp(tokenizer->name, "outline") == 0 && ReadElementText(tokenizer)) {
+          hasStroke = strtol(tokenizer->value.bytes, NULL, 10) != 0;
+        } else if (!tokenizer->errorMessage) {
+          SkipElement(tokenizer);
+        }
+      }
+    } else if (strcmp(tokenizer->name, "IconStyle") == 0) {
+      BOOL iconStyleDone;
+      while (NextChild(tokenizer, &iconStyleDone)) {
+        if (strcmp(tokenizer->name, "scale") == 0 && ReadElementText(tokenizer)) {
+          scale = strtod(tokenizer->value.bytes, NULL);
+        } else if (strcmp(tokenizer->name, "heading") == 0 && ReadElementText(tokenizer)) {
+          heading = strtod(tokenizer->value.bytes, NULL);
+        } else if (strcmp(tokenizer->name, "Icon") == 0) {
+          BOOL iconDone;
+          while (NextChild(tokenizer, &iconDone)) {
+            if (strcmp(tokenizer->name, "href") == 0 && ReadElementText(tokenizer)) {
+              iconUrl = TrimmedString(tokenizer->value.bytes);
+            } else if (!tokenizer->errorMessage) {
+              SkipElement(tokenizer);
+            }
+          }
+        } else if (!tokenizer->errorMessage) {
+          SkipElement(tokenizer);
+        }
+      }
+    } else {
+      SkipElement(tokenizer);
+    }
+    if (tokenizer->errorMessage) {
+      return nil;
+    }
+  }
+  if (!done) {
+    return nil;
+  }
+  return [[GMUStyle alloc] initWithStyleID:styleID
+                               strokeColor:strokeColor
+                                 fillColor:fillColor
+                                     width:width
+                                     scale:scale
+                                   heading:heading
+                                    anchor:CGPointMake(0.5, 1)
+                                   iconUrl:iconUrl
+                                     title:nil
+                                   hasFill:hasFill
+                                 hasStroke:hasStroke];
+}
+
+/** Reads the current <StyleMap>, pointing |index| at the style of its normal pair. */
+- (BOOL)readStyleMapWithTokenizer:(Tokenizer *)tokenizer index:(NSUInteger)index {
+  BOOL done;
+  while (NextChild(tokenizer, &done)) {
+    if (strcmp(tokenizer->name, "Pair") != 0) {
+      if (!SkipElement(tokenizer)) {
+        return NO;
+      }
+      continue;
+    }
+    BOOL normal = NO;
+    NSUInteger target = NSNotFound;
+    BOOL pairDone;
+    while (NextChild(tokenizer, &pairDone)) {
+      if (strcmp(tokenizer->name, "key") == 0 && ReadElementText(tokenizer)) {
+        normal = [TrimmedString(tokenizer->value.bytes) isEqualToString:@"normal"];
+      } else if (strcmp(tokenizer->name, "styleUrl") == 0 && ReadElementText(tokenizer)) {
+        target = [self indexForStyleURL:TrimmedString(tokenizer->value.bytes)];
+      } else if (strcmp(tokenizer->name, "Style") == 0) {
+        GMUStyle *style = [self readStyleWithTokenizer:tokenizer styleID:@""];
+        if (style) {
+          target = [self indexForStyleID:@""];
+          [self setStyle:style atIndex:target];
+        }
+      } else if (!tokenizer->errorMessage) {
+        SkipElement(tokenizer);
+      }
+      if (tokenizer->errorMessage) {
+        return NO;
+      }
+    }
+    if (!pairDone) {
+      return NO;
+    }
+    if (normal && target != NSNotFound && target != index) {
+      ((NSUInteger *)_styleMapTargets.mutableBytes)[index] = target;
+    }
+  }
+  return done;
+}
+
+/** Reads the current <Placemark>, or returns nil on an error. */
+- (nullable KMLStreamPlacemark *)readPlacemarkWithTokenizer:(Tokenizer *)tokenizer {
+  NSString *title = nil;
+  NSString *snippet = nil;
+  id<GMUGeometry> geometry = nil;
+  NSUInteger styleIndex = NSNotFound;
+  NSUInteger inlineStyleIndex = NSNotFound;
+  BOOL done;
+  while (NextChild(tokenizer, &done)) {
+    if (strcmp(tokenizer->name, "name") == 0 && ReadElementText(tokenizer)) {
+      title = TrimmedString(tokenizer->value.bytes);
+    } else if (strcmp(tokenizer->name, "description") == 0 && ReadElementText(tokenizer)) {
+      snippet = TrimmedString(tokenizer->value.bytes);
+    } else if (strcmp(tokenizer->name, "styleUrl") == 0 && ReadElementText(tokenizer)) {
+      styleIndex = [self indexForStyleURL:TrimmedString(tokenizer->value.bytes)];
+    } else if (strcmp(tokenizer->name, "Style") == 0) {
+      GMUStyle *style = [self readStyleWithTokenizer:tokenizer styleID:@""];
+      if (style) {
+        inlineStyleIndex = [self indexForStyleID:@""];
+        [self setStyle:style atIndex:inlineStyleIndex];
+      }
+    } else if (IsGeometryName(tokenizer->name)) {
+      geometry = [self readGeometryWithTokenizer:tokenizer depth:0];
+    } else if (!tokenizer->errorMessage) {
+      SkipElement(tokenizer);
+    }
+    if (tokenizer->errorMessage) {
+      return nil;
+    }
+  }
+  if (!done) {
+    return nil;
+  }
+  // A style given inline wins over a shared one.
+  return [[KMLStreamPlacemark alloc]
+      initWithGeometry:geometry
+                 title:title
+               snippet:snippet
+            styleIndex:inlineStyleIndex != NSNotFound ? inlineStyleIndex : styleIndex];
+}
+
+/** Reads the coordinates of the current element, skipping everything else in it. */
+- (nullable GMSMutablePath *)readCoordinatesWithTokenizer:(Tokenizer *)tokenizer {
+  GMSMutablePath *path = [GMSMutablePath path];
+  BOOL done;
+  while (NextChild(tokenizer, &done)) {
+    if (strcmp(tokenizer->name, "coordinates") == 0 && ReadElementText(tokenizer)) {
+      path = PathFromText(tokenizer->value.bytes);
+    } else if (!tokenizer->errorMessage) {
+      SkipElement(tokenizer);
+    }
+  }
+  return done ? path : nil;
+}
+
+/**
+ * Reads the current geometry element, or returns nil if it is empty or on an error, which leaves
+ * the tokenizer's error set.
+ */
+- (nullable id<GMUGeometry>)readGeometryWithTokenizer:(Tokenizer *)tokenizer
+                                                depth:(NSUInteger)depth {
+  if (strcmp(tokenizer->name, "Point") == 0) {
+    GMSMutablePath *path = [self readCoordinatesWithTokenizer:tokenizer];
+    return path.count > 0 ? [[GMUPoint alloc] initWithCoordinate:[path coordinateAtIndex:0]] : nil;
+  }
+  if (strcmp(tokenizer->name, "LineString") == 0 || strcmp(tokenizer->name, "LinearRing") == 0) {
+    GMSMutablePath *path = [self readCoordinatesWithTokenizer:tokenizer];
+    return path.count > 0 ? [[GMULineString alloc] initWithPath:path] : nil;
+  }
+  if (strcmp(tokenizer->name, "Polygon") == 0) {
+    GMSPath *outer = nil;
+    NSMutableArray<GMSPath *> *holes = [NSMutableArray array];
+    BOOL done;
+    while (NextChild(tokenizer, &done)) {
+      BOOL isOuter = strcmp(tokenizer->name, "outerBoundaryIs") == 0;
+      if (!isOuter && strcmp(tokenizer->name, "innerBoundaryIs") != 0) {
+        SkipElement(tokenizer);
+        continue;
+      }
+      BOOL boundaryDone;
+      while (NextChild(tokenizer, &boundaryDone)) {
+        if (strcmp(tokenizer->name, "LinearRing") != 0) {
+          SkipElement(tokenizer);
+          continue;
+        }
+        GMSMutablePath *ring = [self readCoordinatesWithTokenizer:tokenizer];
+        if (ring.count == 0) {
+          continue;
+        }
+        if (isOuter) {
+          outer = ring;
+        } else {
+          [holes addObject:ring];
+        }
+      }
+      if (tokenizer->errorMessage) {
+        return nil;
+      }
+    }
+    if (!done || !outer) {
+      return nil;
+    }
+    return [[GMUPolygon alloc] initWithPaths:[@[ outer ] arrayByAddingObjectsFromArray:holes]];
+  }
+  if (strcmp(tokenizer->name, "MultiGeometry") == 0 && depth < kMaxGeometryDepth) {
+    NSMutableArray<id<GMUGeometry>> *geometries = [NSMutableArray array];
+    BOOL done;
+    while (NextChild(tokenizer, &done)) {
+      if (!IsGeometryName(tokenizer->name)) {
+        SkipElement(tokenizer);
+        continue;
+      }
+      id<GMUGeometry> geometry = [self readGeometryWithTokenizer:tokenizer depth:depth + 1];
+      if (geometry) {
+        [geometries addObject:geometry];
+      }
+    }
+    if (!done || geometries.count == 0) {
+      return nil;
+    }
+    return [[GMUGeometryCollection alloc] initWithGeometries:geometries];
+  }
+  SkipElement(tokenizer);
+  return nil;
+}
+
+@end
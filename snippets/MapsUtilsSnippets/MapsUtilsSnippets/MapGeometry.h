@@ -0,0 +1,60 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import <CoreLocation/CoreLocation.h>
+#import <Foundation/Foundation.h>
+
+#include <math.h>
+#include <stdlib.h>
+
+// Helpers shared by the snippets' C code. Projected points are on the unit Web Mercator square,
+// from 0 to 1 east and south.
+
+// Latitude at which Web Mercator's world becomes square.
+static const double kMaximumMercatorLatitude = 85.051128779806589;
+
+/**
+ * Makes room in |*array| for at least |count| elements, doubling its capacity as it grows. Like
+ * NSMutableData, it treats running out of memory as fatal.
+ */
+static inline void Reserve(void **array, NSUInteger *capacity, NSUInteger count,
+                           size_t elementSize) {
+  if (count <= *capacity) {
+    return;
+  }
+  NSUInteger newCapacity = MAX(*capacity * 2, MAX(count, 16));
+  void *grown = realloc(*array, newCapacity * elementSize);
+  if (!grown) {
+    abort();
+  }
+  *array = grown;
+  *capacity = newCapacity;
+}
+
+/** Projects |coordinate| onto the unit Web Mercator square, clamping its latitude to it. */
+static inline void ProjectCoordinate(CLLocationCoordinate2D coordinate, double *x, double *y) {
+  double latitude =
+      fmax(fmin(coordinate.latitude, kMaximumMercatorLatitude), -kMaximumMercatorLatitude);
+  double sinLatitude = sin(latitude * M_PI / 180);
+  *x = (coordinate.longitude + 180) / 360;
+  *y = 0.5 - log((1 + sinLatitude) / (1 - sinLatitude)) / (4 * M_PI);
+}
+
+/** Returns the coordinate of a point on the unit Web Mercator square. */
+static inline CLLocationCoordinate2D UnprojectPoint(double x, double y) {
+  return CLLocationCoordinate2DMake(atan(sinh(M_PI * (1 - 2 * y))) * 180 / M_PI, x * 360 - 180);
+}
@@ -17,6 +17,10 @@
 // [START maps_ios_marker_clustering_creation]
 @import GoogleMaps;
 @import GoogleMapsUtils;
+// [START_EXCLUDE]
+#import "ClusterIconAtlas.h"
+#import "HierarchicalClusterAlgorithm.h"
+// [END_EXCLUDE]
 
 @interface MarkerClustering () <GMSMapViewDelegate>
 
@@ -91,6 +95,56 @@
     return NO;
 }
 // [END maps_ios_marker_clustering_events]
+
+// [START maps_ios_marker_clustering_hierarchical]
+/// Function demonstrating how to cluster every zoom level once, so zooming doesn't recluster
+- (void)setUpHierarchicalClustering {
+  // The hierarchy is built on the first query after items change, then reused at every zoom.
+  HierarchicalClusterAlgorithm *algorithm = [[HierarchicalClusterAlgorithm alloc] init];
+  id<GMUClusterIconGenerator> iconGenerator = [[GMUDefaultClusterIconGenerator alloc] init];
+  id<GMUClusterRenderer> renderer =
+      [[GMUDefaultClusterRenderer alloc] initWithMapView:_mapView
+                                    clusterIconGenerator:iconGenerator];
+  _clusterManager = [[GMUClusterManager alloc] initWithMap:_mapView
+                                                 algorithm:algorithm
+                                                  renderer:renderer];
+  [_clusterManager setMapDelegate:self];
+
+  for (NSUInteger i = 0; i < 1000; i++) {
+    CLLocationCoordinate2D position =
+        CLLocationCoordinate2DMake(47.0 + (i % 40) * 0.02, -122.8 + (i / 40) * 0.04);
+    [_clusterManager addItem:[GMSMarker markerWithPosition:position]];
+  }
+  [_clusterManager cluster];
+
+  // Only the clusters on screen are looked up, and expanding one only visits its children.
+  GMSCoordinateBounds *visibleBounds =
+      [[GMSCoordinateBounds alloc] initWithRegion:_mapView.projection.visibleRegion];
+  for (id<GMUCluster> cluster in [algorithm clustersInBounds:visibleBounds
+                                                        zoom:_mapView.camera.zoom]) {
+    NSArray<id<GMUCluster>> *children = [algorithm childrenOfCluster:cluster];
+    NSLog(@"Cluster of %lu items splits into %lu", (unsigned long)cluster.count,
+          (unsigned long)children.count);
+  }
+}
+// [END maps_ios_marker_clustering_hierarchical]
+
+// [START maps_ios_marker_clustering_icon_atlas]
+/// Function demonstrating how to draw each cluster icon once instead of whenever it is shown
+- (void)setUpIconAtlas {
+  // Bucket icons ("10+", "50+", ...) are drawn together into one atlas the first time one is
+  // needed; exact counts below the first bucket are cached as they are drawn.
+  id<GMUClusterIconGenerator> iconGenerator = [[ClusterIconAtlas alloc] init];
+  id<GMUClusterRenderer> renderer =
+      [[GMUDefaultClusterRenderer alloc] initWithMapView:_mapView
+                                    clusterIconGenerator:iconGenerator];
+  _clusterManager =
+      [[GMUClusterManager alloc] initWithMap:_mapView
+                                   algorithm:[[HierarchicalClusterAlgorithm alloc] init]
+                                    renderer:renderer];
+  [_clusterManager setMapDelegate:self];
+}
+// [END maps_ios_marker_clustering_icon_atlas]
 // [END_EXCLUDE]
 @end
 // [END maps_ios_marker_clustering_creation]
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+@import GoogleMaps;
+@import GoogleMapsUtils;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A drop-in for GMUGeometryRenderer that draws all the lines sharing a style as one polyline,
+ * instead of one polyline per line.
+ *
+ * Lines are grouped by the stroke colour and width of their resolved style, and each group is
+ * drawn as a single path. Where one line does not start at the previous line's end, the path
+ * jumps between them along a segment drawn in a clear style span. Points and polygons, and
+ * geometries that mix lines with them, are drawn by a GMUGeometryRenderer as before, since a
+ * marker or a polygon cannot hold more than one of them.
+ *
+ * Merged lines are not tappable one by one. Use -lineContainerAtCoordinate:toleranceInPoints: to
+ * find the feature or placemark under a tap.
+ */
+@interface MergedGeometryRenderer : NSObject
+
+/**
+ * The number of overlays GMUGeometryRenderer would draw for the geometries: one for each point,
+ * line and polygon.
+ */
+@property(nonatomic, readonly) NSUInteger unmergedOverlayCount;
+
+/** The number of overlays drawn by the last call to -render. */
+@property(nonatomic, readonly) NSUInteger overlayCount;
+
+- (instancetype)initWithMap:(GMSMapView *)map
+                 geometries:(NSArray<id<GMUGeometryContainer>> *)geometries;
+
+/**
+ * Looks placemark styles up by their style URL in |styles|, and in |styleMaps| through their
+ * normal style, as GMUGeometryRenderer does.
+ */
+- (instancetype)initWithMap:(GMSMapView *)map
+                 geometries:(NSArray<id<GMUGeometryContainer>> *)geometries
+                     styles:(nullable NSArray<GMUStyle *> *)styles
+                  styleMaps:(nullable NSArray<GMUStyleMap *> *)styleMaps NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/** Draws the geometries, replacing anything drawn before. */
+- (void)render;
+
+/** Removes everything the renderer has drawn. */
+- (void)clear;
+
+/**
+ * Returns the geometry container whose merged line passes within |tolerance| points of
+ * |coordinate| at the current zoom, or nil if there is none. Use it from
+ * -mapView:didTapAtCoordinate:.
+ */
+- (nullable id<GMUGeometryContainer>)lineContainerAtCoordinate:(CLLocationCoordinate2D)coordinate
+                                             toleranceInPoints:(CGFloat)tolerance;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,435 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "MergedGeometryRenderer.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#import "MapGeometry.h"
+
+// Width of the world in points at zoom 0.
+static const double kWorldSize = 256;
+
+/** A run of segments of a merged path that are all drawn, or all hidden. */
+typedef struct {
+  NSUInteger segmentCount;
+  BOOL visible;
+} SegmentRun;
+
+/** Lines of one style joined into one path. */
+typedef struct {
+  CLLocationCoordinate2D *coordinates;
+  NSUInteger coordinateCount;
+  NSUInteger coordinateCapacity;
+  SegmentRun *runs;
+  NSUInteger runCount;
+  NSUInteger runCapacity;
+  // Index of each line's first segment in the path.
+  NSUInteger *lineStarts;
+  NSUInteger lineCount;
+  NSUInteger lineCapacity;
+  NSUInteger segmentCount;
+} MergedLines;
+
+static void FreeMergedLines(MergedLines *lines) {
+  free(lines->coordinates);
+  free(lines->runs);
+  free(lines->lineStarts);
+  *lines = (MergedLines){0};
+}
+
+/**
+ * Orders |count| items so that items of the same style are together, in ascending style and
+ * otherwise in their original order. |styleIndices| must all be below |styleCount|.
+ *
+ * @param order Receives the item indices in their new order.
+ * @param groupEnds Receives, for each style, the position in |order| one past its last item.
+ */
+static void GroupByStyle(const NSUInteger *styleIndices, NSUInteger count, NSUInteger styleCount,
+                         NSUInteger *order, NSUInteger *groupEnds) {
+  for (NSUInteger style = 0; style < styleCount; style++) {
+    groupEnds[style] = 0;
+  }
+  for (NSUInteger i = 0; i < count; i++) {
+    groupEnds[styleIndices[i]]++;
+  }
+  NSUInteger end = 0;
+  for (NSUInteger style = 0; style < styleCount; style++) {
+    end += groupEnds[style];
+    groupEnds[style] = end;
+  }
+  // Fill each group from the back, so that items keep their order within it.
+  for (NSUInteger i = count; i > 0; i--) {
+    order[--groupEnds[styleIndices[i - 1]]] = i - 1;
+  }
+  for (NSUInteger style = 0; style < styleCount; style++) {
+    groupEnds[style] = style + 1 < styleCount ? groupEnds[style + 1] : count;
+  }
+}
+
+static void AppendRun(MergedLines *lines, NSUInteger segmentCount, BOOL visible) {
+  lines->segmentCount += segmentCount;
+  if (lines->runCount > 0 && lines->runs[lines->runCount - 1].visible == visible) {
+    lines->runs[lines->runCount - 1].segmentCount += segmentCount;
+    return;
+  }
+  Reserve((void **)&lines->runs, &lines->runCapacity, lines->runCount + 1, sizeof(SegmentRun));
+  lines->runs[lines->runCount++] = (SegmentRun){segmentCount, visible};
+}
+
+/**
+ * Appends a line of |count| coordinates to |lines|. A line that starts where the previous one
+ * ended carries on from it; any other is reached by a hidden segment.
+ *
+ * @return NO, appending nothing, if the line has fewer than two coordinates.
+ */
+static BOOL AppendLine(MergedLines *lines, const CLLocationCoordinate2D *coordinates,
+                       NSUInteger count) {
+  if (count < 2) {
+    return NO;
+  }
+  NSUInteger first = 0;
+  if (lines->coordinateCount > 0) {
+    CLLocationCoordinate2D end = lines->coordinates[lines->coordinateCount - 1];
+    if (end.latitude == coordinates[0].latitude && end.longitude == coordinates[0].longitude) {
+      first = 1;
+    } else {
+      AppendRun(lines, 1, NO);
+    }
+  }
+  Reserve((void **)&lines->lineStarts, &lines->lineCapacity, lines->lineCount + 1,
+          sizeof(NSUInteger));
+  lines->lineStarts[lines->lineCount++] = lines->segmentCount;
+  Reserve((void **)&lines->coordinates, &lines->coordinateCapacity,
+          lines->coordinateCount + count - first, sizeof(CLLocationCoordinate2D));
+  for (NSUInteger i = first; i < count; i++) {
+    lines->coordinates[lines->coordinateCount++] = coordinates[i];
+  }
+  AppendRun(lines, count - 1, YES);
+  return YES;
+}
+
+/**
+ * Returns the index of the line in |lines| with a drawn segment nearest to |coordinate| and
+ * within |tolerance| of it in projected units, or NSNotFound if there is none.
+ */
+static NSUInteger HitTestLines(const MergedLines *lines, CLLocationCoordinate2D coordinate,
+                               double tolerance) {
+  double px, py;
+  ProjectCoordinate(coordinate, &px, &py);
+  double nearestSqDistance = tolerance * tolerance;
+  NSUInteger nearestSegment = NSNotFound;
+  NSUInteger segment = 0;
+  for (NSUInteger run = 0; run < lines->runCount; run++) {
+    NSUInteger end = segment + lines->runs[run].segmentCount;
+    if (!lines->runs[run].visible) {
+      segment = end;
+      continue;
+    }
+    double ax, ay;
+    ProjectCoordinate(lines->coordinates[segment], &ax, &ay);
+    for (; segment < end; segment++) {
+      double bx, by;
+      ProjectCoordinate(lines->coordinates[segment + 1], &bx, &by);
+      double dx = bx - ax;
+      double dy = by - ay;
+      double t = 0;
+      if (dx != 0 || dy != 0) {
+        t = fmin(fmax(((px - ax) * dx + (py - ay) * dy) / (dx * dx + dy * dy), 0), 1);
+      }
+      double ex = ax + dx * t - px;
+      double ey = ay + dy * t - py;
+      if (ex * ex + ey * ey <= nearestSqDistance) {
+        nearestSqDistance = ex * ex + ey * ey;
+        nearestSegment = segment;
+      }
+      ax = bx;
+      ay = by;
+    }
+  }
+  if (nearestSegment == NSNotFound) {
+    return NSNotFound;
+  }
+  // The line is the last one starting at or before the segment.
+  NSUInteger low = 0;
+  NSUInteger high = lines->lineCount;
+  while (high - low > 1) {
+    NSUInteger middle = low + (high - low) / 2;
+    if (lines->lineStarts[middle] <= nearestSegment) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+/** Returns the number of overlays GMUGeometryRenderer draws for |geometry|. */
+static NSUInteger CountOverlays(id<GMUGeometry> geometry) {
+  if (![geometry isKindOfClass:[GMUGeometryCollection class]]) {
+    return 1;
+  }
+  NSUInteger count = 0;
+  for (id<GMUGeometry> child in ((GMUGeometryCollection *)geometry).geometries) {
+    count += CountOverlays(child);
+  }
+  return count;
+}
+
+/**
+ * Adds the paths of |geometry| to |paths| if it is a line string or a collection of nothing but
+ * line strings.
+ *
+ * @return NO if |geometry| holds anything other than lines.
+ */
+static BOOL CollectLines(id<GMUGeometry> geometry, NSMutableArray<GMSPath *> *paths) {
+  if ([geometry isKindOfClass:[GMULineString class]]) {
+    [paths addObject:((GMULineString *)geometry).path];
+    return YES;
+  }
+  if (![geometry isKindOfClass:[GMUGeometryCollection class]]) {
+    return NO;
+  }
+  for (id<GMUGeometry> child in ((GMUGeometryCollection *)geometry).geometries) {
+    if (!CollectLines(child, paths)) {
+      return NO;
+    }
+  }
+  return YES;
+}
+
+/** A polyline holding the lines of one style, and what each line was drawn for. */
+@interface MergedPolyline : NSObject {
+ @public
+  MergedLines _lines;
+}
+
+@property(nonatomic) GMSPolyline *polyline;
+
+/** The container of each line in |_lines|. */
+@property(nonatomic) NSMutableArray<id<GMUGeometryContainer>> *containers;
+
+@end
+
+@implementation MergedPolyline
+
+- (void)dealloc {
+  FreeMergedLines(&_lines);
+}
+
+@end
+
+@implementation MergedGeometryRenderer {
+  GMSMapView *_map;
+  NSArray<id<GMUGeometryContainer>> *_geometries;
+
+  NSArray<GMUStyle *> *_styleList;
+  NSArray<GMUStyleMap *> *_styleMaps;
+
+  // Styles by their ID, and the ID of the normal style of each style map by its ID.
+  NSDictionary<NSString *, GMUStyle *> *_styles;
+  NSDictionary<NSString *, NSString *> *_normalStyleIDs;
+
+  NSMutableArray<MergedPolyline *> *_mergedPolylines;
+
+  // Draws whatever cannot be merged.
+  GMUGeometryRenderer *_unmergedRenderer;
+}
+
+- (instancetype)initWithMap:(GMSMapView *)map
+                 geometries:(NSArray<id<GMUGeometryContainer>> *)geometries {
+  return [self initWithMap:map geometries:geometries styles:nil styleMaps:nil];
+}
+
+- (instancetype)initWithMap:(GMSMapView *)map
+                 geometries:(NSArray<id<GMUGeometryContainer>> *)geometries
+                     styles:(nullable NSArray<GMUStyle *> *)styles
+                  styleMaps:(nullable NSArray<GMUStyleMap *> *)styleMaps {
+  self = [super init];
+  if (self) {
+    _map = map;
+    _geometries = [geometries copy];
+    _styleList = [styles copy];
+    _styleMaps = [styleMaps copy];
+    NSMutableDictionary<NSString *, GMUStyle *> *stylesByID = [NSMutableDictionary dictionary];
+    for (GMUStyle *style in styles) {
+      stylesByID[style.styleID] = style;
+    }
+    _styles = stylesByID;
+    NSMutableDictionary<NSString *, NSString *> *normalStyleIDs = [NSMutableDictionary dictionary];
+    for (GMUStyleMap *styleMap in styleMaps) {
+      for (GMUPair *pair in styleMap.pairs) {
+        if ([pair.key isEqualToString:@"normal"]) {
+          normalStyleIDs[styleMap.styleMapId] = pair.styleUrl;
+        }
+      }
+    }
+    _normalStyleIDs = normalStyleIDs;
+    _mergedPolylines = [NSMutableArray array];
+    NSUInteger unmergedOverlayCount = 0;
+    for (id<GMUGeometryContainer> container in _geometries) {
+      unmergedOverlayCount += CountOverlays(container.geometry);
+    }
+    _unmergedOverlayCount = unmergedOverlayCount;
+  }
+  return self;
+}
+
+- (void)render {
+  [self clear];
+
+  // Intern each line's stroke, so that lines with equal strokes share a style index however
+  // their styles are named.
+  NSMutableDictionary<NSArray *, NSNumber *> *strokeIndices = [NSMutableDictionary dictionary];
+  // The first style seen with each stroke, or NSNull for lines without a style.
+  NSMutableArray *strokeStyles = [NSMutableArray array];
+  NSMutableArray<GMSPath *> *paths = [NSMutableArray array];
+  NSMutableArray<id<GMUGeometryContainer>> *pathContainers = [NSMutableArray array];
+  NSMutableData *pathStrokes = [NSMutableData data];
+  NSMutableArray<id<GMUGeometryContainer>> *unmerged = [NSMutableArray array];
+  for (id<GMUGeometryContainer> container in _geometries) {
+    NSUInteger firstPath = paths.count;
+    if (!CollectLines(container.geometry, paths)) {
+      [paths removeObjectsInRange:NSMakeRange(firstPath, paths.count - firstPath)];
+      [unmerged addObject:container];
+      continue;
+    }
+    GMUStyle *style = [self styleForContainer:container];
+    NSArray *stroke = style ? @[ style.strokeColor ?: [NSNull null], @(style.width) ] : @[];
+    NSNumber *strokeIndex = strokeIndices[stroke];
+    if (!strokeIndex) {
+      strokeIndex = @(strokeStyles.count);
+      strokeIndices[stroke] = strokeIndex;
+      [strokeStyles addObject:style ?: [NSNull null]];
+    }
+    for (NSUInteger i = firstPath; i < paths.count; i++) {
+      NSUInteger index = strokeIndex.unsignedIntegerValue;
+      [pathStrokes appendBytes:&index length:sizeof(index)];
+      [pathContainers addObject:container];
+    }
+  }
+
+  NSUInteger *order = malloc(MAX(paths.count, 1) * sizeof(NSUInteger));
+  NSUInteger *groupEnds = malloc(MAX(strokeStyles.count, 1) * sizeof(NSUInteger));
+  if (!order || !groupEnds) {
+    abort();
+  }
+  GroupByStyle(pathStrokes.bytes, paths.count, strokeStyles.count, order, groupEnds);
+  NSMutableData *coordinates = [NSMutableData data];
+  NSUInteger position = 0;
+  for (NSUInteger stroke = 0; stroke < strokeStyles.count; stroke++) {
+    MergedPolyline *merged = [[MergedPolyline alloc] init];
+    merged.containers = [NSMutableArray array];
+    for (; position < groupEnds[stroke]; position++) {
+      GMSPath *path = paths[order[position]];
+      coordinates.length = path.count * sizeof(CLLocationCoordinate2D);
+      CLLocationCoordinate2D *pathCoordinates = coordinates.mutableBytes;
+      for (NSUInteger i = 0; i < path.count; i++) {
+        pathCoordinates[i] = [path coordinateAtIndex:i];
+      }
+      if (AppendLine(&merged->_lines, pathCoordinates, path.count)) {
+        [merged.containers addObject:pathContainers[order[position]]];
+      }
+    }
+    if (merged->_lines.lineCount == 0) {
+      continue;
+    }
+    id style = strokeStyles[stroke];
+    merged.polyline = [self polylineForLines:&merged->_lines
+                                       style:style != [NSNull null] ? style : nil];
+    merged.polyline.map = _map;
+    [_mergedPolylines addObject:merged];
+  }
+  free(order);
+  free(groupEnds);
+
+  _unmergedRenderer = [[GMUGeometryRenderer alloc] initWithMap:_map
+                                                    geometries:unmerged
+                                                        styles:_styleList
+                                                     styleMaps:_styleMaps];
+  [_unmergedRenderer render];
+  NSUInteger overlayCount = _mergedPolylines.count;
+  for (id<GMUGeometryContainer> container in unmerged) {
+    overlayCount += CountOverlays(container.geometry);
+  }
+  _overlayCount = overlayCount;
+}
+
+- (void)clear {
+  for (MergedPolyline *merged in _mergedPolylines) {
+    merged.polyline.map = nil;
+  }
+  [_mergedPolylines removeAllObjects];
+  [_unmergedRenderer clear];
+  _unmergedRenderer = nil;
+  _overlayCount = 0;
+}
+
+- (nullable id<GMUGeometryContainer>)lineContainerAtCoordinate:(CLLocationCoordinate2D)coordinate
+                                             toleranceInPoints:(CGFloat)tolerance {
+  double projectedTolerance = tolerance / (kWorldSize * exp2(_map.camera.zoom));
+  for (MergedPolyline *merged in _mergedPolylines.reverseObjectEnumerator) {
+    NSUInteger line = HitTestLines(&merged->_lines, coordinate, projectedTolerance);
+    if (line != NSNotFound) {
+      return merged.containers[line];
+    }
+  }
+  return nil;
+}
+
+#pragma mark - Private
+
+/** Returns the container's own style, or else the style its placemark's style URL names. */
+- (nullable GMUStyle *)styleForContainer:(id<GMUGeometryContainer>)container {
+  if (container.style || ![container isKindOfClass:[GMUPlacemark class]]) {
+    return container.style;
+  }
+  NSString *styleUrl = ((GMUPlacemark *)container).styleUrl;
+  if (!styleUrl) {
+    return nil;
+  }
+  GMUStyle *style = _styles[styleUrl];
+  if (!style && _normalStyleIDs[styleUrl]) {
+    style = _styles[_normalStyleIDs[styleUrl]];
+  }
+  return style;
+}
+
+- (GMSPolyline *)polylineForLines:(const MergedLines *)lines style:(nullable GMUStyle *)style {
+  GMSMutablePath *path = [GMSMutablePath path];
+  for (NSUInteger i = 0; i < lines->coordinateCount; i++) {
+    [path addCoordinate:lines->coordinates[i]];
+  }
+  GMSPolyline *polyline = [GMSPolyline polylineWithPath:path];
+  if (style) {
+    polyline.strokeWidth = style.width;
+  }
+  UIColor *strokeColor = style.strokeColor ?: polyline.strokeColor;
+  if (lines->runCount > 1) {
+    GMSStrokeStyle *visible = [GMSStrokeStyle solidColor:strokeColor];
+    GMSStrokeStyle *hidden = [GMSStrokeStyle solidColor:[UIColor clearColor]];
+    NSMutableArray<GMSStyleSpan *> *spans = [NSMutableArray arrayWithCapacity:lines->runCount];
+    for (NSUInteger run = 0; run < lines->runCount; run++) {
+      [spans addObject:[GMSStyleSpan spanWithStyle:lines->runs[run].visible ? visible : hidden
+                                          segments:lines->runs[run].segmentCount]];
+    }
+    polyline.spans = spans;
+  } else {
+    polyline.strokeColor = strokeColor;
+  }
+  return polyline;
+}
+
+@end
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <CoreLocation/CoreLocation.h>
+@import GoogleMapsUtils;
+
+NS_ASSUME_NONNULL_BEGIN
+
+FOUNDATION_EXTERN NSErrorDomain const PointDatasetErrorDomain;
+
+typedef NS_ERROR_ENUM(PointDatasetErrorDomain, PointDatasetError) {
+  /** The file does not start with a point dataset header this version can read. */
+  PointDatasetErrorInvalidHeader = 1,
+  /** The file is shorter or longer than its header says. */
+  PointDatasetErrorInvalidLength = 2,
+  /** The JSON is not an array of objects with numeric "lat" and "lng". */
+  PointDatasetErrorInvalidJSON = 3,
+};
+
+/**
+ * A set of weighted points read straight from a compact binary file, instead of parsed from JSON
+ * into one object per point.
+ *
+ * The file is a 32-byte header followed by three columns: latitudes, longitudes and weights. They
+ * are either float64, or in the quantised variant int32 degrees times 10^7 (about 1 cm) with
+ * float32 weights, which halves the file. The file is memory-mapped, so opening it costs the same
+ * however many points it holds, and the columns are handed out as pointers into the mapping.
+ */
+@interface PointDataset : NSObject
+
+/** Number of points. */
+@property(nonatomic, readonly) NSUInteger count;
+
+/** Whether the columns are quantised to int32 and float32. */
+@property(nonatomic, readonly, getter=isQuantized) BOOL quantized;
+
+/** The float64 columns, or NULL if the dataset is quantised. Each holds |count| values. */
+@property(nonatomic, readonly, nullable) const double *latitudes NS_RETURNS_INNER_POINTER;
+@property(nonatomic, readonly, nullable) const double *longitudes NS_RETURNS_INNER_POINTER;
+@property(nonatomic, readonly, nullable) const double *weights NS_RETURNS_INNER_POINTER;
+
+/**
+ * The quantised columns, or NULL if the dataset is not quantised. Each holds |count| values;
+ * divide coordinates by 10^7 for degrees.
+ */
+@property(nonatomic, readonly, nullable) const int32_t *quantizedLatitudes NS_RETURNS_INNER_POINTER;
+@property(nonatomic, readonly, nullable)
+    const int32_t *quantizedLongitudes NS_RETURNS_INNER_POINTER;
+@property(nonatomic, readonly, nullable) const float *quantizedWeights NS_RETURNS_INNER_POINTER;
+
+/** Maps in the dataset at |url|, returning nil and setting |error| if it is not a valid one. */
+- (nullable instancetype)initWithContentsOfURL:(NSURL *)url error:(NSError **)error;
+
+/** Reads a dataset from |data|, which it keeps rather than copies. */
+- (nullable instancetype)initWithData:(NSData *)data error:(NSError **)error;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/** Returns the coordinate of point |index|, whichever layout the dataset uses. */
+- (CLLocationCoordinate2D)coordinateAtIndex:(NSUInteger)index;
+
+/** Returns the weight of point |index|, whichever layout the dataset uses. */
+- (double)weightAtIndex:(NSUInteger)index;
+
+/** Returns one GMUWeightedLatLng per point, for the heatmap layers that take them. */
+- (NSArray<GMUWeightedLatLng *> *)weightedData;
+
+/**
+ * Returns a dataset with one point per occupied cell of a Web Mercator grid |cellSize| metres wide
+ * at the equator, weighing the sum of the weights in the cell and placed at their weighted
+ * centroid. The layout matches this dataset's.
+ *
+ * A point never moves further than a cell's diagonal on the map, which at the equator is
+ * 1.41 * |cellSize| metres and shrinks with the cosine of the latitude; 100 m cells keep every
+ * point within a pixel of where it was up to zoom 10. The points are summed in parallel: each
+ * chunk of points fills its own hash table, whose cells are then merged by key across chunks.
+ */
+- (PointDataset *)datasetByAggregatingToCellSize:(double)cellSize;
+
+/**
+ * Converts JSON rows, as in the sample datasets, to the binary format. Each row needs numeric
+ * "lat" and "lng" and may have an "intensity", which defaults to 1.
+ *
+ * @return nil if |rows| is not an array of such rows.
+ */
++ (nullable NSData *)dataWithJSONObject:(id)rows quantized:(BOOL)quantized error:(NSError **)error;
+
+/** Converts the JSON file at |jsonURL| and writes the result to |url| atomically. */
++ (BOOL)convertJSONAtURL:(NSURL *)jsonURL
+                   toURL:(NSURL *)url
+               quantized:(BOOL)quantized
+                   error:(NSError **)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,384 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "PointDataset.h"
+
+#include <math.h>
+
+#import "MapGeometry.h"
+
+NSErrorDomain const PointDatasetErrorDomain = @"PointDatasetErrorDomain";
+
+// "PDS1" in file byte order.
+static const uint32_t kMagic = 0x31534450;
+
+static const uint16_t kVersion = 1;
+
+static const uint16_t kQuantizedFlag = 1 << 0;
+
+// Quantised coordinates are degrees times this.
+static const double kQuantizationScale = 1e7;
+
+// Length of the equator in metres, which Web Mercator grid cells are sized against.
+static const double kEarthCircumference = 40075016.685578488;
+
+// Points each chunk of an aggregation takes at least.
+static const NSUInteger kMinimumChunkSize = 4096;
+
+// Groups of cells an aggregation merges separately, by cell key.
+static const NSUInteger kPartitionCount = 64;
+
+static const uint64_t kEmptyCell = UINT64_MAX;
+
+/** The file header. Its size keeps the columns after it 8-byte aligned. */
+typedef struct {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t flags;
+  uint64_t count;
+  uint8_t reserved[16];
+} DatasetHeader;
+
+_Static_assert(sizeof(DatasetHeader) == 32, "The header must keep the columns aligned");
+
+/** The points of an aggregation that fall in one grid cell, summed. */
+typedef struct {
+  uint64_t key;
+  double weightedLatitude;
+  double weightedLongitude;
+  double weight;
+} AggregateCell;
+
+static NSError *DatasetError(PointDatasetError code, NSString *description) {
+  return [NSError errorWithDomain:PointDatasetErrorDomain
+                             code:code
+                         userInfo:@{NSLocalizedDescriptionKey : description}];
+}
+
+/** Returns a zeroed dataset file for |count| points, with its header filled in. */
+static NSMutableData *DatasetData(NSUInteger count, BOOL quantized) {
+  NSUInteger stride = quantized ? 2 * sizeof(int32_t) + sizeof(float) : 3 * sizeof(double);
+  NSMutableData *data = [NSMutableData dataWithLength:sizeof(DatasetHeader) + count * stride];
+  DatasetHeader header = {kMagic, kVersion, quantized ? kQuantizedFlag : 0, count, {0}};
+  memcpy(data.mutableBytes, &header, sizeof(header));
+  return data;
+}
+
+/** Writes point |index| of a dataset file for |count| points made by DatasetData. */
+static void SetDatasetPoint(NSMutableData *data, NSUInteger count, BOOL quantized,
+                            NSUInteger index, double latitude, double longitude, double weight) {
+  uint8_t *columns = (uint8_t *)data.mutableBytes + sizeof(DatasetHeader);
+  if (quantized) {
+    int32_t *coordinates = (int32_t *)columns;
+    coordinates[index] = (int32_t)lround(latitude * kQuantizationScale);
+    coordinates[count + index] = (int32_t)lround(longitude * kQuantizationScale);
+    ((float *)(coordinates + 2 * count))[index] = (float)weight;
+  } else {
+    double *values = (double *)columns;
+    values[index] = latitude;
+    values[count + index] = longitude;
+    values[2 * count + index] = weight;
+  }
+}
+
+/** Returns the smallest power of two at least twice |count|, for an open-addressing table. */
+static NSUInteger TableCapacity(NSUInteger count) {
+  NSUInteger capacity = 2;
+  while (capacity < 2 * count) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+/** Adds |cell| into the table of |capacity| cells, merging it with the cell of the same key. */
+static void AddCell(AggregateCell *table, NSUInteger capacity, AggregateCell cell) {
+  NSUInteger slot = (NSUInteger)((cell.key * 0x9E3779B97F4A7C15ull) >> 32) & (capacity - 1);
+  while (table[slot].key != kEmptyCell && table[slot].key != cell.key) {
+    slot = (slot + 1) & (capacity - 1);
+  }
+  if (table[slot].key == kEmptyCell) {
+    table[slot] = cell;
+  } else {
+    table[slot].weightedLatitude += cell.weightedLatitude;
+    table[slot].weightedLongitude += cell.weightedLongitude;
+    table[slot].weight += cell.weight;
+  }
+}
+
+/** Returns an empty table of |capacity| cells. */
+static NSMutableData *EmptyTable(NSUInteger capacity) {
+  NSMutableData *tableData =
+      [[NSMutableData alloc] initWithLength:capacity * sizeof(AggregateCell)];
+  AggregateCell *table = tableData.mutableBytes;
+  for (NSUInteger i = 0; i < capacity; i++) {
+    table[i].key = kEmptyCell;
+  }
+  return tableData;
+}
+
+static int CompareCells(const void *a, const void *b) {
+  uint64_t keyA = ((const AggregateCell *)a)->key;
+  uint64_t keyB = ((const AggregateCell *)b)->key;
+  return keyA < keyB ? -1 : keyA > keyB;
+}
+
+@implementation PointDataset {
+  // The mapped file, which the columns point into.
+  NSData *_data;
+}
+
+- (nullable instancetype)initWithContentsOfURL:(NSURL *)url error:(NSError **)error {
+  NSData *data = [NSData dataWithContentsOfURL:url options:NSDataReadingMappedAlways error:error];
+  if (!data) {
+    return nil;
+  }
+  return [self initWithData:data error:error];
+}
+
+- (nullable instancetype)initWithData:(NSData *)data error:(NSError **)error {
+  if ((self = [super init])) {
+    DatasetHeader header;
+    if (data.length < sizeof(header)) {
+      if (error) {
+        *error = DatasetError(PointDatasetErrorInvalidHeader, @"The file has no header.");
+      }
+      return nil;
+    }
+    memcpy(&header, data.bytes, sizeof(header));
+    if (header.magic != kMagic || header.version != kVersion ||
+        (header.flags & ~kQuantizedFlag) != 0) {
+      if (error) {
+        *error = DatasetError(PointDatasetErrorInvalidHeader, @"The header is not recognised.");
+      }
+      return nil;
+    }
+    BOOL quantized = (header.flags & kQuantizedFlag) != 0;
+    uint64_t stride = quantized ? 2 * sizeof(int32_t) + sizeof(float) : 3 * sizeof(double);
+    if (header.count > (data.length - sizeof(header)) / stride ||
+        data.length != sizeof(header) + header.count * stride) {
+      if (error) {
+        *error = DatasetError(PointDatasetErrorInvalidLength,
+                              @"The file length does not match its point count.");
+      }
+      return nil;
+    }
+    _data = data;
+    _count = (NSUInteger)header.count;
+    _quantized = quantized;
+    const uint8_t *columns = (const uint8_t *)data.bytes + sizeof(header);
+    if (quantized) {
+      _quantizedLatitudes = (const int32_t *)columns;
+      _quantizedLongitudes = _quantizedLatitudes + _count;
+      _quantizedWeights = (const float *)(_quantizedLongitudes + _count);
+    } else {
+      _latitudes = (const double *)columns;
+      _longitudes = _latitudes + _count;
+      _weights = _longitudes + _count;
+    }
+  }
+  return self;
+}
+
+- (CLLocationCoordinate2D)coordinateAtIndex:(NSUInteger)index {
+  NSParameterAssert(index < _count);
+  if (_quantized) {
+    return CLLocationCoordinate2DMake(_quantizedLatitudes[index] / kQuantizationScale,
+                                      _quantizedLongitudes[index] / kQuantizationScale);
+  }
+  return CLLocationCoordinate2DMake(_latitudes[index], _longitudes[index]);
+}
+
+- (double)weightAtIndex:(NSUInteger)index {
+  NSParameterAssert(index < _count);
+  return _quantized ? _quantizedWeights[index] : _weights[index];
+}
+
+- (NSArray<GMUWeightedLatLng *> *)weightedData {
+  NSMutableArray<GMUWeightedLatLng *> *weightedData = [NSMutableArray arrayWithCapacity:_count];
+  for (NSUInteger i = 0; i < _count; i++) {
+    [weightedData addObject:[[GMUWeightedLatLng alloc] initWithCoordinate:[self coordinateAtIndex:i]
+                                                                intensity:[self weightAtIndex:i]]];
+  }
+  return weightedData;
+}
+
+- (PointDataset *)datasetByAggregatingToCellSize:(double)cellSize {
+  NSParameterAssert(cellSize > 0);
+  NSUInteger count = _count;
+  uint64_t cellsPerSide = MAX(1, (uint64_t)ceil(kEarthCircumference / cellSize));
+  NSUInteger chunkCount =
+      MAX(1, MIN(NSProcessInfo.processInfo.activeProcessorCount * 4,
+                 (count + kMinimumChunkSize - 1) / kMinimumChunkSize));
+  NSUInteger chunkSize = (count + chunkCount - 1) / chunkCount;
+
+  // Each chunk sums its points into its own table, then groups its cells by partition, recording
+  // where each partition's cells start.
+  NSMutableArray<NSMutableData *> *chunkCells = [NSMutableArray arrayWithCapacity:chunkCount];
+  for (NSUInteger chunk = 0; chunk < chunkCount; chunk++) {
+    [chunkCells addObject:[NSMutableData data]];
+  }
+  NSMutableData *startData =
+      [NSMutableData dataWithLength:chunkCount * (kPartitionCount + 1) * sizeof(NSUInteger)];
+  NSUInteger *starts = startData.mutableBytes;
+  dispatch_apply(chunkCount, DISPATCH_APPLY_AUTO, ^(size_t chunk) {
+    NSUInteger begin = MIN(count, chunk * chunkSize);
+    NSUInteger end = MIN(count, begin + chunkSize);
+    NSUInteger capacity = TableCapacity(end - begin);
+    NSMutableData *tableData = EmptyTable(capacity);
+    AggregateCell *table = tableData.mutableBytes;
+    for (NSUInteger i = begin; i < end; i++) {
+      CLLocationCoordinate2D coordinate = [self coordinateAtIndex:i];
+      double weight = [self weightAtIndex:i];
+      double x, y;
+      ProjectCoordinate(coordinate, &x, &y);
+      uint64_t column = MIN((uint64_t)fmax(x * cellsPerSide, 0), cellsPerSide - 1);
+      uint64_t row = MIN((uint64_t)fmax(y * cellsPerSide, 0), cellsPerSide - 1);
+      AddCell(table, capacity,
+              (AggregateCell){row * cellsPerSide + column, coordinate.latitude * weight,
+                              coordinate.longitude * weight, weight});
+    }
+
+    NSUInteger *chunkStarts = starts + chunk * (kPartitionCount + 1);
+    for (NSUInteger slot = 0; slot < capacity; slot++) {
+      if (table[slot].key != kEmptyCell) {
+        chunkStarts[table[slot].key % kPartitionCount + 1]++;
+      }
+    }
+    for (NSUInteger partition = 0; partition < kPartitionCount; partition++) {
+      chunkStarts[partition + 1] += chunkStarts[partition];
+    }
+    NSMutableData *cellData = chunkCells[chunk];
+    cellData.length = chunkStarts[kPartitionCount] * sizeof(AggregateCell);
+    AggregateCell *cells = cellData.mutableBytes;
+    // Scattering advances each partition's start to the next one's, so shift them back after.
+    for (NSUInteger slot = 0; slot < capacity; slot++) {
+      if (table[slot].key != kEmptyCell) {
+        cells[chunkStarts[table[slot].key % kPartitionCount]++] = table[slot];
+      }
+    }
+    memmove(chunkStarts + 1, chunkStarts, kPartitionCount * sizeof(NSUInteger));
+    chunkStarts[0] = 0;
+  });
+
+  // Each partition merges its cells from every chunk, then sorts them by key so the result does
+  // not depend on how the points were split.
+  NSMutableArray<NSMutableData *> *partitionCells =
+      [NSMutableArray arrayWithCapacity:kPartitionCount];
+  for (NSUInteger partition = 0; partition < kPartitionCount; partition++) {
+    [partitionCells addObject:[NSMutableData data]];
+  }
+  dispatch_apply(kPartitionCount, DISPATCH_APPLY_AUTO, ^(size_t partition) {
+    NSUInteger total = 0;
+    for (NSUInteger chunk = 0; chunk < chunkCount; chunk++) {
+      const NSUInteger *chunkStarts = starts + chunk * (kPartitionCount + 1);
+      total += chunkStarts[partition + 1] - chunkStarts[partition];
+    }
+    NSUInteger capacity = TableCapacity(total);
+    NSMutableData *tableData = EmptyTable(capacity);
+    AggregateCell *table = tableData.mutableBytes;
+    for (NSUInteger chunk = 0; chunk < chunkCount; chunk++) {
+      const NSUInteger *chunkStarts = starts + chunk * (kPartitionCount + 1);
+      const AggregateCell *cells = chunkCells[chunk].bytes;
+      for (NSUInteger i = chunkStarts[partition]; i < chunkStarts[partition + 1]; i++) {
+        AddCell(table, capacity, cells[i]);
+      }
+    }
+    NSMutableData *cellData = partitionCells[partition];
+    cellData.length = total * sizeof(AggregateCell);
+    AggregateCell *cells = cellData.mutableBytes;
+    NSUInteger used = 0;
+    for (NSUInteger slot = 0; slot < capacity; slot++) {
+      if (table[slot].key != kEmptyCell) {
+        cells[used++] = table[slot];
+      }
+    }
+    cellData.length = used * sizeof(AggregateCell);
+    qsort(cells, used, sizeof(AggregateCell), CompareCells);
+  });
+
+  NSUInteger cellCount = 0;
+  for (NSMutableData *cellData in partitionCells) {
+    cellCount += cellData.length / sizeof(AggregateCell);
+  }
+  NSMutableData *data = DatasetData(cellCount, _quantized);
+  NSUInteger index = 0;
+  for (NSMutableData *cellData in partitionCells) {
+    const AggregateCell *cells = cellData.bytes;
+    for (NSUInteger i = 0; i < cellData.length / sizeof(AggregateCell); i++) {
+      AggregateCell cell = cells[i];
+      double latitude;
+      double longitude;
+      if (cell.weight != 0) {
+        latitude = cell.weightedLatitude / cell.weight;
+        longitude = cell.weightedLongitude / cell.weight;
+      } else {
+        // Cells whose weights cancel out have no centroid, so they sit at their centre.
+        double x = ((cell.key % cellsPerSide) + 0.5) / cellsPerSide;
+        double y = ((cell.key / cellsPerSide) + 0.5) / cellsPerSide;
+        CLLocationCoordinate2D centre = UnprojectPoint(x, y);
+        latitude = centre.latitude;
+        longitude = centre.longitude;
+      }
+      SetDatasetPoint(data, cellCount, _quantized, index++, latitude, longitude, cell.weight);
+    }
+  }
+  return [[PointDataset alloc] initWithData:data error:nil];
+}
+
++ (nullable NSData *)dataWithJSONObject:(id)rows quantized:(BOOL)quantized error:(NSError **)error {
+  if (![rows isKindOfClass:[NSArray class]]) {
+    if (error) {
+      *error = DatasetError(PointDatasetErrorInvalidJSON, @"The JSON is not an array.");
+    }
+    return nil;
+  }
+  NSUInteger count = [rows count];
+  NSMutableData *data = DatasetData(count, quantized);
+  for (NSUInteger i = 0; i < count; i++) {
+    NSDictionary *row = rows[i];
+    id latitude = [row isKindOfClass:[NSDictionary class]] ? row[@"lat"] : nil;
+    id longitude = [row isKindOfClass:[NSDictionary class]] ? row[@"lng"] : nil;
+    id intensity = [row isKindOfClass:[NSDictionary class]] ? row[@"intensity"] : nil;
+    if (![latitude isKindOfClass:[NSNumber class]] || ![longitude isKindOfClass:[NSNumber class]] ||
+        (intensity && ![intensity isKindOfClass:[NSNumber class]])) {
+      if (error) {
+        NSString *description =
+            [NSString stringWithFormat:@"Row %lu has no numeric lat and lng.", (unsigned long)i];
+        *error = DatasetError(PointDatasetErrorInvalidJSON, description);
+      }
+      return nil;
+    }
+    SetDatasetPoint(data, count, quantized, i, [latitude doubleValue], [longitude doubleValue],
+                    intensity ? [intensity doubleValue] : 1);
+  }
+  return data;
+}
+
++ (BOOL)convertJSONAtURL:(NSURL *)jsonURL
+                   toURL:(NSURL *)url
+               quantized:(BOOL)quantized
+                   error:(NSError **)error {
+  NSData *json = [NSData dataWithContentsOfURL:jsonURL options:0 error:error];
+  if (!json) {
+    return NO;
+  }
+  id rows = [NSJSONSerialization JSONObjectWithData:json options:0 error:error];
+  if (!rows) {
+    return NO;
+  }
+  NSData *data = [self dataWithJSONObject:rows quantized:quantized error:error];
+  return data && [data writeToURL:url options:NSDataWritingAtomic error:error];
+}
+
+@end
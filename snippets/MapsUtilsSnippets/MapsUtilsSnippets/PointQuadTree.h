@@ -0,0 +1,136 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import <CoreLocation/CoreLocation.h>
+#import <Foundation/Foundation.h>
+@import GoogleMapsUtils;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A point quadtree with the same surface as GQTPointQuadTree, whose nodes and points live in flat
+ * buffers instead of one object each.
+ *
+ * Nodes are addressed by integer index, and each leaf keeps its points' coordinates together in a
+ * block of slots, so a range query reads contiguous memory and never messages an item. Points can
+ * be added without wrapping them in an item at all, and queried into a caller-owned index buffer
+ * without allocating. Items and bare points are tracked separately: item searches return only
+ * items, and index searches return only bare points.
+ */
+@interface PointQuadTree : NSObject
+
+/** Number of points in the tree. */
+@property(nonatomic, readonly) NSUInteger count;
+
+- (instancetype)initWithBounds:(GQTBounds)bounds NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Builds a tree over |count| bare points at once. This is much faster than adding them one at a
+ * time, and is unaffected by the order the points arrive in.
+ *
+ * Each point's path from the root is computed in parallel and encoded as a Morton (Z-order) key,
+ * the keys are radix sorted across all cores, and the tree is then laid out in a single pass over
+ * the sorted keys, with every leaf's points in neighbouring blocks. The result is the same tree
+ * that adding the points one by one would build. Point |i| is reported under index |i|; points
+ * outside |bounds| are left out.
+ */
+- (instancetype)initWithBounds:(GQTBounds)bounds
+                        points:(const GQTPoint *)points
+                         count:(NSUInteger)count;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Adds |item| at its point.
+ *
+ * @return NO if |item| is nil or its point lies outside the tree's bounds.
+ */
+- (BOOL)add:(nullable id<GQTPointQuadTreeItem>)item;
+
+/**
+ * Removes |item|, which must still be at the point it was added with.
+ *
+ * @return NO if |item| is not in the tree.
+ */
+- (BOOL)remove:(id<GQTPointQuadTreeItem>)item;
+
+/** Removes every point. */
+- (void)clear;
+
+/** Returns the items whose points lie within |searchBounds|. Bare points are not returned. */
+- (NSArray<id<GQTPointQuadTreeItem>> *)searchWithBounds:(GQTBounds)searchBounds;
+
+/**
+ * Adds a bare point.
+ *
+ * @return The index reported for the point by searches, or NSNotFound if it lies outside the
+ *     tree's bounds. Indices count up from 0 in the order bare points are added.
+ */
+- (NSUInteger)addPoint:(GQTPoint)point;
+
+/**
+ * Writes the indices of up to |capacity| bare points within |searchBounds| to |indices|, in no
+ * particular order.
+ *
+ * @return The number of points found, which may exceed |capacity|.
+ */
+- (NSUInteger)searchWithBounds:(GQTBounds)searchBounds
+                       indices:(uint32_t *)indices
+                      capacity:(NSUInteger)capacity;
+
+/**
+ * Writes the indices of the |k| bare points nearest |point| to |indices|, nearest first, and their
+ * distances to |distances|. Both buffers need room for |k| values, and hold the candidates found
+ * so far while the search runs, so it allocates nothing. Quadrants are searched nearest first,
+ * and skipped once they lie further away than the |k|th nearest point found so far.
+ *
+ * @return The number of points written, which is |k| unless the tree has fewer bare points.
+ */
+- (NSUInteger)nearestPoints:(NSUInteger)k
+                    toPoint:(GQTPoint)point
+                    indices:(uint32_t *)indices
+                  distances:(double *)distances;
+
+/**
+ * Finds the |k| nearest bare points to each of |count| probe points, spreading the probes across
+ * all cores. The results for probe |i| start at |indices + i * k| and |distances + i * k|, and
+ * their number is written to |counts[i]|.
+ */
+- (void)nearestPoints:(NSUInteger)k
+             toPoints:(const GQTPoint *)points
+                count:(NSUInteger)count
+              indices:(uint32_t *)indices
+            distances:(double *)distances
+               counts:(NSUInteger *)counts;
+
+/**
+ * Finds the bare points within |radius| metres of |center| along the Earth's surface, taking the
+ * tree's points to be GMSMapPoints as GMSProject returns them. The nearest |capacity| are written
+ * to |indices|, with their distances in metres to |distances|, nearest first. As with
+ * -nearestPoints:toPoint:indices:distances:, the buffers hold the candidates during the search.
+ *
+ * @return The number of points within |radius|, which may exceed |capacity|.
+ */
+- (NSUInteger)searchWithinMeters:(double)radius
+                    ofCoordinate:(CLLocationCoordinate2D)center
+                         indices:(uint32_t *)indices
+                       distances:(double *)distances
+                        capacity:(NSUInteger)capacity;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,859 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "PointQuadTree.h"
+
+// Points a leaf holds before it splits, which is also the number of slots in a block.
+static const uint32_t kBlockCapacity = 64;
+
+// Leaves at this depth never split; they chain further blocks instead.
+static const NSUInteger kMaxDepth = 30;
+
+// Indices returned by a search before -searchWithBounds: falls back to a heap buffer.
+static const NSUInteger kSearchBufferCapacity = 256;
+
+static const uint32_t kNone = UINT32_MAX;
+
+// Set in a slot's index when the point belongs to an item rather than being a bare point.
+static const uint32_t kItemFlag = 1u << 31;
+
+// Bulk loading sorts Morton keys this many bits per pass.
+static const NSUInteger kRadixBits = 8;
+static const NSUInteger kRadixSize = 1 << kRadixBits;
+
+// Fewest points bulk loading hands to one worker at a time.
+static const NSUInteger kMinimumChunkSize = 4096;
+
+// Sorts after every key of a point inside the bounds, whose keys use only 2 * kMaxDepth bits.
+static const uint64_t kOutsideKey = UINT64_MAX;
+
+// Mean radius of the Earth in metres, as GMSGeometryDistance uses.
+static const double kEarthRadius = 6371009;
+
+static const double kMaximumMercatorLatitude = 85.051128779806589;
+
+typedef struct {
+  // Children of an internal node are |firstChild| to |firstChild + 3|, one per quadrant. Leaves
+  // have no children.
+  uint32_t firstChild;
+  // First block of a leaf's slots, or kNone while the leaf is empty.
+  uint32_t firstBlock;
+  // Number of points in a leaf.
+  uint32_t count;
+} Node;
+
+typedef struct {
+  uint32_t node;
+  GQTBounds bounds;
+  // Whether the node lies entirely inside the search bounds, so its points need no test.
+  BOOL contained;
+} SearchEntry;
+
+static BOOL BoundsContainPoint(GQTBounds bounds, double x, double y) {
+  return x >= bounds.minX && x <= bounds.maxX && y >= bounds.minY && y <= bounds.maxY;
+}
+
+static BOOL BoundsIntersect(GQTBounds a, GQTBounds b) {
+  return a.minX <= b.maxX && b.minX <= a.maxX && a.minY <= b.maxY && b.minY <= a.maxY;
+}
+
+static BOOL BoundsContainBounds(GQTBounds outer, GQTBounds inner) {
+  return inner.minX >= outer.minX && inner.maxX <= outer.maxX && inner.minY >= outer.minY &&
+         inner.maxY <= outer.maxY;
+}
+
+/** Returns the squared distance from the point to the nearest part of |bounds|. */
+static double BoundsDistanceSquared(GQTBounds bounds, double x, double y) {
+  double dx = fmax(fmax(bounds.minX - x, x - bounds.maxX), 0);
+  double dy = fmax(fmax(bounds.minY - y, y - bounds.maxY), 0);
+  return dx * dx + dy * dy;
+}
+
+/**
+ * Moves entries down a max-heap of |count| entries keyed by distance, from |position| until the
+ * new entry fits there.
+ */
+static void HeapSiftDown(uint32_t *indices, double *distances, NSUInteger count,
+                         NSUInteger position, uint32_t index, double distance) {
+  while (2 * position + 1 < count) {
+    NSUInteger child = 2 * position + 1;
+    if (child + 1 < count && distances[child + 1] > distances[child]) {
+      child++;
+    }
+    if (distances[child] <= distance) {
+      break;
+    }
+    indices[position] = indices[child];
+    distances[position] = distances[child];
+    position = child;
+  }
+  indices[position] = index;
+  distances[position] = distance;
+}
+
+/**
+ * Adds a candidate to a max-heap of at most |capacity| entries keyed by distance. Once the heap
+ * is full, a candidate replaces the furthest entry if it is nearer.
+ */
+static void HeapPush(uint32_t *indices, double *distances, NSUInteger *count,
+                     NSUInteger capacity, uint32_t index, double distance) {
+  if (*count < capacity) {
+    NSUInteger position = (*count)++;
+    while (position > 0 && distances[(position - 1) / 2] < distance) {
+      indices[position] = indices[(position - 1) / 2];
+      distances[position] = distances[(position - 1) / 2];
+      position = (position - 1) / 2;
+    }
+    indices[position] = index;
+    distances[position] = distance;
+  } else if (capacity > 0 && distance < distances[0]) {
+    HeapSiftDown(indices, distances, capacity, 0, index, distance);
+  }
+}
+
+/** Sorts a max-heap of |count| entries in place, nearest first. */
+static void HeapSort(uint32_t *indices, double *distances, NSUInteger count) {
+  for (NSUInteger end = count; end > 1; end--) {
+    uint32_t index = indices[end - 1];
+    double distance = distances[end - 1];
+    indices[end - 1] = indices[0];
+    distances[end - 1] = distances[0];
+    HeapSiftDown(indices, distances, end - 1, 0, index, distance);
+  }
+}
+
+/** Returns the y of a GMSMapPoint at |latitude| radians. */
+static double MapPointY(double latitude) {
+  double limit = kMaximumMercatorLatitude * M_PI / 180;
+  return asinh(tan(fmax(fmin(latitude, limit), -limit))) / M_PI;
+}
+
+/** Returns the distance in metres between two points given in radians, by the haversine formula. */
+static double GreatCircleDistance(double latitude1, double longitude1, double latitude2,
+                                  double longitude2) {
+  double sinHalfLatitude = sin((latitude2 - latitude1) / 2);
+  double sinHalfLongitude = sin((longitude2 - longitude1) / 2);
+  double h = sinHalfLatitude * sinHalfLatitude +
+             cos(latitude1) * cos(latitude2) * sinHalfLongitude * sinHalfLongitude;
+  return 2 * kEarthRadius * asin(fmin(1, sqrt(h)));
+}
+
+typedef struct {
+  uint32_t node;
+  // Range of sorted points under the node.
+  uint32_t begin;
+  uint32_t end;
+  uint32_t depth;
+} BuildEntry;
+
+typedef struct {
+  uint32_t firstBlock;
+  // Range of sorted points in the leaf, which fill its blocks in order.
+  uint32_t begin;
+  uint32_t end;
+} BuildLeaf;
+
+/** Returns the quadrant of |bounds| containing the point: bit 0 set for east, bit 1 for north. */
+static NSUInteger QuadrantForPoint(GQTBounds bounds, double x, double y) {
+  return (x >= (bounds.minX + bounds.maxX) / 2 ? 1 : 0) |
+         (y >= (bounds.minY + bounds.maxY) / 2 ? 2 : 0);
+}
+
+static GQTBounds QuadrantBounds(GQTBounds bounds, NSUInteger quadrant) {
+  double midX = (bounds.minX + bounds.maxX) / 2;
+  double midY = (bounds.minY + bounds.maxY) / 2;
+  if (quadrant & 1) {
+    bounds.minX = midX;
+  } else {
+    bounds.maxX = midX;
+  }
+  if (quadrant & 2) {
+    bounds.minY = midY;
+  } else {
+    bounds.maxY = midY;
+  }
+  return bounds;
+}
+
+/**
+ * Returns the Morton key of a point inside |bounds|: its quadrant at every level from the root
+ * down to kMaxDepth, two bits a level with the root's highest. Sorting by key groups the points of
+ * every subtree together, ordered by quadrant.
+ */
+static uint64_t MortonKey(GQTBounds bounds, double x, double y) {
+  uint64_t key = 0;
+  for (NSUInteger level = 0; level < kMaxDepth; level++) {
+    NSUInteger quadrant = QuadrantForPoint(bounds, x, y);
+    bounds = QuadrantBounds(bounds, quadrant);
+    key = key << 2 | quadrant;
+  }
+  return key;
+}
+
+/** Returns the quadrant a point with Morton key |key| takes below a node at |depth|. */
+static NSUInteger MortonQuadrant(uint64_t key, NSUInteger depth) {
+  return (NSUInteger)(key >> (2 * (kMaxDepth - 1 - depth))) & 3;
+}
+
+/** Returns the first position in the sorted |keys| from |begin| to |end| at or past |quadrant|. */
+static uint32_t QuadrantStart(const uint64_t *keys, uint32_t begin, uint32_t end, NSUInteger depth,
+                              NSUInteger quadrant) {
+  while (begin < end) {
+    uint32_t middle = begin + (end - begin) / 2;
+    if (MortonQuadrant(keys[middle], depth) < quadrant) {
+      begin = middle + 1;
+    } else {
+      end = middle;
+    }
+  }
+  return begin;
+}
+
+/**
+ * Sorts |count| keys and the indices alongside them, least significant digit first, using the
+ * scratch buffers between passes. Each pass counts digits per chunk in parallel, gives every chunk
+ * its own output offsets for each digit, then scatters the chunks in parallel, so the sort stays
+ * stable without locks. Passes on a digit all keys share are skipped.
+ */
+static void RadixSort(uint64_t *keys, uint32_t *indices, uint64_t *scratchKeys,
+                      uint32_t *scratchIndices, NSUInteger count, NSUInteger chunkCount) {
+  NSUInteger chunkSize = (count + chunkCount - 1) / chunkCount;
+  NSMutableData *offsetData =
+      [NSMutableData dataWithLength:chunkCount * kRadixSize * sizeof(NSUInteger)];
+  NSUInteger *offsets = offsetData.mutableBytes;
+  BOOL inScratch = NO;
+  for (NSUInteger shift = 0; shift < 64; shift += kRadixBits) {
+    const uint64_t *sourceKeys = inScratch ? scratchKeys : keys;
+    const uint32_t *sourceIndices = inScratch ? scratchIndices : indices;
+    uint64_t *targetKeys = inScratch ? keys : scratchKeys;
+    uint32_t *targetIndices = inScratch ? indices : scratchIndices;
+    memset(offsets, 0, offsetData.length);
+    dispatch_apply(chunkCount, DISPATCH_APPLY_AUTO, ^(size_t chunk) {
+      NSUInteger *histogram = offsets + chunk * kRadixSize;
+      NSUInteger end = MIN(count, (chunk + 1) * chunkSize);
+      for (NSUInteger i = chunk * chunkSize; i < end; i++) {
+        histogram[(sourceKeys[i] >> shift) & (kRadixSize - 1)]++;
+      }
+    });
+    // Lay the output out digit by digit, and within a digit chunk by chunk.
+    BOOL shared = NO;
+    NSUInteger position = 0;
+    for (NSUInteger digit = 0; digit < kRadixSize; digit++) {
+      NSUInteger digitStart = position;
+      for (NSUInteger chunk = 0; chunk < chunkCount; chunk++) {
+        NSUInteger digitCount = offsets[chunk * kRadixSize + digit];
+        offsets[chunk * kRadixSize + digit] = position;
+        position += digitCount;
+      }
+      shared = shared || position - digitStart == count;
+    }
+    if (shared) {
+      continue;
+    }
+    dispatch_apply(chunkCount, DISPATCH_APPLY_AUTO, ^(size_t chunk) {
+      NSUInteger *next = offsets + chunk * kRadixSize;
+      NSUInteger end = MIN(count, (chunk + 1) * chunkSize);
+      for (NSUInteger i = chunk * chunkSize; i < end; i++) {
+        NSUInteger target = next[(sourceKeys[i] >> shift) & (kRadixSize - 1)]++;
+        targetKeys[target] = sourceKeys[i];
+        targetIndices[target] = sourceIndices[i];
+      }
+    });
+    inScratch = !inScratch;
+  }
+  if (inScratch) {
+    memcpy(keys, scratchKeys, count * sizeof(uint64_t));
+    memcpy(indices, scratchIndices, count * sizeof(uint32_t));
+  }
+}
+
+@implementation PointQuadTree {
+  GQTBounds _bounds;
+
+  // Node 0 is the root.
+  NSMutableData *_nodes;
+
+  // Blocks of kBlockCapacity slots. Slot |i| of block |b| is at |b * kBlockCapacity + i| and holds
+  // a point's coordinates and index, with kItemFlag set for an item's index into |_items|. Blocks
+  // of a leaf at kMaxDepth are chained by |_nextBlocks|.
+  NSMutableData *_slotX;
+  NSMutableData *_slotY;
+  NSMutableData *_slotIndices;
+  NSMutableData *_nextBlocks;
+  NSMutableData *_freeBlocks;
+
+  // Every item added, or NSNull once removed.
+  NSMutableArray *_items;
+
+  // Number of indices handed out to bare points.
+  NSUInteger _pointCount;
+}
+
+- (instancetype)initWithBounds:(GQTBounds)bounds {
+  if ((self = [super init])) {
+    _bounds = bounds;
+    [self clear];
+  }
+  return self;
+}
+
+- (instancetype)initWithBounds:(GQTBounds)bounds
+                        points:(const GQTPoint *)points
+                         count:(NSUInteger)count {
+  NSParameterAssert(count < kItemFlag);
+  if ((self = [self initWithBounds:bounds])) {
+    [self loadPoints:points count:count];
+  }
+  return self;
+}
+
+- (void)clear {
+  Node root = {kNone, kNone, 0};
+  _nodes = [NSMutableData dataWithBytes:&root length:sizeof(root)];
+  _slotX = [NSMutableData data];
+  _slotY = [NSMutableData data];
+  _slotIndices = [NSMutableData data];
+  _nextBlocks = [NSMutableData data];
+  _freeBlocks = [NSMutableData data];
+  _items = [NSMutableArray array];
+  _pointCount = 0;
+  _count = 0;
+}
+
+- (BOOL)add:(nullable id<GQTPointQuadTreeItem>)item {
+  if (!item) {
+    return NO;
+  }
+  GQTPoint point = item.point;
+  if (![self insertX:point.x y:point.y index:(uint32_t)_items.count | kItemFlag]) {
+    return NO;
+  }
+  [_items addObject:item];
+  return YES;
+}
+
+- (NSUInteger)addPoint:(GQTPoint)point {
+  NSUInteger index = _pointCount;
+  if (![self insertX:point.x y:point.y index:(uint32_t)index]) {
+    return NSNotFound;
+  }
+  _pointCount++;
+  return index;
+}
+
+- (BOOL)remove:(id<GQTPointQuadTreeItem>)item {
+  GQTPoint point = item.point;
+  if (!BoundsContainPoint(_bounds, point.x, point.y)) {
+    return NO;
+  }
+  uint32_t nodeIndex = [self leafForX:point.x y:point.y];
+  Node *node = (Node *)_nodes.mutableBytes + nodeIndex;
+  double *slotX = _slotX.mutableBytes;
+  double *slotY = _slotY.mutableBytes;
+  uint32_t *slotIndices = _slotIndices.mutableBytes;
+  uint32_t *nextBlocks = _nextBlocks.mutableBytes;
+
+  // Find the item's slot, checking coordinates before touching the item array.
+  uint32_t block = node->firstBlock;
+  uint32_t slot = kNone;
+  for (uint32_t i = 0; i < node->count && slot == kNone; i++) {
+    if (i > 0 && i % kBlockCapacity == 0) {
+      block = nextBlocks[block];
+    }
+    uint32_t candidate = block * kBlockCapacity + i % kBlockCapacity;
+    if (slotX[candidate] == point.x && slotY[candidate] == point.y &&
+        (slotIndices[candidate] & kItemFlag) &&
+        _items[slotIndices[candidate] & ~kItemFlag] == item) {
+      slot = candidate;
+    }
+  }
+  if (slot == kNone) {
+    return NO;
+  }
+
+  // Move the leaf's last point into the freed slot, then release the last block if it emptied.
+  uint32_t lastPosition = node->count - 1;
+  uint32_t previousBlock = kNone;
+  uint32_t lastBlock = node->firstBlock;
+  for (uint32_t i = 0; i < lastPosition / kBlockCapacity; i++) {
+    previousBlock = lastBlock;
+    lastBlock = nextBlocks[lastBlock];
+  }
+  uint32_t lastSlot = lastBlock * kBlockCapacity + lastPosition % kBlockCapacity;
+  _items[slotIndices[slot] & ~kItemFlag] = [NSNull null];
+  slotX[slot] = slotX[lastSlot];
+  slotY[slot] = slotY[lastSlot];
+  slotIndices[slot] = slotIndices[lastSlot];
+  node->count--;
+  if (lastPosition % kBlockCapacity == 0) {
+    if (previousBlock == kNone) {
+      node->firstBlock = kNone;
+    } else {
+      nextBlocks[previousBlock] = kNone;
+    }
+    [_freeBlocks appendBytes:&lastBlock length:sizeof(lastBlock)];
+  }
+  _count--;
+  return YES;
+}
+
+- (NSArray<id<GQTPointQuadTreeItem>> *)searchWithBounds:(GQTBounds)searchBounds {
+  uint32_t buffer[kSearchBufferCapacity];
+  const uint32_t *indices = buffer;
+  NSUInteger count = [self searchWithBounds:searchBounds
+                                      items:YES
+                                    indices:buffer
+                                   capacity:kSearchBufferCapacity];
+  NSMutableData *heapBuffer;
+  if (count > kSearchBufferCapacity) {
+    heapBuffer = [NSMutableData dataWithLength:count * sizeof(uint32_t)];
+    [self searchWithBounds:searchBounds items:YES indices:heapBuffer.mutableBytes capacity:count];
+    indices = heapBuffer.bytes;
+  }
+  NSMutableArray<id<GQTPointQuadTreeItem>> *items = [NSMutableArray arrayWithCapacity:count];
+  for (NSUInteger i = 0; i < count; i++) {
+    [items addObject:_items[indices[i] & ~kItemFlag]];
+  }
+  return items;
+}
+
+- (NSUInteger)searchWithBounds:(GQTBounds)searchBounds
+                       indices:(uint32_t *)indices
+                      capacity:(NSUInteger)capacity {
+  return [self searchWithBounds:searchBounds items:NO indices:indices capacity:capacity];
+}
+
+- (NSUInteger)nearestPoints:(NSUInteger)k
+                    toPoint:(GQTPoint)point
+                    indices:(uint32_t *)indices
+                  distances:(double *)distances {
+  const Node *nodes = _nodes.bytes;
+  const double *slotX = _slotX.bytes;
+  const double *slotY = _slotY.bytes;
+  const uint32_t *slotIndices = _slotIndices.bytes;
+  const uint32_t *nextBlocks = _nextBlocks.bytes;
+
+  // Distances stay squared until the end. Each level replaces one entry with four, so the stack
+  // never grows past this.
+  SearchEntry stack[3 * kMaxDepth + 4];
+  NSUInteger depth = 0;
+  stack[depth++] = (SearchEntry){0, _bounds, NO};
+  NSUInteger found = 0;
+  while (depth > 0) {
+    SearchEntry entry = stack[--depth];
+    if (k == 0 ||
+        (found == k && BoundsDistanceSquared(entry.bounds, point.x, point.y) >= distances[0])) {
+      continue;
+    }
+    const Node *node = &nodes[entry.node];
+    if (node->firstChild != kNone) {
+      // Push the quadrants furthest first, so the nearest is searched first.
+      SearchEntry children[4];
+      double childDistances[4];
+      for (NSUInteger quadrant = 0; quadrant < 4; quadrant++) {
+        GQTBounds bounds = QuadrantBounds(entry.bounds, quadrant);
+        double distance = BoundsDistanceSquared(bounds, point.x, point.y);
+        NSUInteger i = quadrant;
+        while (i > 0 && childDistances[i - 1] < distance) {
+          children[i] = children[i - 1];
+          childDistances[i] = childDistances[i - 1];
+          i--;
+        }
+        children[i] = (SearchEntry){node->firstChild + (uint32_t)quadrant, bounds, NO};
+        childDistances[i] = distance;
+      }
+      for (NSUInteger i = 0; i < 4; i++) {
+        stack[depth++] = children[i];
+      }
+      continue;
+    }
+    uint32_t block = node->firstBlock;
+    for (uint32_t start = 0; start < node->count; start += kBlockCapacity) {
+      uint32_t first = block * kBlockCapacity;
+      uint32_t end = first + MIN(kBlockCapacity, node->count - start);
+      for (uint32_t slot = first; slot < end; slot++) {
+        if ((slotIndices[slot] & kItemFlag) == 0) {
+          double dx = slotX[slot] - point.x;
+          double dy = slotY[slot] - point.y;
+          HeapPush(indices, distances, &found, k, slotIndices[slot], dx * dx + dy * dy);
+        }
+      }
+      block = nextBlocks[block];
+    }
+  }
+  HeapSort(indices, distances, found);
+  for (NSUInteger i = 0; i < found; i++) {
+    distances[i] = sqrt(distances[i]);
+  }
+  return found;
+}
+
+- (void)nearestPoints:(NSUInteger)k
+             toPoints:(const GQTPoint *)points
+                count:(NSUInteger)count
+              indices:(uint32_t *)indices
+            distances:(double *)distances
+               counts:(NSUInteger *)counts {
+  dispatch_apply(count, DISPATCH_APPLY_AUTO, ^(size_t i) {
+    counts[i] = [self nearestPoints:k
+                            toPoint:points[i]
+                            indices:indices + i * k
+                          distances:distances + i * k];
+  });
+}
+
+- (NSUInteger)searchWithinMeters:(double)radius
+                    ofCoordinate:(CLLocationCoordinate2D)center
+                         indices:(uint32_t *)indices
+                       distances:(double *)distances
+                        capacity:(NSUInteger)capacity {
+  const Node *nodes = _nodes.bytes;
+  const double *slotX = _slotX.bytes;
+  const double *slotY = _slotY.bytes;
+  const uint32_t *slotIndices = _slotIndices.bytes;
+  const uint32_t *nextBlocks = _nextBlocks.bytes;
+
+  // Bound the circle by latitudes |angle| either side of the centre, and by the longitudes where
+  // it touches its east and west tangents, unless it reaches a pole.
+  double latitude = center.latitude * M_PI / 180;
+  double longitude = center.longitude * M_PI / 180;
+  double angle = radius / kEarthRadius;
+  double minX = -1;
+  double maxX = 1;
+  if (latitude - angle > -M_PI_2 && latitude + angle < M_PI_2 && sin(angle) < cos(latitude)) {
+    double deltaLongitude = asin(sin(angle) / cos(latitude));
+    minX = (longitude - deltaLongitude) / M_PI;
+    maxX = (longitude + deltaLongitude) / M_PI;
+  }
+  double minY = MapPointY(latitude - angle);
+  double maxY = MapPointY(latitude + angle);
+
+  // A circle crossing the antimeridian is searched as two boxes, one either side of it.
+  GQTBounds boxes[2];
+  NSUInteger boxCount = 0;
+  boxes[boxCount++] = (GQTBounds){fmax(minX, -1), minY, fmin(maxX, 1), maxY};
+  if (minX < -1) {
+    boxes[boxCount++] = (GQTBounds){minX + 2, minY, 1, maxY};
+  } else if (maxX > 1) {
+    boxes[boxCount++] = (GQTBounds){-1, minY, maxX - 2, maxY};
+  }
+
+  NSUInteger found = 0;
+  NSUInteger kept = 0;
+  for (NSUInteger box = 0; box < boxCount; box++) {
+    GQTBounds searchBounds = boxes[box];
+    if (!BoundsIntersect(searchBounds, _bounds)) {
+      continue;
+    }
+    SearchEntry stack[3 * kMaxDepth + 4];
+    NSUInteger depth = 0;
+    stack[depth++] = (SearchEntry){0, _bounds, BoundsContainBounds(searchBounds, _bounds)};
+    while (depth > 0) {
+      SearchEntry entry = stack[--depth];
+      const Node *node = &nodes[entry.node];
+      if (node->firstChild != kNone) {
+        for (NSUInteger quadrant = 0; quadrant < 4; quadrant++) {
+          GQTBounds bounds = QuadrantBounds(entry.bounds, quadrant);
+          if (entry.contained || BoundsIntersect(searchBounds, bounds)) {
+            BOOL contained = entry.contained || BoundsContainBounds(searchBounds, bounds);
+            stack[depth++] =
+                (SearchEntry){node->firstChild + (uint32_t)quadrant, bounds, contained};
+          }
+        }
+        continue;
+      }
+      uint32_t block = node->firstBlock;
+      for (uint32_t start = 0; start < node->count; start += kBlockCapacity) {
+        uint32_t first = block * kBlockCapacity;
+        uint32_t end = first + MIN(kBlockCapacity, node->count - start);
+        for (uint32_t slot = first; slot < end; slot++) {
+          if ((slotIndices[slot] & kItemFlag) != 0 ||
+              !(entry.contained || BoundsContainPoint(searchBounds, slotX[slot], slotY[slot]))) {
+            continue;
+          }
+          double distance = GreatCircleDistance(latitude, longitude,
+                                                atan(sinh(slotY[slot] * M_PI)), slotX[slot] * M_PI);
+          if (distance <= radius) {
+            found++;
+            HeapPush(indices, distances, &kept, capacity, slotIndices[slot], distance);
+          }
+        }
+        block = nextBlocks[block];
+      }
+    }
+  }
+  HeapSort(indices, distances, kept);
+  return found;
+}
+
+#pragma mark - Private
+
+/** Finds either the items' points or the bare points within |searchBounds|. */
+- (NSUInteger)searchWithBounds:(GQTBounds)searchBounds
+                         items:(BOOL)items
+                       indices:(uint32_t *)indices
+                      capacity:(NSUInteger)capacity {
+  if (!BoundsIntersect(searchBounds, _bounds)) {
+    return 0;
+  }
+  const Node *nodes = _nodes.bytes;
+  const double *slotX = _slotX.bytes;
+  const double *slotY = _slotY.bytes;
+  const uint32_t *slotIndices = _slotIndices.bytes;
+  const uint32_t *nextBlocks = _nextBlocks.bytes;
+
+  // Each level replaces one entry with at most four, so the stack never grows past this.
+  SearchEntry stack[3 * kMaxDepth + 4];
+  NSUInteger depth = 0;
+  stack[depth++] = (SearchEntry){0, _bounds, BoundsContainBounds(searchBounds, _bounds)};
+  uint32_t flag = items ? kItemFlag : 0;
+  NSUInteger found = 0;
+  while (depth > 0) {
+    SearchEntry entry = stack[--depth];
+    const Node *node = &nodes[entry.node];
+    if (node->firstChild != kNone) {
+      for (NSUInteger quadrant = 0; quadrant < 4; quadrant++) {
+        GQTBounds bounds = QuadrantBounds(entry.bounds, quadrant);
+        if (entry.contained || BoundsIntersect(searchBounds, bounds)) {
+          BOOL contained = entry.contained || BoundsContainBounds(searchBounds, bounds);
+          stack[depth++] = (SearchEntry){node->firstChild + (uint32_t)quadrant, bounds, contained};
+        }
+      }
+      continue;
+    }
+    uint32_t block = node->firstBlock;
+    for (uint32_t start = 0; start < node->count; start += kBlockCapacity) {
+      uint32_t first = block * kBlockCapacity;
+      uint32_t end = first + MIN(kBlockCapacity, node->count - start);
+      for (uint32_t slot = first; slot < end; slot++) {
+        if ((slotIndices[slot] & kItemFlag) == flag &&
+            (entry.contained || BoundsContainPoint(searchBounds, slotX[slot], slotY[slot]))) {
+          if (found < capacity) {
+            indices[found] = slotIndices[slot];
+          }
+          found++;
+        }
+      }
+      block = nextBlocks[block];
+    }
+  }
+  return found;
+}
+
+/** Returns the leaf whose bounds contain the point. */
+- (uint32_t)leafForX:(double)x y:(double)y {
+  const Node *nodes = _nodes.bytes;
+  uint32_t nodeIndex = 0;
+  GQTBounds bounds = _bounds;
+  while (nodes[nodeIndex].firstChild != kNone) {
+    NSUInteger quadrant = QuadrantForPoint(bounds, x, y);
+    bounds = QuadrantBounds(bounds, quadrant);
+    nodeIndex = nodes[nodeIndex].firstChild + (uint32_t)quadrant;
+  }
+  return nodeIndex;
+}
+
+- (BOOL)insertX:(double)x y:(double)y index:(uint32_t)index {
+  if (!BoundsContainPoint(_bounds, x, y)) {
+    return NO;
+  }
+  uint32_t nodeIndex = 0;
+  GQTBounds bounds = _bounds;
+  NSUInteger depth = 0;
+  while (YES) {
+    const Node *node = (const Node *)_nodes.bytes + nodeIndex;
+    if (node->firstChild != kNone) {
+      NSUInteger quadrant = QuadrantForPoint(bounds, x, y);
+      bounds = QuadrantBounds(bounds, quadrant);
+      nodeIndex = node->firstChild + (uint32_t)quadrant;
+      depth++;
+    } else if (node->count >= kBlockCapacity && depth < kMaxDepth) {
+      [self splitLeaf:nodeIndex bounds:bounds];
+    } else {
+      [self appendToLeaf:nodeIndex x:x y:y index:index];
+      _count++;
+      return YES;
+    }
+  }
+}
+
+/** Turns a full leaf into an internal node, handing its points to four new leaves. */
+- (void)splitLeaf:(uint32_t)nodeIndex bounds:(GQTBounds)bounds {
+  // A leaf below kMaxDepth holds exactly one block.
+  Node leaf = ((const Node *)_nodes.bytes)[nodeIndex];
+  double x[kBlockCapacity];
+  double y[kBlockCapacity];
+  uint32_t indices[kBlockCapacity];
+  uint32_t first = leaf.firstBlock * kBlockCapacity;
+  memcpy(x, (const double *)_slotX.bytes + first, leaf.count * sizeof(double));
+  memcpy(y, (const double *)_slotY.bytes + first, leaf.count * sizeof(double));
+  memcpy(indices, (const uint32_t *)_slotIndices.bytes + first, leaf.count * sizeof(uint32_t));
+  [_freeBlocks appendBytes:&leaf.firstBlock length:sizeof(leaf.firstBlock)];
+
+  uint32_t firstChild = (uint32_t)(_nodes.length / sizeof(Node));
+  Node children[4] = {{kNone, kNone, 0}, {kNone, kNone, 0}, {kNone, kNone, 0}, {kNone, kNone, 0}};
+  [_nodes appendBytes:children length:sizeof(children)];
+  Node *node = (Node *)_nodes.mutableBytes + nodeIndex;
+  node->firstChild = firstChild;
+  node->firstBlock = kNone;
+  node->count = 0;
+  for (uint32_t i = 0; i < leaf.count; i++) {
+    uint32_t child = firstChild + (uint32_t)QuadrantForPoint(bounds, x[i], y[i]);
+    [self appendToLeaf:child x:x[i] y:y[i] index:indices[i]];
+  }
+}
+
+- (void)appendToLeaf:(uint32_t)nodeIndex x:(double)x y:(double)y index:(uint32_t)index {
+  Node *node = (Node *)_nodes.mutableBytes + nodeIndex;
+  if (node->firstBlock == kNone) {
+    node->firstBlock = [self allocateBlock];
+  }
+  uint32_t block = node->firstBlock;
+  for (uint32_t i = 0; i < node->count / kBlockCapacity; i++) {
+    uint32_t next = ((const uint32_t *)_nextBlocks.bytes)[block];
+    if (next == kNone) {
+      next = [self allocateBlock];
+      ((uint32_t *)_nextBlocks.mutableBytes)[block] = next;
+    }
+    block = next;
+  }
+  uint32_t slot = block * kBlockCapacity + node->count % kBlockCapacity;
+  ((double *)_slotX.mutableBytes)[slot] = x;
+  ((double *)_slotY.mutableBytes)[slot] = y;
+  ((uint32_t *)_slotIndices.mutableBytes)[slot] = index;
+  node->count++;
+}
+
+/**
+ * Fills the empty tree with |points| in one pass. Points are sorted by Morton key, so every node's
+ * points form one run of the sorted order; a run is split at its quadrant boundaries for as long as
+ * adding the points one at a time would have split it.
+ */
+- (void)loadPoints:(const GQTPoint *)points count:(NSUInteger)count {
+  _pointCount = count;
+  if (count == 0) {
+    return;
+  }
+  // A few chunks per core keeps every core busy when some finish early.
+  NSUInteger chunkCount = MIN(NSProcessInfo.processInfo.activeProcessorCount * 4,
+                              (count + kMinimumChunkSize - 1) / kMinimumChunkSize);
+  NSUInteger chunkSize = (count + chunkCount - 1) / chunkCount;
+  NSMutableData *keyData = [NSMutableData dataWithLength:2 * count * sizeof(uint64_t)];
+  NSMutableData *indexData = [NSMutableData dataWithLength:2 * count * sizeof(uint32_t)];
+  uint64_t *keys = keyData.mutableBytes;
+  uint32_t *indices = indexData.mutableBytes;
+  GQTBounds bounds = _bounds;
+  dispatch_apply(chunkCount, DISPATCH_APPLY_AUTO, ^(size_t chunk) {
+    NSUInteger end = MIN(count, (chunk + 1) * chunkSize);
+    for (NSUInteger i = chunk * chunkSize; i < end; i++) {
+      GQTPoint point = points[i];
+      keys[i] = BoundsContainPoint(bounds, point.x, point.y) ? MortonKey(bounds, point.x, point.y)
+                                                            : kOutsideKey;
+      indices[i] = (uint32_t)i;
+    }
+  });
+  RadixSort(keys, indices, keys + count, indices + count, count, chunkCount);
+
+  // Points outside the bounds sorted to the end.
+  uint32_t inside = (uint32_t)count;
+  while (inside > 0 && keys[inside - 1] == kOutsideKey) {
+    inside--;
+  }
+
+  // Lay out the nodes depth first, quadrant 0 first, so leaves and their blocks follow the sorted
+  // order.
+  NSMutableData *leaves = [NSMutableData data];
+  uint32_t blockCount = 0;
+  BuildEntry stack[3 * kMaxDepth + 4];
+  NSUInteger depth = 0;
+  stack[depth++] = (BuildEntry){0, 0, inside, 0};
+  while (depth > 0) {
+    BuildEntry entry = stack[--depth];
+    uint32_t pointCount = entry.end - entry.begin;
+    if (pointCount <= kBlockCapacity || entry.depth == kMaxDepth) {
+      if (pointCount > 0) {
+        Node *node = (Node *)_nodes.mutableBytes + entry.node;
+        node->firstBlock = blockCount;
+        node->count = pointCount;
+        BuildLeaf leaf = {blockCount, entry.begin, entry.end};
+        [leaves appendBytes:&leaf length:sizeof(leaf)];
+        blockCount += (pointCount + kBlockCapacity - 1) / kBlockCapacity;
+      }
+      continue;
+    }
+    uint32_t firstChild = (uint32_t)(_nodes.length / sizeof(Node));
+    Node children[4] = {{kNone, kNone, 0}, {kNone, kNone, 0}, {kNone, kNone, 0}, {kNone, kNone, 0}};
+    [_nodes appendBytes:children length:sizeof(children)];
+    ((Node *)_nodes.mutableBytes)[entry.node].firstChild = firstChild;
+    uint32_t end = entry.end;
+    for (NSUInteger quadrant = 4; quadrant-- > 0;) {
+      uint32_t begin = quadrant == 0
+                           ? entry.begin
+                           : QuadrantStart(keys, entry.begin, end, entry.depth, quadrant);
+      stack[depth++] = (BuildEntry){firstChild + (uint32_t)quadrant, begin, end, entry.depth + 1};
+      end = begin;
+    }
+  }
+
+  // A leaf's blocks are consecutive, so only the last block of each ends its chain.
+  [_slotX setLength:blockCount * kBlockCapacity * sizeof(double)];
+  [_slotY setLength:blockCount * kBlockCapacity * sizeof(double)];
+  [_slotIndices setLength:blockCount * kBlockCapacity * sizeof(uint32_t)];
+  [_nextBlocks setLength:blockCount * sizeof(uint32_t)];
+  double *slotX = _slotX.mutableBytes;
+  double *slotY = _slotY.mutableBytes;
+  uint32_t *slotIndices = _slotIndices.mutableBytes;
+  uint32_t *nextBlocks = _nextBlocks.mutableBytes;
+  const BuildLeaf *leafValues = leaves.bytes;
+  NSUInteger leafCount = leaves.length / sizeof(BuildLeaf);
+  NSUInteger leafChunkSize = (leafCount + chunkCount - 1) / chunkCount;
+  dispatch_apply(chunkCount, DISPATCH_APPLY_AUTO, ^(size_t chunk) {
+    NSUInteger end = MIN(leafCount, (chunk + 1) * leafChunkSize);
+    for (NSUInteger i = chunk * leafChunkSize; i < end; i++) {
+      BuildLeaf leaf = leafValues[i];
+      uint32_t lastBlock = leaf.firstBlock + (leaf.end - leaf.begin - 1) / kBlockCapacity;
+      for (uint32_t block = leaf.firstBlock; block < lastBlock; block++) {
+        nextBlocks[block] = block + 1;
+      }
+      nextBlocks[lastBlock] = kNone;
+      uint32_t slot = leaf.firstBlock * kBlockCapacity;
+      for (uint32_t j = leaf.begin; j < leaf.end; j++, slot++) {
+        GQTPoint point = points[indices[j]];
+        slotX[slot] = point.x;
+        slotY[slot] = point.y;
+        slotIndices[slot] = indices[j];
+      }
+    }
+  });
+  _count = inside;
+}
+
+- (uint32_t)allocateBlock {
+  uint32_t block;
+  if (_freeBlocks.length > 0) {
+    NSUInteger last = _freeBlocks.length - sizeof(block);
+    memcpy(&block, (const uint8_t *)_freeBlocks.bytes + last, sizeof(block));
+    _freeBlocks.length = last;
+  } else {
+    block = (uint32_t)(_nextBlocks.length / sizeof(uint32_t));
+    [_slotX increaseLengthBy:kBlockCapacity * sizeof(double)];
+    [_slotY increaseLengthBy:kBlockCapacity * sizeof(double)];
+    [_slotIndices increaseLengthBy:kBlockCapacity * sizeof(uint32_t)];
+    [_nextBlocks increaseLengthBy:sizeof(uint32_t)];
+  }
+  ((uint32_t *)_nextBlocks.mutableBytes)[block] = kNone;
+  return block;
+}
+
+@end
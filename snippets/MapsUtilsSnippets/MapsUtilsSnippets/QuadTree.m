@@ -15,6 +15,10 @@
 #import "QuadTree.h"
 // [START maps_ios_quadtree]
 @import GoogleMapsUtils;
+// [START_EXCLUDE]
+@import GoogleMaps;
+#import "PointQuadTree.h"
+// [END_EXCLUDE]
 
 @interface QuadTreeItem : NSObject<GQTPointQuadTreeItem>
 - (instancetype)initWithPoint:(GQTPoint)point;
@@ -56,5 +60,109 @@
   }
 }
 
+// [START_EXCLUDE]
+// [START maps_ios_quadtree_bare_points]
+/// Function demonstrating how to index many points without wrapping each one in an object
+- (void)testBarePoints {
+  // PointQuadTree keeps coordinates in flat buffers, so bare points need no item objects.
+  GQTBounds bounds = {-2, -2, 2, 2};
+  PointQuadTree *tree = [[PointQuadTree alloc] initWithBounds:bounds];
+
+  // Add 4 points to the tree. Each is identified by the index it was added under.
+  GQTPoint points[] = {{-1, -1}, {-1, 1}, {1, 1}, {1, -1}};
+  for (NSUInteger i = 0; i < 4; i++) {
+    [tree addPoint:points[i]];
+  }
+
+  // Search the same rectangle as above, collecting indices into a buffer rather than an array.
+  uint32_t indices[4];
+  NSUInteger count = [tree searchWithBounds:(GQTBounds){-1.5, -1.5, 1.5, 1.5}
+                                    indices:indices
+                                   capacity:4];
+
+  for (NSUInteger i = 0; i < MIN(count, 4); i++) {
+    GQTPoint point = points[indices[i]];
+    NSLog(@"(%lf, %lf)", point.x, point.y);
+  }
+}
+// [END maps_ios_quadtree_bare_points]
+
+// [START maps_ios_quadtree_bulk_load]
+/// Function demonstrating how to build a quadtree over many points at once
+- (void)testBulkLoad {
+  // Generate 100,000 points along a diagonal, which are sorted the worst way for one-by-one adds.
+  NSUInteger pointCount = 100000;
+  NSMutableData *pointData = [NSMutableData dataWithLength:pointCount * sizeof(GQTPoint)];
+  GQTPoint *points = pointData.mutableBytes;
+  for (NSUInteger i = 0; i < pointCount; i++) {
+    double t = -2 + 4.0 * i / pointCount;
+    points[i] = (GQTPoint){t, t};
+  }
+
+  // Build the tree in one pass. Point i is reported under index i.
+  GQTBounds bounds = {-2, -2, 2, 2};
+  PointQuadTree *tree = [[PointQuadTree alloc] initWithBounds:bounds
+                                                       points:points
+                                                        count:pointCount];
+
+  uint32_t indices[16];
+  NSUInteger count = [tree searchWithBounds:(GQTBounds){0, 0, 0.0005, 0.0005}
+                                    indices:indices
+                                   capacity:16];
+
+  for (NSUInteger i = 0; i < MIN(count, 16); i++) {
+    GQTPoint point = points[indices[i]];
+    NSLog(@"(%lf, %lf)", point.x, point.y);
+  }
+}
+// [END maps_ios_quadtree_bulk_load]
+
+// [START maps_ios_quadtree_nearest]
+/// Function demonstrating how to find the points nearest a location
+- (void)testNearest {
+  // Project 10,000 random locations around London to map points, as GMSProject does.
+  NSUInteger pointCount = 10000;
+  NSMutableData *pointData = [NSMutableData dataWithLength:pointCount * sizeof(GQTPoint)];
+  GQTPoint *points = pointData.mutableBytes;
+  for (NSUInteger i = 0; i < pointCount; i++) {
+    CLLocationCoordinate2D coordinate =
+        CLLocationCoordinate2DMake(51.3 + 0.4 * arc4random_uniform(10000) / 10000,
+                                   -0.5 + 0.7 * arc4random_uniform(10000) / 10000);
+    GMSMapPoint mapPoint = GMSProject(coordinate);
+    points[i] = (GQTPoint){mapPoint.x, mapPoint.y};
+  }
+  PointQuadTree *tree = [[PointQuadTree alloc] initWithBounds:(GQTBounds){-1, -1, 1, 1}
+                                                       points:points
+                                                        count:pointCount];
+
+  // The five points nearest the centre of London, nearest first.
+  CLLocationCoordinate2D center = CLLocationCoordinate2DMake(51.5074, -0.1278);
+  GMSMapPoint centerPoint = GMSProject(center);
+  uint32_t indices[5];
+  double distances[5];
+  NSUInteger count = [tree nearestPoints:5
+                                 toPoint:(GQTPoint){centerPoint.x, centerPoint.y}
+                                 indices:indices
+                               distances:distances];
+  for (NSUInteger i = 0; i < count; i++) {
+    NSLog(@"Point %u is %lf map units away", indices[i], distances[i]);
+  }
+
+  // Up to 16 of the points within a kilometre, nearest first.
+  uint32_t nearbyIndices[16];
+  double nearbyDistances[16];
+  NSUInteger nearbyCount = [tree searchWithinMeters:1000
+                                       ofCoordinate:center
+                                            indices:nearbyIndices
+                                          distances:nearbyDistances
+                                           capacity:16];
+  NSLog(@"%lu points are within a kilometre", (unsigned long)nearbyCount);
+  for (NSUInteger i = 0; i < MIN(nearbyCount, 16); i++) {
+    NSLog(@"Point %u is %.0lf m away", nearbyIndices[i], nearbyDistances[i]);
+  }
+}
+// [END maps_ios_quadtree_nearest]
+// [END_EXCLUDE]
+
 @end
 // [END maps_ios_quadtree]
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import <CoreLocation/CoreLocation.h>
+#import <Foundation/Foundation.h>
+
+#import "GeoJSONStreamReader.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSInteger, VectorTileGeometryType) {
+  /** Points, all in one path. */
+  VectorTileGeometryTypePoints,
+  /** Lines, one per path. */
+  VectorTileGeometryTypeLine,
+  /** One polygon: its outer ring, then its holes. */
+  VectorTileGeometryTypePolygon,
+  /** A polygon's rings as lines, without the edges the polygon was clipped along. */
+  VectorTileGeometryTypeOutline,
+};
+
+/**
+ * A feature's geometry within one tile, clipped to the tile and simplified for its zoom. The
+ * arrays are only valid during the enumeration block.
+ */
+typedef struct {
+  VectorTileGeometryType type;
+  /** The index the feature was added under, for looking up its properties or style. */
+  NSUInteger featureIndex;
+  const CLLocationCoordinate2D *coordinates;
+  /** Index one past each path's last coordinate. */
+  const NSUInteger *pathEnds;
+  NSUInteger pathCount;
+} VectorTileFeature;
+
+/**
+ * Cuts features into z/x/y tiles, so that only the features on screen need to be drawn, in only
+ * as much detail as the zoom shows.
+ *
+ * Features are projected to Web Mercator as they are added, and each line and ring is ranked by
+ * how far its vertices stand out from it. A tile is cut from its nearest cut ancestor the first
+ * time it is asked for, clipping each feature against the tile's edges, and is kept for its own
+ * children. Vertices that are not visible at the tile's zoom, and lines and rings smaller than
+ * a point, are dropped as the tile is read. Tiles at |maxZoom| keep every vertex, since they are
+ * also what deeper zooms are drawn from.
+ *
+ * Lines that cross the antimeridian are split there, so they are not drawn the long way round the
+ * world. Polygons are not split, so a polygon must not cross the antimeridian.
+ *
+ * An index is not thread-safe.
+ */
+@interface VectorTileIndex : NSObject
+
+/** The deepest zoom that tiles are cut at. */
+@property(nonatomic, readonly) NSUInteger maxZoom;
+
+/** Number of features added. */
+@property(nonatomic, readonly) NSUInteger featureCount;
+
+/** An index that cuts tiles down to zoom 14. */
+- (instancetype)init;
+
+/** An index that cuts tiles down to |maxZoom|, which is at most 24. */
+- (instancetype)initWithMaxZoom:(NSUInteger)maxZoom NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Adds the geometry of a feature read by GeoJSONStreamReader, under the next feature index.
+ * Adding a feature drops every tile cut so far.
+ */
+- (void)addFeature:(const GeoJSONFeature *)feature;
+
+/**
+ * Calls |block| with each feature in tile (|x|, |y|) at |zoom|, cutting the tile first if need
+ * be. |zoom| must not exceed |maxZoom|.
+ */
+- (void)enumerateFeaturesInTileAtZoom:(NSUInteger)zoom
+                                    x:(NSUInteger)x
+                                    y:(NSUInteger)y
+                           usingBlock:(NS_NOESCAPE void (^)(const VectorTileFeature *feature,
+                                                            BOOL *stop))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
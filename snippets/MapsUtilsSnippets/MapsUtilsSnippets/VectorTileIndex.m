@@ -0,0 +1,638 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "VectorTileIndex.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#import "MapGeometry.h"
+
+static const NSUInteger kDefaultMaxZoom = 14;
+
+// Zoom, x and y share one 64-bit tile key, so x and y must fit in 28 bits.
+static const NSUInteger kMaxZoomLimit = 24;
+
+// Width of a tile in points. Detail smaller than a point at a tile's zoom is dropped, except at
+// the deepest zoom, whose tiles are also drawn at every deeper camera zoom.
+static const double kTileSize = 256;
+
+// Web Mercator y stops short of 1, so that points on the bottom and right edges of the world
+// still fall in a tile.
+static const double kMaximumWorldCoordinate = 1 - 1e-12;
+
+/** A vertex in world coordinates, from 0 to 1 east and south, with its rank. */
+typedef struct {
+  double x;
+  double y;
+  // The squared distance the vertex stands out from the line it simplifies to, or 1 for
+  // vertices that are always kept: ends of lines and points added by clipping.
+  double importance;
+} TileVertex;
+
+typedef struct {
+  VectorTileGeometryType type;
+  NSUInteger featureIndex;
+  // Index one past the feature's last path.
+  NSUInteger pathEnd;
+  double minX;
+  double minY;
+  double maxX;
+  double maxY;
+} TileFeature;
+
+/** The features of one tile, clipped to it but not simplified. */
+typedef struct {
+  TileVertex *vertices;
+  NSUInteger vertexCount;
+  NSUInteger vertexCapacity;
+  NSUInteger *pathEnds;
+  NSUInteger pathCount;
+  NSUInteger pathCapacity;
+  TileFeature *features;
+  NSUInteger featureCount;
+  NSUInteger featureCapacity;
+} TileData;
+
+/** A feature being handed out, simplified and in coordinates, reused for every feature. */
+typedef struct {
+  CLLocationCoordinate2D *coordinates;
+  NSUInteger coordinateCount;
+  NSUInteger coordinateCapacity;
+  NSUInteger *pathEnds;
+  NSUInteger pathCount;
+  NSUInteger pathCapacity;
+} FeatureOutput;
+
+static void FreeTileData(TileData *data) {
+  free(data->vertices);
+  free(data->pathEnds);
+  free(data->features);
+  *data = (TileData){0};
+}
+
+static inline void AppendVertex(TileData *data, TileVertex vertex) {
+  Reserve((void **)&data->vertices, &data->vertexCapacity, data->vertexCount + 1,
+          sizeof(TileVertex));
+  data->vertices[data->vertexCount++] = vertex;
+}
+
+static inline NSUInteger PathStart(const NSUInteger *pathEnds, NSUInteger path) {
+  return path > 0 ? pathEnds[path - 1] : 0;
+}
+
+/**
+ * Ends the path begun at vertex |start|, or drops its vertices if it has fewer than
+ * |minimumCount|.
+ */
+static void EndPath(TileData *data, NSUInteger start, NSUInteger minimumCount) {
+  if (data->vertexCount - start < minimumCount) {
+    data->vertexCount = start;
+    return;
+  }
+  Reserve((void **)&data->pathEnds, &data->pathCapacity, data->pathCount + 1, sizeof(NSUInteger));
+  data->pathEnds[data->pathCount++] = data->vertexCount;
+}
+
+/** Ends the feature whose paths begin at |firstPath|, unless it has none. */
+static void EndFeature(TileData *data, VectorTileGeometryType type, NSUInteger featureIndex,
+                       NSUInteger firstPath) {
+  if (data->pathCount == firstPath) {
+    return;
+  }
+  TileFeature feature = {type, featureIndex, data->pathCount, INFINITY, INFINITY, -INFINITY,
+                         -INFINITY};
+  for (NSUInteger i = PathStart(data->pathEnds, firstPath); i < data->vertexCount; i++) {
+    feature.minX = fmin(feature.minX, data->vertices[i].x);
+    feature.minY = fmin(feature.minY, data->vertices[i].y);
+    feature.maxX = fmax(feature.maxX, data->vertices[i].x);
+    feature.maxY = fmax(feature.maxY, data->vertices[i].y);
+  }
+  Reserve((void **)&data->features, &data->featureCapacity, data->featureCount + 1,
+          sizeof(TileFeature));
+  data->features[data->featureCount++] = feature;
+}
+
+#pragma mark - Projection
+
+static TileVertex ProjectVertex(CLLocationCoordinate2D coordinate) {
+  double x, y;
+  ProjectCoordinate(coordinate, &x, &y);
+  return (TileVertex){fmin(fmax(x, 0), kMaximumWorldCoordinate),
+                      fmin(fmax(y, 0), kMaximumWorldCoordinate), 0};
+}
+
+static CLLocationCoordinate2D UnprojectVertex(TileVertex vertex) {
+  return UnprojectPoint(vertex.x, vertex.y);
+}
+
+#pragma mark - Simplification
+
+static double SquaredSegmentDistance(TileVertex point, TileVertex a, TileVertex b) {
+  double x = a.x;
+  double y = a.y;
+  double dx = b.x - x;
+  double dy = b.y - y;
+  if (dx != 0 || dy != 0) {
+    double t = ((point.x - x) * dx + (point.y - y) * dy) / (dx * dx + dy * dy);
+    if (t > 1) {
+      x = b.x;
+      y = b.y;
+    } else if (t > 0) {
+      x += dx * t;
+      y += dy * t;
+    }
+  }
+  dx = point.x - x;
+  dy = point.y - y;
+  return dx * dx + dy * dy;
+}
+
+/**
+ * Ranks the vertices of a path by Douglas-Peucker: each vertex the algorithm would keep at some
+ * tolerance above |sqTolerance| gets the squared distance at which it is dropped. |stack| needs
+ * room for 2 * |count| indices.
+ */
+static void RankPath(TileVertex *vertices, NSUInteger count, double sqTolerance,
+                     NSUInteger *stack) {
+  for (NSUInteger i = 0; i < count; i++) {
+    vertices[i].importance = 0;
+  }
+  vertices[0].importance = 1;
+  vertices[count - 1].importance = 1;
+  NSUInteger depth = 0;
+  stack[depth++] = 0;
+  stack[depth++] = count - 1;
+  while (depth > 0) {
+    NSUInteger last = stack[--depth];
+    NSUInteger first = stack[--depth];
+    double maxSqDistance = sqTolerance;
+    NSUInteger index = 0;
+    for (NSUInteger i = first + 1; i < last; i++) {
+      double sqDistance = SquaredSegmentDistance(vertices[i], vertices[first], vertices[last]);
+      if (sqDistance > maxSqDistance) {
+        index = i;
+        maxSqDistance = sqDistance;
+      }
+    }
+    if (index != 0) {
+      vertices[index].importance = maxSqDistance;
+      if (index - first > 1) {
+        stack[depth++] = first;
+        stack[depth++] = index;
+      }
+      if (last - index > 1) {
+        stack[depth++] = index;
+        stack[depth++] = last;
+      }
+    }
+  }
+}
+
+#pragma mark - Clipping
+
+static inline double Axis(TileVertex vertex, NSUInteger axis) {
+  return axis == 0 ? vertex.x : vertex.y;
+}
+
+/** Appends the point where segment |a| |b| crosses |k| on |axis|. */
+static void AppendIntersection(TileData *data, TileVertex a, TileVertex b, double k,
+                               NSUInteger axis) {
+  double t = (k - Axis(a, axis)) / (Axis(b, axis) - Axis(a, axis));
+  TileVertex vertex = {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, 1};
+  if (axis == 0) {
+    vertex.x = k;
+  } else {
+    vertex.y = k;
+  }
+  AppendVertex(data, vertex);
+}
+
+/**
+ * Clips a path to the band from |k1| to |k2| on |axis|. A line may leave as several lines; a ring
+ * leaves as one ring, closed along the band's edges.
+ */
+static void ClipPath(TileData *data, const TileVertex *vertices, NSUInteger count, double k1,
+                     double k2, NSUInteger axis, BOOL isRing) {
+  NSUInteger minimumCount = isRing ? 4 : 2;
+  NSUInteger start = data->vertexCount;
+  for (NSUInteger i = 0; i + 1 < count; i++) {
+    TileVertex a = vertices[i];
+    TileVertex b = vertices[i + 1];
+    double ak = Axis(a, axis);
+    double bk = Axis(b, axis);
+    BOOL exited = NO;
+    if (ak < k1) {
+      // The segment enters from before the band.
+      if (bk > k1) {
+        AppendIntersection(data, a, b, k1, axis);
+      }
+    } else if (ak > k2) {
+      // The segment enters from after the band.
+      if (bk < k2) {
+        AppendIntersection(data, a, b, k2, axis);
+      }
+    } else {
+      AppendVertex(data, a);
+    }
+    if (bk < k1 && ak >= k1) {
+      AppendIntersection(data, a, b, k1, axis);
+      exited = YES;
+    }
+    if (bk > k2 && ak <= k2) {
+      AppendIntersection(data, a, b, k2, axis);
+      exited = YES;
+    }
+    if (!isRing && exited) {
+      EndPath(data, start, minimumCount);
+      start = data->vertexCount;
+    }
+  }
+  if (count > 0) {
+    TileVertex last = vertices[count - 1];
+    if (Axis(last, axis) >= k1 && Axis(last, axis) <= k2) {
+      AppendVertex(data, last);
+    }
+  }
+  if (isRing && data->vertexCount > start) {
+    TileVertex first = data->vertices[start];
+    TileVertex end = data->vertices[data->vertexCount - 1];
+    if (first.x != end.x || first.y != end.y) {
+      AppendVertex(data, first);
+    }
+  }
+  EndPath(data, start, minimumCount);
+}
+
+/**
+ * Appends the parts of |source|'s features that lie in the band from |k1| to |k2| on |axis| to
+ * |destination|. Points on the band's far edge belong to the next band, so each point lands in
+ * exactly one tile.
+ */
+static void ClipTile(const TileData *source, TileData *destination, double k1, double k2,
+                     NSUInteger axis) {
+  for (NSUInteger f = 0; f < source->featureCount; f++) {
+    const TileFeature *feature = &source->features[f];
+    NSUInteger firstPath = f > 0 ? source->features[f - 1].pathEnd : 0;
+    double min = axis == 0 ? feature->minX : feature->minY;
+    double max = axis == 0 ? feature->maxX : feature->maxY;
+    BOOL isPoints = feature->type == VectorTileGeometryTypePoints;
+    if (max < k1 || min > k2 || (isPoints && min >= k2)) {
+      continue;
+    }
+    NSUInteger destinationFirstPath = destination->pathCount;
+    NSUInteger destinationFirstVertex = destination->vertexCount;
+    BOOL contained = min >= k1 && (isPoints ? max < k2 : max <= k2);
+    for (NSUInteger path = firstPath; path < feature->pathEnd; path++) {
+      NSUInteger start = PathStart(source->pathEnds, path);
+      NSUInteger count = source->pathEnds[path] - start;
+      const TileVertex *vertices = source->vertices + start;
+      NSUInteger pathStart = destination->vertexCount;
+      if (contained) {
+        for (NSUInteger i = 0; i < count; i++) {
+          AppendVertex(destination, vertices[i]);
+        }
+        EndPath(destination, pathStart, 1);
+      } else if (isPoints) {
+        for (NSUInteger i = 0; i < count; i++) {
+          double k = Axis(vertices[i], axis);
+          if (k >= k1 && k < k2) {
+            AppendVertex(destination, vertices[i]);
+          }
+        }
+        EndPath(destination, pathStart, 1);
+      } else {
+        BOOL isPolygon = feature->type == VectorTileGeometryTypePolygon;
+        ClipPath(destination, vertices, count, k1, k2, axis, isPolygon);
+        // Holes cannot outlast their polygon's outer ring.
+        if (isPolygon && destination->pathCount == destinationFirstPath) {
+          break;
+        }
+      }
+    }
+    if (destination->pathCount == destinationFirstPath) {
+      destination->vertexCount = destinationFirstVertex;
+      continue;
+    }
+    EndFeature(destination, feature->type, feature->featureIndex, destinationFirstPath);
+  }
+}
+
+#pragma mark - Output
+
+static void AppendCoordinate(FeatureOutput *output, CLLocationCoordinate2D coordinate) {
+  Reserve((void **)&output->coordinates, &output->coordinateCapacity, output->coordinateCount + 1,
+          sizeof(CLLocationCoordinate2D));
+  output->coordinates[output->coordinateCount++] = coordinate;
+}
+
+/**
+ * Writes feature |index| of |tile| to |output| without the detail smaller than |tolerance|:
+ * vertices that stand out less than it from their simplified line, and lines and rings that fit
+ * within it.
+ *
+ * @return NO if nothing of the feature is left.
+ */
+static BOOL SimplifyFeature(const TileData *tile, NSUInteger index, double tolerance,
+                            FeatureOutput *output) {
+  const TileFeature *feature = &tile->features[index];
+  NSUInteger firstPath = index > 0 ? tile->features[index - 1].pathEnd : 0;
+  double sqTolerance = tolerance * tolerance;
+  BOOL isPoints = feature->type == VectorTileGeometryTypePoints;
+  BOOL isPolygon = feature->type == VectorTileGeometryTypePolygon;
+  NSUInteger minimumCount = isPoints ? 1 : (isPolygon ? 4 : 2);
+  output->coordinateCount = 0;
+  output->pathCount = 0;
+  for (NSUInteger path = firstPath; path < feature->pathEnd; path++) {
+    NSUInteger start = PathStart(tile->pathEnds, path);
+    NSUInteger end = tile->pathEnds[path];
+    NSUInteger outputStart = output->coordinateCount;
+    if (!isPoints) {
+      double minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+      for (NSUInteger i = start; i < end; i++) {
+        minX = fmin(minX, tile->vertices[i].x);
+        minY = fmin(minY, tile->vertices[i].y);
+        maxX = fmax(maxX, tile->vertices[i].x);
+        maxY = fmax(maxY, tile->vertices[i].y);
+      }
+      if (maxX - minX < tolerance && maxY - minY < tolerance) {
+        end = start;
+      }
+    }
+    for (NSUInteger i = start; i < end; i++) {
+      if (isPoints || tile->vertices[i].importance > sqTolerance) {
+        AppendCoordinate(output, UnprojectVertex(tile->vertices[i]));
+      }
+    }
+    if (output->coordinateCount - outputStart < minimumCount) {
+      output->coordinateCount = outputStart;
+      // Without its outer ring, a polygon is gone.
+      if (isPolygon && path == firstPath) {
+        return NO;
+      }
+      continue;
+    }
+    Reserve((void **)&output->pathEnds, &output->pathCapacity, output->pathCount + 1,
+            sizeof(NSUInteger));
+    output->pathEnds[output->pathCount++] = output->coordinateCount;
+  }
+  return output->pathCount > 0;
+}
+
+#pragma mark - Tiles
+
+/** A cut tile, which owns its data. */
+@interface VectorTile : NSObject {
+ @public
+  TileData _data;
+}
+@end
+
+@implementation VectorTile
+
+- (void)dealloc {
+  FreeTileData(&_data);
+}
+
+@end
+
+static NSNumber *TileKey(NSUInteger zoom, NSUInteger x, NSUInteger y) {
+  return @(((uint64_t)zoom << 56) | ((uint64_t)x << 28) | (uint64_t)y);
+}
+
+@implementation VectorTileIndex {
+  // The world tile, at zoom 0, which features are added to.
+  VectorTile *_root;
+
+  // Every tile cut so far, and the root, by TileKey.
+  NSMutableDictionary<NSNumber *, VectorTile *> *_tiles;
+
+  // Scratch space for ranking vertices as they are added.
+  NSMutableData *_rankStack;
+
+  FeatureOutput _output;
+}
+
+- (instancetype)init {
+  return [self initWithMaxZoom:kDefaultMaxZoom];
+}
+
+- (instancetype)initWithMaxZoom:(NSUInteger)maxZoom {
+  NSParameterAssert(maxZoom <= kMaxZoomLimit);
+  self = [super init];
+  if (self) {
+    _maxZoom = MIN(maxZoom, kMaxZoomLimit);
+    _root = [[VectorTile alloc] init];
+    _tiles = [NSMutableDictionary dictionaryWithObject:_root forKey:TileKey(0, 0, 0)];
+    _rankStack = [NSMutableData data];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  free(_output.coordinates);
+  free(_output.pathEnds);
+}
+
+- (void)addFeature:(const GeoJSONFeature *)feature {
+  NSUInteger featureIndex = _featureCount++;
+  TileData *data = &_root->_data;
+
+  NSUInteger group = 0;
+  NSUInteger path = 0;
+  for (NSUInteger g = 0; g < feature->geometryCount; g++) {
+    GeoJSONGeometry geometry = feature->geometries[g];
+    BOOL isPoints = geometry.type == GeoJSONGeometryTypePoint ||
+                    geometry.type == GeoJSONGeometryTypeMultiPoint;
+    BOOL isLine = geometry.type == GeoJSONGeometryTypeLineString ||
+                  geometry.type == GeoJSONGeometryTypeMultiLineString;
+    NSUInteger firstPath = data->pathCount;
+    NSUInteger pointsStart = data->vertexCount;
+    for (; group < geometry.groupEnd; group++) {
+      if (!isPoints && !isLine) {
+        firstPath = data->pathCount;
+      }
+      for (; path < feature->groupEnds[group]; path++) {
+        NSUInteger start = data->vertexCount;
+        for (NSUInteger i = PathStart(feature->pathEnds, path); i < feature->pathEnds[path]; i++) {
+          TileVertex vertex = ProjectVertex(feature->coordinates[i]);
+          vertex.importance = 1;
+          if (isLine && data->vertexCount > start &&
+              fabs(vertex.x - data->vertices[data->vertexCount - 1].x) > 0.5) {
+            // The segment is shorter the other way round the world, across the antimeridian. End
+            // the line there and start a new one on the other side, so the segment is not drawn
+            // across the whole world.
+            TileVertex previous = data->vertices[data->vertexCount - 1];
+            BOOL eastward = previous.x > vertex.x;
+            double edge = eastward ? 1 : 0;
+            double t = (edge - previous.x) / (vertex.x + (eastward ? 1 : -1) - previous.x);
+            double y = previous.y + (vertex.y - previous.y) * t;
+            AppendVertex(data, (TileVertex){eastward ? kMaximumWorldCoordinate : 0, y, 1});
+            [self endPathAt:start minimumCount:2];
+            start = data->vertexCount;
+            AppendVertex(data, (TileVertex){eastward ? 0 : kMaximumWorldCoordinate, y, 1});
+          }
+          AppendVertex(data, vertex);
+        }
+        if (isPoints) {
+          continue;
+        }
+        if (!isLine && data->vertexCount > start) {
+          TileVertex first = data->vertices[start];
+          TileVertex last = data->vertices[data->vertexCount - 1];
+          if (first.x != last.x || first.y != last.y) {
+            AppendVertex(data, first);
+          }
+        }
+        [self endPathAt:start minimumCount:isLine ? 2 : 4];
+        // Holes cannot outlast their polygon's outer ring.
+        if (!isLine && data->pathCount == firstPath) {
+          path = feature->groupEnds[group];
+          break;
+        }
+      }
+      if (isPoints || isLine) {
+        continue;
+      }
+      // Each polygon is a feature of its own, followed by its rings as lines.
+      if (data->pathCount > firstPath) {
+        NSUInteger lastPath = data->pathCount;
+        EndFeature(data, VectorTileGeometryTypePolygon, featureIndex, firstPath);
+        NSUInteger outlineFirstPath = data->pathCount;
+        for (NSUInteger ring = firstPath; ring < lastPath; ring++) {
+          NSUInteger start = data->vertexCount;
+          for (NSUInteger i = PathStart(data->pathEnds, ring); i < data->pathEnds[ring]; i++) {
+            AppendVertex(data, data->vertices[i]);
+          }
+          EndPath(data, start, 2);
+        }
+        EndFeature(data, VectorTileGeometryTypeOutline, featureIndex, outlineFirstPath);
+      }
+    }
+    if (isPoints) {
+      EndPath(data, pointsStart, 1);
+      EndFeature(data, VectorTileGeometryTypePoints, featureIndex, firstPath);
+    } else if (isLine) {
+      EndFeature(data, VectorTileGeometryTypeLine, featureIndex, firstPath);
+    }
+  }
+
+  // Every cut tile is now out of date.
+  [_tiles removeAllObjects];
+  _tiles[TileKey(0, 0, 0)] = _root;
+}
+
+- (void)enumerateFeaturesInTileAtZoom:(NSUInteger)zoom
+                                    x:(NSUInteger)x
+                                    y:(NSUInteger)y
+                           usingBlock:(NS_NOESCAPE void (^)(const VectorTileFeature *feature,
+                                                            BOOL *stop))block {
+  NSParameterAssert(zoom <= _maxZoom);
+  NSUInteger tileCount = (NSUInteger)1 << zoom;
+  if (zoom > _maxZoom || x >= tileCount || y >= tileCount) {
+    return;
+  }
+  const TileData *data = &[self tileAtZoom:zoom x:x y:y]->_data;
+  // Tiles at the deepest zoom keep every vertex, since they are also drawn at deeper camera zooms.
+  double tolerance = zoom < _maxZoom ? 1 / (kTileSize * tileCount) : 0;
+  BOOL stop = NO;
+  for (NSUInteger i = 0; i < data->featureCount && !stop; i++) {
+    if (!SimplifyFeature(data, i, tolerance, &_output)) {
+      continue;
+    }
+    VectorTileFeature feature = {
+        .type = data->features[i].type,
+        .featureIndex = data->features[i].featureIndex,
+        .coordinates = _output.coordinates,
+        .pathEnds = _output.pathEnds,
+        .pathCount = _output.pathCount,
+    };
+    block(&feature, &stop);
+  }
+}
+
+#pragma mark - Private
+
+/**
+ * Ranks the vertices of the path on the root tile that begins at vertex |start| and ends the path,
+ * or drops it if it has fewer than |minimumCount| vertices. Vertices are ranked all the way down,
+ * so every zoom can keep as many of them as it shows.
+ */
+- (void)endPathAt:(NSUInteger)start minimumCount:(NSUInteger)minimumCount {
+  TileData *data = &_root->_data;
+  NSUInteger count = data->vertexCount - start;
+  if (count >= minimumCount) {
+    [_rankStack setLength:MAX(_rankStack.length, 2 * count * sizeof(NSUInteger))];
+    RankPath(data->vertices + start, count, 0, _rankStack.mutableBytes);
+  }
+  EndPath(data, start, minimumCount);
+}
+
+/** Returns the tile, cutting it and the tiles above it from their nearest cut ancestor. */
+- (VectorTile *)tileAtZoom:(NSUInteger)zoom x:(NSUInteger)x y:(NSUInteger)y {
+  VectorTile *tile = _tiles[TileKey(zoom, x, y)];
+  if (tile) {
+    return tile;
+  }
+  NSUInteger ancestorZoom = zoom;
+  VectorTile *ancestor = nil;
+  while (!ancestor) {
+    ancestorZoom--;
+    NSUInteger shift = zoom - ancestorZoom;
+    ancestor = _tiles[TileKey(ancestorZoom, x >> shift, y >> shift)];
+  }
+  for (; ancestorZoom < zoom; ancestorZoom++) {
+    NSUInteger shift = zoom - ancestorZoom;
+    ancestor = [self splitTile:ancestor
+                          zoom:ancestorZoom
+                             x:x >> shift
+                             y:y >> shift
+                   towardChild:(x >> (shift - 1)) & 1
+                              :(y >> (shift - 1)) & 1];
+  }
+  return ancestor;
+}
+
+/**
+ * Cuts all four children of a tile, keeping them for later, and returns the child on the side
+ * given by |childX| and |childY|.
+ */
+- (VectorTile *)splitTile:(VectorTile *)tile
+                     zoom:(NSUInteger)zoom
+                        x:(NSUInteger)x
+                        y:(NSUInteger)y
+              towardChild:(NSUInteger)childX
+                         :(NSUInteger)childY {
+  double size = 1 / ldexp(1, (int)zoom);
+  double x0 = x * size;
+  double y0 = y * size;
+  TileData halves[2] = {{0}, {0}};
+  ClipTile(&tile->_data, &halves[0], x0, x0 + size / 2, 0);
+  ClipTile(&tile->_data, &halves[1], x0 + size / 2, x0 + size, 0);
+  VectorTile *target = nil;
+  for (NSUInteger i = 0; i < 2; i++) {
+    for (NSUInteger j = 0; j < 2; j++) {
+      VectorTile *child = [[VectorTile alloc] init];
+      ClipTile(&halves[i], &child->_data, y0 + j * size / 2, y0 + (j + 1) * size / 2, 1);
+      _tiles[TileKey(zoom + 1, 2 * x + i, 2 * y + j)] = child;
+      if (i == childX && j == childY) {
+        target = child;
+      }
+    }
+    FreeTileData(&halves[i]);
+  }
+  return target;
+}
+
+@end
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+@import GoogleMaps;
+
+#import "VectorTileIndex.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Draws the features of a VectorTileIndex that are in view, one tile at a time, so that the
+ * number of overlays on the map follows what is on screen rather than the size of the data.
+ *
+ * Tiles are drawn at the camera's zoom, down to the index's |maxZoom|. Tiles that scroll into
+ * view are drawn, and tiles that scroll out of view or belong to another zoom are removed, so
+ * overlays already on the map are left alone as the camera pans.
+ */
+@interface VectorTileRenderer : NSObject
+
+@property(nonatomic) UIColor *strokeColor;
+
+@property(nonatomic) UIColor *fillColor;
+
+@property(nonatomic) CGFloat strokeWidth;
+
+- (instancetype)initWithMapView:(GMSMapView *)mapView
+                      tileIndex:(VectorTileIndex *)tileIndex NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Draws the tiles now in view and removes the rest. Call from
+ * -mapView:idleAtCameraPosition:, and after adding features to the index.
+ */
+- (void)update;
+
+/** Removes every overlay the renderer has drawn. */
+- (void)clear;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,166 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "VectorTileRenderer.h"
+
+#include <math.h>
+
+#import "MapGeometry.h"
+
+// Past this many tiles in view, tiles are drawn from a shallower zoom instead.
+static const NSUInteger kMaxVisibleTiles = 64;
+
+static NSNumber *TileKey(NSUInteger zoom, NSUInteger x, NSUInteger y) {
+  return @(((uint64_t)zoom << 56) | ((uint64_t)x << 28) | (uint64_t)y);
+}
+
+static double TileX(CLLocationDegrees longitude, NSUInteger tileCount) {
+  double x, y;
+  ProjectCoordinate(CLLocationCoordinate2DMake(0, longitude), &x, &y);
+  return x * tileCount;
+}
+
+static double TileY(CLLocationDegrees latitude, NSUInteger tileCount) {
+  double x, y;
+  ProjectCoordinate(CLLocationCoordinate2DMake(latitude, 0), &x, &y);
+  return y * tileCount;
+}
+
+@implementation VectorTileRenderer {
+  GMSMapView *_mapView;
+  VectorTileIndex *_tileIndex;
+
+  // Overlays on the map for each drawn tile, by TileKey.
+  NSMutableDictionary<NSNumber *, NSArray<GMSOverlay *> *> *_overlays;
+}
+
+- (instancetype)initWithMapView:(GMSMapView *)mapView tileIndex:(VectorTileIndex *)tileIndex {
+  self = [super init];
+  if (self) {
+    _mapView = mapView;
+    _tileIndex = tileIndex;
+    _overlays = [NSMutableDictionary dictionary];
+    _strokeColor = [UIColor blackColor];
+    _fillColor = [UIColor colorWithWhite:0 alpha:0.2];
+    _strokeWidth = 1;
+  }
+  return self;
+}
+
+- (void)update {
+  GMSCoordinateBounds *bounds =
+      [[GMSCoordinateBounds alloc] initWithRegion:_mapView.projection.visibleRegion];
+  if (!bounds.isValid) {
+    return;
+  }
+  CLLocationCoordinate2D southWest = bounds.southWest;
+  CLLocationCoordinate2D northEast = bounds.northEast;
+  NSUInteger zoom = (NSUInteger)MIN(MAX(floorf(_mapView.camera.zoom), 0), _tileIndex.maxZoom);
+
+  NSInteger minX, maxX, minY, maxY;
+  NSUInteger tileCount;
+  while (YES) {
+    tileCount = (NSUInteger)1 << zoom;
+    minX = (NSInteger)floor(TileX(southWest.longitude, tileCount));
+    maxX = (NSInteger)floor(TileX(northEast.longitude, tileCount));
+    // Bounds across the antimeridian wrap around into the tiles of the western hemisphere.
+    if (southWest.longitude > northEast.longitude) {
+      maxX += tileCount;
+    }
+    minX = MAX(minX, 0);
+    maxX = MIN(maxX, minX + (NSInteger)tileCount - 1);
+    minY = MAX((NSInteger)floor(TileY(northEast.latitude, tileCount)), 0);
+    maxY = MIN((NSInteger)floor(TileY(southWest.latitude, tileCount)), (NSInteger)tileCount - 1);
+    if (zoom == 0 || (NSUInteger)((maxX - minX + 1) * (maxY - minY + 1)) <= kMaxVisibleTiles) {
+      break;
+    }
+    zoom--;
+  }
+
+  NSMutableDictionary<NSNumber *, NSArray<GMSOverlay *> *> *overlays =
+      [NSMutableDictionary dictionary];
+  for (NSInteger x = minX; x <= maxX; x++) {
+    for (NSInteger y = minY; y <= maxY; y++) {
+      NSUInteger tileX = (NSUInteger)x % tileCount;
+      NSNumber *key = TileKey(zoom, tileX, (NSUInteger)y);
+      NSArray<GMSOverlay *> *tileOverlays = _overlays[key];
+      if (tileOverlays) {
+        [_overlays removeObjectForKey:key];
+      } else {
+        tileOverlays = [self drawTileAtZoom:zoom x:tileX y:(NSUInteger)y];
+      }
+      overlays[key] = tileOverlays;
+    }
+  }
+  [self clear];
+  _overlays = overlays;
+}
+
+- (void)clear {
+  for (NSArray<GMSOverlay *> *tileOverlays in _overlays.objectEnumerator) {
+    for (GMSOverlay *overlay in tileOverlays) {
+      overlay.map = nil;
+    }
+  }
+  [_overlays removeAllObjects];
+}
+
+#pragma mark - Private
+
+- (NSArray<GMSOverlay *> *)drawTileAtZoom:(NSUInteger)zoom x:(NSUInteger)x y:(NSUInteger)y {
+  NSMutableArray<GMSOverlay *> *overlays = [NSMutableArray array];
+  GMSMapView *mapView = _mapView;
+  [_tileIndex enumerateFeaturesInTileAtZoom:zoom
+                                          x:x
+                                          y:y
+                                 usingBlock:^(const VectorTileFeature *feature, BOOL *stop) {
+    if (feature->type == VectorTileGeometryTypePoints) {
+      for (NSUInteger i = 0; i < feature->pathEnds[feature->pathCount - 1]; i++) {
+        GMSMarker *marker = [GMSMarker markerWithPosition:feature->coordinates[i]];
+        marker.map = mapView;
+        [overlays addObject:marker];
+      }
+      return;
+    }
+    NSMutableArray<GMSPath *> *paths = [NSMutableArray arrayWithCapacity:feature->pathCount];
+    for (NSUInteger path = 0; path < feature->pathCount; path++) {
+      NSUInteger start = path > 0 ? feature->pathEnds[path - 1] : 0;
+      GMSMutablePath *mutablePath = [GMSMutablePath path];
+      for (NSUInteger i = start; i < feature->pathEnds[path]; i++) {
+        [mutablePath addCoordinate:feature->coordinates[i]];
+      }
+      [paths addObject:mutablePath];
+    }
+    if (feature->type == VectorTileGeometryTypePolygon) {
+      // Outlines are drawn by the Outline feature that follows, without the tile's edges.
+      GMSPolygon *polygon = [GMSPolygon polygonWithPath:paths.firstObject];
+      polygon.holes = [paths subarrayWithRange:NSMakeRange(1, paths.count - 1)];
+      polygon.fillColor = self.fillColor;
+      polygon.strokeWidth = 0;
+      polygon.map = mapView;
+      [overlays addObject:polygon];
+      return;
+    }
+    for (GMSPath *path in paths) {
+      GMSPolyline *polyline = [GMSPolyline polylineWithPath:path];
+      polyline.strokeColor = self.strokeColor;
+      polyline.strokeWidth = self.strokeWidth;
+      polyline.map = mapView;
+      [overlays addObject:polyline];
+    }
+  }];
+  return overlays;
+}
+
+@end